@@ -0,0 +1,756 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <sstream>
+#include <getopt.h>
+#include <sys/resource.h>
+
+#include "UsbTransport.hh"
+#include "AsyncUsbReader.hh"
+#include "RawBufferPool.hh"
+#include "SpscRing.hh"
+#include "RawWriter.hh"
+#include "EventFramer.hh"
+#include "BlockCodec.hh"
+#include "CompressionPool.hh"
+#include "BufferArena.hh"
+#include "ELog.hh"
+
+// =========================================================================
+// NKFADC500 Mini - 보드 없이 구동하는 DAQ 핫패스 벤치마크
+// =========================================================================
+
+struct BenchConfig {
+    std::string mode = "usb";
+    int    chunkKB = 256;
+    int    blockKB = 4096;
+    int    nReads = 64;
+    double bandwidthMBps = 400.0;
+    int    turnaroundUs = 50;
+    int    queueItems = 1000000;
+    int    poolDepth = 64;
+    std::string outPath = "bench_writer.dat";
+    int    recordLen = 512;
+
+    // [pipeline] 스윕 축 (비어 있으면 기본 목록)
+    std::vector<int> blockList;
+    std::vector<int> poolList;
+    std::string queueList = "mutex,spsc,spin";
+    std::string writerList = "stdio,direct,uring";
+    int    pipelineMB = 256;
+    std::string replayPath;
+    std::string jsonPath;
+};
+
+static uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void PrintUsage() {
+    std::cout << "\n\033[1;36m======================================================================\033[0m\n";
+    std::cout << "\033[1;32m      NKFADC500 Mini - DAQ Hot-Path Benchmark (No Hardware)\033[0m\n";
+    std::cout << "\033[1;36m======================================================================\033[0m\n";
+    std::cout << "\033[1;33mUsage:\033[0m ./benchmark_nkfadc500 [options]\n\n";
+    std::cout << "\033[1;37m[Optional]\033[0m\n";
+    std::cout << "  -m <mode>     : Benchmark mode (usb | queue | disk | frame | compress | pipeline) (default: usb)\n";
+    std::cout << "  -c <kb>       : USB transfer chunk size in KB (default: 256)\n";
+    std::cout << "  -b <kb>       : Block size per ReadDATA in KB (default: 4096, [pipeline] list, default: 1024,4096)\n";
+    std::cout << "  -n <reads>    : Number of block reads per point (default: 64)\n";
+    std::cout << "  -w <MB/s>     : Simulated FX3 pipe bandwidth (default: 400)\n";
+    std::cout << "  -u <us>       : Simulated turnaround when the pipe runs idle (default: 50)\n";
+    std::cout << "  -q <items>    : [queue] Number of buffer handoffs per queue type (default: 1000000)\n";
+    std::cout << "  -p <depth>    : [queue|pipeline] Number of buffers circulating in the pool (default: 64, [pipeline] list, default: 8,32)\n";
+    std::cout << "  -o <file>     : [disk|pipeline] Scratch file on the target disk (default: bench_writer.dat, removed after)\n";
+    std::cout << "  -l <samples>  : [frame|compress|pipeline] Record length in samples per event (default: 512)\n";
+    std::cout << "  -Q <list>     : [pipeline] Queue types to sweep: mutex,spsc,spin (default: all)\n";
+    std::cout << "  -W <list>     : [pipeline] Writer backends to sweep: stdio,direct,uring (default: all)\n";
+    std::cout << "  -v <MB>       : [pipeline] Data pushed through the pipeline per point (default: 256)\n";
+    std::cout << "  -r <file>     : [pipeline] Replay an uncompressed per-board .dat instead of the synthetic stream\n";
+    std::cout << "  -j <file>     : [pipeline] Write all points as JSON\n";
+    std::cout << "  -h            : Print this help message\n";
+    std::cout << "\033[1;36m======================================================================\033[0m\n\n";
+}
+
+// 💡 [USB] 가상 FX3 파이프 위에서 동기(Direct) 전송과 in-flight depth 별 비동기 전송의 처리량/지연 비교
+int RunUsbBench(const BenchConfig& cfg) {
+    const size_t blockBytes = (size_t)cfg.blockKB * 1024;
+    std::vector<unsigned char> block(blockBytes);
+    const int depths[] = {1, 2, 4, 8, 16};
+
+    std::cout << "\033[1;36m[ USB Async Readout ]\033[0m  Chunk: " << cfg.chunkKB << " KB | Block: " << cfg.blockKB
+              << " KB | Pipe: " << cfg.bandwidthMBps << " MB/s | Turnaround: " << cfg.turnaroundUs << " us\n";
+    std::cout << "   Depth |   MB/s   | p50 (us) | p99 (us) | max (us) | Verify\n";
+    std::cout << "  -------+----------+----------+----------+----------+-------\n";
+
+    int failures = 0;
+
+    // 기준선: Direct(Zero-Copy) 동기 전송. 청크 사이마다 파이프가 비므로 turnaround 가 그대로 노출됨
+    {
+        SimUsbTransport transport(cfg.bandwidthMBps, cfg.turnaroundUs, true);
+        LatencyHistogram lat;
+        const size_t chunk = (size_t)cfg.chunkKB * 1024;
+        bool verified = true;
+        size_t total = 0;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < cfg.nReads && verified; i++) {
+            transport.SendReadCommand((uint32_t)(blockBytes / 4), 0x40000000);
+            for (size_t done = 0; done < blockBytes; ) {
+                int length = (int)std::min(chunk, blockBytes - done);
+                int actual = 0;
+                auto s0 = std::chrono::steady_clock::now();
+                if (transport.ReadBulk(block.data() + done, length, &actual) < 0 || actual != length) { verified = false; break; }
+                lat.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s0).count());
+                done += length;
+                total += length;
+            }
+            const uint32_t* w = reinterpret_cast<const uint32_t*>(block.data());
+            for (size_t k = 0; verified && k < blockBytes / 4; k += 1021) {
+                if (w[k] != (uint32_t)k) verified = false;
+            }
+        }
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if (!verified) failures++;
+
+        std::cout << "    sync | "
+                  << std::setw(8) << std::fixed << std::setprecision(1) << (total / 1048576.0) / sec << " | "
+                  << std::setw(8) << lat.PercentileNs(0.50) / 1000.0 << " | "
+                  << std::setw(8) << lat.PercentileNs(0.99) / 1000.0 << " | "
+                  << std::setw(8) << lat.MaxNs() / 1000.0 << " | "
+                  << (verified ? "\033[1;32mOK\033[0m" : "\033[1;31mFAIL\033[0m") << "\n";
+    }
+
+    for (int depth : depths) {
+        SimUsbTransport transport(cfg.bandwidthMBps, cfg.turnaroundUs, true);
+        AsyncUsbReader reader(&transport, depth, (size_t)cfg.chunkKB * 1024);
+
+        bool verified = true;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < cfg.nReads; i++) {
+            if (reader.Read(block.data(), blockBytes) < 0) { verified = false; break; }
+
+            // 시뮬레이터는 요청 명령 기준 word 인덱스로 채우므로 조립 순서를 그대로 검증 가능
+            const uint32_t* w = reinterpret_cast<const uint32_t*>(block.data());
+            for (size_t k = 0; k < blockBytes / 4; k += 1021) {
+                if (w[k] != (uint32_t)k) { verified = false; break; }
+            }
+        }
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        const LatencyHistogram& lat = reader.GetLatency();
+        double mbps = (reader.GetTotalBytes() / 1048576.0) / sec;
+        if (!verified) failures++;
+
+        std::cout << "   " << std::setw(5) << depth << " | "
+                  << std::setw(8) << std::fixed << std::setprecision(1) << mbps << " | "
+                  << std::setw(8) << lat.PercentileNs(0.50) / 1000.0 << " | "
+                  << std::setw(8) << lat.PercentileNs(0.99) / 1000.0 << " | "
+                  << std::setw(8) << lat.MaxNs() / 1000.0 << " | "
+                  << (verified ? "\033[1;32mOK\033[0m" : "\033[1;31mFAIL\033[0m") << "\n";
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+// 💡 [QUEUE] 실제 파이프라인과 같은 Free -> Data -> Free 순환 구조에서 큐 구현체별 핸드오프 비용 비교
+// Producer 는 ProducerWorker 처럼 매 루프마다 DataQ Size() 를 확인하여 락 경합까지 재현합니다.
+static void RunQueuePair(const char* label, BufferQueue* dataQ, BufferQueue* freeQ, const BenchConfig& cfg) {
+    for (int i = 0; i < cfg.poolDepth; i++) freeQ->Push(new RawBuffer(64));
+
+    LatencyHistogram dwell;
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::thread producer([&]() {
+        for (int i = 0; i < cfg.queueItems; ) {
+            if (dataQ->Size() > 50) { std::this_thread::yield(); continue; }
+            RawBuffer* buf = nullptr;
+            if (!freeQ->TryPop(buf)) { std::this_thread::yield(); continue; }
+            buf->stampNs = NowNs();
+            dataQ->Push(buf);
+            i++;
+        }
+        dataQ->Stop();
+    });
+
+    RawBuffer* buf = nullptr;
+    uint64_t received = 0;
+    while (dataQ->WaitAndPop(buf)) {
+        dwell.Record(NowNs() - buf->stampNs);
+        freeQ->Push(buf);
+        received++;
+    }
+    producer.join();
+
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "  " << std::left << std::setw(14) << label << std::right << " | "
+              << std::setw(8) << std::fixed << std::setprecision(2) << (received / sec) / 1e6 << " | "
+              << std::setw(8) << std::setprecision(2) << dwell.PercentileNs(0.50) / 1000.0 << " | "
+              << std::setw(8) << dwell.PercentileNs(0.99) / 1000.0 << " | "
+              << std::setw(8) << dwell.PercentileNs(0.999) / 1000.0 << " | "
+              << std::setw(9) << dwell.MaxNs() / 1000.0 << "\n";
+}
+
+int RunQueueBench(const BenchConfig& cfg) {
+    std::cout << "\033[1;36m[ Buffer Queue Handoff ]\033[0m  Items: " << cfg.queueItems << " | Pool: " << cfg.poolDepth << " buffers\n";
+    std::cout << "  Queue          |  Mops/s  | p50 (us) | p99 (us) | p999(us) |  max (us)\n";
+    std::cout << "  ---------------+----------+----------+----------+----------+----------\n";
+
+    {
+        RawBufferPool dataQ, freeQ;
+        RunQueuePair("mutex", &dataQ, &freeQ, cfg);
+    }
+    {
+        SpscBufferQueue dataQ(1024, true), freeQ(1024, true);
+        RunQueuePair("spsc+eventfd", &dataQ, &freeQ, cfg);
+    }
+    {
+        SpscBufferQueue dataQ(1024, false), freeQ(1024, false);
+        RunQueuePair("spsc+spin", &dataQ, &freeQ, cfg);
+    }
+    return 0;
+}
+
+// 💡 [DISK] Writer 백엔드별 지속 기록 처리량 및 블록 기록 지연 비교 (-n 블록 x -b KB)
+// Consumer 와 동일하게 고정 풀의 버퍼를 Writer 에 넘기고, release 콜백으로 돌아온 버퍼만 재사용합니다.
+int RunDiskBench(const BenchConfig& cfg) {
+    const size_t blockBytes = (size_t)cfg.blockKB * 1024;
+    const int backends[] = { DaqOptions::kWriterStdio, DaqOptions::kWriterDirect, DaqOptions::kWriterUring };
+
+    std::cout << "\033[1;36m[ Disk Writer Backends ]\033[0m  File: " << cfg.outPath << " | Block: " << cfg.blockKB
+              << " KB x " << cfg.nReads << "\n";
+    std::cout << "  Backend   |   MB/s   | p50 (us) | p99 (us) | max (us) | Unaligned\n";
+    std::cout << "  ----------+----------+----------+----------+----------+----------\n";
+
+    int failures = 0;
+    for (int backend : backends) {
+        DaqOptions opt;
+        opt.writerBackend = backend;
+        RawWriter* writer = RawWriter::Create(opt);
+        if (!writer->Open(cfg.outPath)) {
+            ELog::Print(ELog::ERROR, "Cannot open " + cfg.outPath);
+            delete writer;
+            return 1;
+        }
+
+        RawBufferPool pool;
+        for (int i = 0; i < 16; i++) {
+            RawBuffer* b = new RawBuffer(blockBytes);
+            for (size_t k = 0; k < blockBytes; k++) b->data[k] = (unsigned char)(k * 31 + i);
+            pool.Push(b);
+        }
+        RawWriter::ReleaseFn release = [&pool](RawBuffer* b) { pool.Push(b); };
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < cfg.nReads; i++) {
+            RawBuffer* b = nullptr;
+            while (!pool.TryPop(b)) writer->Poll();
+            b->size = blockBytes;
+            writer->Append(b, release);
+        }
+        writer->Close();
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        const LatencyHistogram& lat = writer->GetLatency();
+        if (writer->GetErrorCount() > 0) failures++;
+        std::cout << "  " << std::left << std::setw(9) << writer->GetName() << std::right << " | "
+                  << std::setw(8) << std::fixed << std::setprecision(1) << (writer->GetBytesWritten() / 1048576.0) / sec << " | "
+                  << std::setw(8) << lat.PercentileNs(0.50) / 1000.0 << " | "
+                  << std::setw(8) << lat.PercentileNs(0.99) / 1000.0 << " | "
+                  << std::setw(8) << lat.MaxNs() / 1000.0 << " | "
+                  << std::setw(9) << writer->GetUnalignedWrites() << "\n";
+        delete writer;
+    }
+    std::remove(cfg.outPath.c_str());
+    return failures == 0 ? 0 : 1;
+}
+
+// 💡 [FRAME] EventFramer 처리량: -l 샘플 이벤트가 연속된 스트림을 -b KB 블록으로 잘라 -n 블록 처리
+// 블록 경계가 이벤트 중간에 오도록 블록 크기와 이벤트 크기를 서로 맞추지 않으며, 센 이벤트 수를 정답과 비교합니다.
+int RunFrameBench(const BenchConfig& cfg) {
+    const size_t blockBytes = (size_t)cfg.blockKB * 1024;
+    const unsigned int dataLength = (unsigned int)cfg.recordLen * 2 + 32;
+    const size_t eventBytes = EventFramer::kHeaderBytes + (size_t)cfg.recordLen * 8;
+    const size_t streamBytes = blockBytes * cfg.nReads;
+
+    // 연속 스트림 생성 (헤더: production_main 과 동일한 data_length 바이트 배치, 파형: 임의 값)
+    std::vector<unsigned char> stream(streamBytes);
+    for (size_t k = 0; k < streamBytes; k++) stream[k] = (unsigned char)(k * 131 + 7);
+    uint64_t expected = 0;
+    for (size_t off = 0; off + EventFramer::kHeaderBytes <= streamBytes; off += eventBytes) {
+        unsigned char* h = stream.data() + off;
+        std::fill(h, h + EventFramer::kHeaderBytes, 0);
+        h[0] = dataLength & 0xFF; h[4] = (dataLength >> 8) & 0xFF;
+        h[8] = (dataLength >> 16) & 0xFF; h[12] = (dataLength >> 24) & 0xFF;
+        expected++;
+    }
+
+    std::cout << "\033[1;36m[ Event Framer ]\033[0m  Record: " << cfg.recordLen << " samples (" << eventBytes
+              << " B/event) | Block: " << cfg.blockKB << " KB x " << cfg.nReads << "\n";
+
+    EventFramer framer;
+    std::vector<uint32_t> offsets;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < cfg.nReads; i++) {
+        framer.Feed(stream.data() + (size_t)i * blockBytes, blockBytes, &offsets);
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    bool ok = framer.GetEvents() == expected && framer.GetFramingErrors() == 0;
+    std::cout << "  Events : " << framer.GetEvents() << " / " << expected << (ok ? " \033[1;32m(exact)\033[0m" : " \033[1;31m(MISMATCH)\033[0m")
+              << " | Errors: " << framer.GetFramingErrors() << "\n";
+    std::cout << "  Speed  : " << std::fixed << std::setprecision(1) << (streamBytes / 1048576.0) / sec << " MB/s | "
+              << (framer.GetEvents() / sec) / 1e6 << " Mevents/s\n";
+    return ok ? 0 : 1;
+}
+
+// 베이스라인 잡음 + 펄스 파형 이벤트를 stream 전체에 연속으로 채움 (마지막 이벤트는 잘릴 수 있음)
+static void FillWaveStream(std::vector<unsigned char>& stream, int recordLen) {
+    const unsigned int dataLength = (unsigned int)recordLen * 2 + 32;
+    const size_t eventBytes = EventFramer::kHeaderBytes + (size_t)recordLen * 8;
+    const size_t streamBytes = stream.size();
+
+    uint32_t rng = 12345;
+    for (size_t off = 0; off < streamBytes; off += eventBytes) {
+        size_t n = std::min(eventBytes, streamBytes - off);
+        unsigned char* h = stream.data() + off;
+        std::fill(h, h + std::min(n, EventFramer::kHeaderBytes), 0);
+        if (n >= 16) {
+            h[0] = dataLength & 0xFF; h[4] = (dataLength >> 8) & 0xFF;
+            h[8] = (dataLength >> 16) & 0xFF; h[12] = (dataLength >> 24) & 0xFF;
+        }
+        for (size_t k = EventFramer::kHeaderBytes; k + 1 < n; k += 2) {
+            size_t sample = (k - EventFramer::kHeaderBytes) / 8;
+            rng = rng * 1664525u + 1013904223u;
+            int adc = 3500 + (int)((rng >> 24) % 9) - 4;
+            if (sample > (size_t)recordLen / 4 && sample < (size_t)recordLen / 4 + 40) adc -= 800;
+            stream[off + k] = adc & 0xFF;
+            stream[off + k + 1] = (adc >> 8) & 0xFF;
+        }
+    }
+}
+
+// 💡 [COMPRESS] 코덱 x 압축 스레드 수별 처리량 / 압축률 / 블록당 지연 (Delta8 필터 적용)
+// 베이스라인 잡음 + 펄스 파형 이벤트 스트림을 -b KB 블록 -n 개로 잘라 Consumer 와 같은 방식(스레드당 2개 in-flight)으로 제출하고,
+// 결과를 복원하여 원본과 일치하는지 확인합니다.
+int RunCompressBench(const BenchConfig& cfg) {
+    const size_t blockBytes = (size_t)cfg.blockKB * 1024;
+    const size_t streamBytes = blockBytes * cfg.nReads;
+
+    std::vector<unsigned char> stream(streamBytes);
+    FillWaveStream(stream, cfg.recordLen);
+
+    std::vector<int> threadCounts;
+    int hw = std::max(1, (int)std::thread::hardware_concurrency());
+    for (int t = 1; t < hw && t <= 16; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(std::min(hw, 16));
+
+    std::cout << "\033[1;36m[ Block Compression ]\033[0m  Record: " << cfg.recordLen << " samples | Block: " << cfg.blockKB
+              << " KB x " << cfg.nReads << " | Filter: delta8\n";
+    std::cout << "  Codec | Threads |   MB/s   |  Ratio | p50 (us) | p99 (us) | Verify\n";
+    std::cout << "  ------+---------+----------+--------+----------+----------+-------\n";
+
+    int failures = 0;
+    const int codecs[] = { BlockCodec::kLz4, BlockCodec::kZstd };
+    for (int codec : codecs) {
+        if (!BlockCodec::Available(codec)) {
+            std::cout << "  " << std::left << std::setw(5) << BlockCodec::Name(codec) << std::right << " | (not built in)\n";
+            continue;
+        }
+        for (int threads : threadCounts) {
+            CompressionPool pool(threads);
+            const size_t slots = (size_t)threads * 2;
+            std::vector<CompressionJob> jobs(slots);
+            std::vector<std::unique_ptr<RawBuffer>> raws, outs;
+            for (size_t i = 0; i < slots; i++) {
+                raws.emplace_back(new RawBuffer(blockBytes));
+                outs.emplace_back(new RawBuffer(BlockCodec::Bound(codec, blockBytes)));
+            }
+
+            LatencyHistogram lat;
+            uint64_t stored = 0;
+            bool verified = true;
+            std::vector<unsigned char> check(blockBytes);
+
+            // 완료된 슬롯 회수: 통계 기록 + 복원 검증 (검증 시간은 처리량에서 제외하기 위해 블록 수가 적은 첫 회전만)
+            auto collect = [&](size_t slot, int block) {
+                CompressionJob& job = jobs[slot];
+                pool.Wait(&job);
+                lat.Record(job.latencyNs);
+                stored += job.compBytes;
+                if (block < (int)slots) {
+                    const unsigned char* src = job.usedCodec != BlockCodec::kNone ? job.out->data : job.raw->data;
+                    if (!BlockCodec::Decompress(job.usedCodec, src, job.compBytes, check.data(), job.rawBytes)) verified = false;
+                    if (job.filter == BlockCodec::kFilterDelta8) BlockCodec::Delta8Decode(check.data(), job.rawBytes);
+                    if (!std::equal(check.begin(), check.begin() + job.rawBytes, stream.begin() + (size_t)block * blockBytes)) verified = false;
+                }
+            };
+
+            auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < cfg.nReads; i++) {
+                size_t slot = (size_t)i % slots;
+                if (i >= (int)slots) collect(slot, i - (int)slots);
+                RawBuffer* raw = raws[slot].get();
+                std::copy(stream.begin() + (size_t)i * blockBytes, stream.begin() + (size_t)(i + 1) * blockBytes, raw->data);
+                raw->size = blockBytes;
+                jobs[slot].raw = raw;
+                jobs[slot].out = outs[slot].get();
+                jobs[slot].codec = codec;
+                jobs[slot].level = 1;
+                jobs[slot].filter = BlockCodec::kFilterDelta8;
+                pool.Submit(&jobs[slot]);
+            }
+            for (int i = std::max(0, cfg.nReads - (int)slots); i < cfg.nReads; i++) collect((size_t)i % slots, i);
+            double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+            if (!verified) failures++;
+            std::cout << "  " << std::left << std::setw(5) << BlockCodec::Name(codec) << std::right << " | "
+                      << std::setw(7) << threads << " | "
+                      << std::setw(8) << std::fixed << std::setprecision(1) << (streamBytes / 1048576.0) / sec << " | "
+                      << std::setw(6) << std::setprecision(2) << (stored > 0 ? (double)streamBytes / stored : 0.0) << " | "
+                      << std::setw(8) << std::setprecision(1) << lat.PercentileNs(0.50) / 1000.0 << " | "
+                      << std::setw(8) << lat.PercentileNs(0.99) / 1000.0 << " | "
+                      << (verified ? "\033[1;32mOK\033[0m" : "\033[1;31mFAIL\033[0m") << "\n";
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+// 💡 [PIPELINE] Producer -> DataQ -> Consumer(EventFramer) -> Writer -> FreeQ 전체 순환을 보드 없이 구동하는 종단 간 스윕
+// 소스: 합성 파형 스트림(-l) 또는 기존 .dat 재생(-r). Producer 는 USB 대신 메모리 복사로 블록을 채우므로 결과는 파이프라인 상한입니다.
+// 블록 크기(-b) x 풀 깊이(-p) x 큐(-Q) x Writer(-W) 조합마다 처리량 / 큐 체류 시간 / GB 당 CPU 시간을 측정하고 -j 로 JSON 출력
+struct PipelineSource {
+    std::vector<unsigned char> stream;   // 완결된 이벤트만 담긴 순환 스트림
+    std::vector<uint64_t> offsets;       // 이벤트 헤더 시작 위치 (정답 이벤트 수 계산용)
+    std::string name;
+};
+
+struct PipelineResult {
+    int blockKB = 0;
+    int poolDepth = 0;
+    std::string queue;
+    std::string writer;
+    uint64_t bytes = 0;
+    uint64_t events = 0;
+    uint64_t expected = 0;
+    double sec = 0;
+    double cpuSec = 0;
+    uint64_t poolWaits = 0;
+    LatencyHistogram dwell;
+    double writeP99Us = 0;
+    bool verified = false;
+};
+
+static double ProcessCpuSec() {
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// 쉼표로 구분된 정수 목록 ("1024,4096")
+static std::vector<int> ParseIntList(const std::string& text) {
+    std::vector<int> out;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(std::atoi(item.c_str()));
+    }
+    return out;
+}
+
+static std::vector<std::string> ParseNameList(const std::string& text) {
+    std::vector<std::string> out;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+// 재생 파일은 압축/병합되지 않은 보드별 .dat (이벤트가 연속된 스트림). 처음 256MB 안의 완결된 이벤트까지만 사용
+static bool LoadPipelineSource(const BenchConfig& cfg, PipelineSource& src) {
+    if (!cfg.replayPath.empty()) {
+        FILE* fp = std::fopen(cfg.replayPath.c_str(), "rb");
+        if (!fp) {
+            ELog::Print(ELog::ERROR, "Cannot open replay file " + cfg.replayPath);
+            return false;
+        }
+        src.stream.resize((size_t)256 * 1024 * 1024);
+        src.stream.resize(std::fread(src.stream.data(), 1, src.stream.size(), fp));
+        std::fclose(fp);
+        src.name = cfg.replayPath;
+    } else {
+        const size_t eventBytes = EventFramer::kHeaderBytes + (size_t)cfg.recordLen * 8;
+        src.stream.resize(std::max<size_t>((size_t)64 * 1024 * 1024 / eventBytes, 1) * eventBytes);
+        FillWaveStream(src.stream, cfg.recordLen);
+        src.name = "synthetic (" + std::to_string(cfg.recordLen) + " samples/event)";
+    }
+
+    size_t off = 0;
+    while (off + EventFramer::kHeaderBytes <= src.stream.size()) {
+        uint64_t n = EventFramer::EventBytes(src.stream.data() + off);
+        if (n == 0 || off + n > src.stream.size()) break;
+        src.offsets.push_back(off);
+        off += n;
+    }
+    src.stream.resize(off);
+    if (src.offsets.empty()) {
+        ELog::Print(ELog::ERROR, "No complete events in source " + src.name);
+        return false;
+    }
+    return true;
+}
+
+// 스트림을 처음부터 totalBytes 만큼 순환 재생했을 때 헤더가 완성되는 이벤트 수 (EventFramer 와 같은 기준)
+static uint64_t ExpectedEvents(const PipelineSource& src, uint64_t totalBytes) {
+    const uint64_t cycle = src.stream.size();
+    uint64_t n = totalBytes / cycle * src.offsets.size();
+    uint64_t rem = totalBytes % cycle;
+    if (rem >= EventFramer::kHeaderBytes) {
+        n += std::upper_bound(src.offsets.begin(), src.offsets.end(), rem - EventFramer::kHeaderBytes) - src.offsets.begin();
+    }
+    return n;
+}
+
+static BufferQueue* CreateBenchQueue(const std::string& kind, int depth) {
+    size_t capacity = std::max<size_t>(1024, (size_t)depth);
+    if (kind == "mutex") return new RawBufferPool();
+    if (kind == "spsc")  return new SpscBufferQueue(capacity, true);
+    if (kind == "spin")  return new SpscBufferQueue(capacity, false);
+    return nullptr;
+}
+
+static const char* BenchQueueLabel(const std::string& kind) {
+    if (kind == "spsc") return "spsc+eventfd";
+    if (kind == "spin") return "spsc+spin";
+    return "mutex";
+}
+
+static bool RunPipelinePoint(const BenchConfig& cfg, const PipelineSource& src, int blockKB, int depth,
+                             const std::string& queueKind, int backend, PipelineResult& res) {
+    const size_t blockBytes = (size_t)blockKB * 1024;
+    const uint64_t nBlocks = std::max<uint64_t>(((uint64_t)cfg.pipelineMB * 1048576 + blockBytes - 1) / blockBytes, 1);
+
+    DaqOptions opt;
+    opt.writerBackend = backend;
+    std::unique_ptr<RawWriter> writer(RawWriter::Create(opt));
+    if (!writer->Open(cfg.outPath)) {
+        ELog::Print(ELog::ERROR, "Cannot open " + cfg.outPath);
+        return false;
+    }
+
+    // 실제 파이프라인과 같은 Arena 버퍼 (Huge Page + mlock + pre-fault). Arena 가 2MB 단위로 커져도 depth 개만 순환
+    BufferArena arena((size_t)depth * blockBytes, opt.bufferHugePages != 0, opt.bufferMlock != 0);
+    std::unique_ptr<BufferQueue> dataQ(CreateBenchQueue(queueKind, depth));
+    std::unique_ptr<BufferQueue> freeQ(CreateBenchQueue(queueKind, depth));
+    {
+        RawBufferPool staging;
+        arena.Populate(&staging, blockBytes);
+        RawBuffer* b = nullptr;
+        for (int i = 0; i < depth && staging.TryPop(b); i++) freeQ->Push(b);
+    }
+    RawWriter::ReleaseFn release = [&freeQ](RawBuffer* b) { freeQ->Push(b); };
+
+    std::atomic<bool> producerDone(false);
+    uint64_t poolWaits = 0;
+    EventFramer framer;
+
+    double cpu0 = ProcessCpuSec();
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::thread producer([&]() {
+        size_t pos = 0;
+        for (uint64_t i = 0; i < nBlocks; i++) {
+            RawBuffer* buf = nullptr;
+            if (!freeQ->TryPop(buf)) {
+                poolWaits++;
+                while (!freeQ->WaitAndPopFor(buf, 100)) {}
+            }
+            // ReadDATA 대신 소스 스트림을 순환 복사
+            for (size_t done = 0; done < blockBytes; ) {
+                size_t n = std::min(blockBytes - done, src.stream.size() - pos);
+                std::memcpy(buf->data + done, src.stream.data() + pos, n);
+                done += n;
+                pos = (pos + n) % src.stream.size();
+            }
+            buf->size = blockBytes;
+            buf->stampNs = NowNs();
+            dataQ->Push(buf);
+        }
+        producerDone = true;
+        dataQ->Stop();
+    });
+
+    // ConsumerWorker 와 같은 순서: 프레이밍 -> Writer 제출. 대기 중에는 완료된 비동기 기록을 회수
+    while (!producerDone || dataQ->Size() > 0) {
+        RawBuffer* buf = nullptr;
+        if (!dataQ->WaitAndPopFor(buf, 1)) {
+            writer->Poll();
+            continue;
+        }
+        res.dwell.Record(NowNs() - buf->stampNs);
+        buf->nEvents = (uint32_t)framer.Feed(buf->data, buf->size, &buf->eventOffsets);
+        writer->Append(buf, release);
+    }
+    producer.join();
+    writer->Close();
+
+    res.sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    res.cpuSec = ProcessCpuSec() - cpu0;
+    res.blockKB = blockKB;
+    res.poolDepth = depth;
+    res.queue = BenchQueueLabel(queueKind);
+    res.writer = writer->GetName();
+    res.bytes = writer->GetBytesWritten();
+    res.events = framer.GetEvents();
+    res.expected = ExpectedEvents(src, nBlocks * blockBytes);
+    res.poolWaits = poolWaits;
+    res.writeP99Us = writer->GetLatency().PercentileNs(0.99) / 1000.0;
+    res.verified = res.events == res.expected && framer.GetFramingErrors() == 0 && writer->GetErrorCount() == 0 &&
+                   res.bytes == nBlocks * blockBytes;
+    std::remove(cfg.outPath.c_str());
+    return true;
+}
+
+static void WritePipelineJson(const std::string& path, const PipelineSource& src, const std::vector<PipelineResult>& results) {
+    FILE* fp = std::fopen(path.c_str(), "w");
+    if (!fp) {
+        ELog::Print(ELog::ERROR, "Cannot write " + path);
+        return;
+    }
+    std::fprintf(fp, "{\n  \"benchmark\": \"pipeline\",\n  \"source\": \"%s\",\n  \"source_bytes\": %zu,\n  \"source_events\": %zu,\n",
+                 src.name.c_str(), src.stream.size(), src.offsets.size());
+    std::fprintf(fp, "  \"cpus\": %u,\n  \"results\": [\n", std::thread::hardware_concurrency());
+    for (size_t i = 0; i < results.size(); i++) {
+        const PipelineResult& r = results[i];
+        double gb = r.bytes / 1073741824.0;
+        std::fprintf(fp, "    {\"block_kb\": %d, \"pool_depth\": %d, \"queue\": \"%s\", \"writer\": \"%s\", "
+                         "\"bytes\": %llu, \"events\": %llu, \"seconds\": %.6f, \"mb_per_s\": %.2f, \"events_per_s\": %.1f, "
+                         "\"dwell_p50_us\": %.2f, \"dwell_p99_us\": %.2f, \"dwell_p999_us\": %.2f, \"dwell_max_us\": %.2f, "
+                         "\"cpu_sec_per_gb\": %.4f, \"pool_waits\": %llu, \"write_p99_us\": %.2f, \"verified\": %s}%s\n",
+                     r.blockKB, r.poolDepth, r.queue.c_str(), r.writer.c_str(),
+                     (unsigned long long)r.bytes, (unsigned long long)r.events, r.sec,
+                     (r.bytes / 1048576.0) / r.sec, r.events / r.sec,
+                     r.dwell.PercentileNs(0.50) / 1000.0, r.dwell.PercentileNs(0.99) / 1000.0,
+                     r.dwell.PercentileNs(0.999) / 1000.0, r.dwell.MaxNs() / 1000.0,
+                     gb > 0 ? r.cpuSec / gb : 0.0, (unsigned long long)r.poolWaits, r.writeP99Us,
+                     r.verified ? "true" : "false", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(fp, "  ]\n}\n");
+    std::fclose(fp);
+    ELog::Print(ELog::INFO, "Pipeline results written to " + path);
+}
+
+int RunPipelineBench(const BenchConfig& cfg) {
+    PipelineSource src;
+    if (!LoadPipelineSource(cfg, src)) return 1;
+
+    std::vector<int> blocks = cfg.blockList.empty() ? std::vector<int>{1024, 4096} : cfg.blockList;
+    std::vector<int> depths = cfg.poolList.empty() ? std::vector<int>{8, 32} : cfg.poolList;
+    std::vector<std::string> queues = ParseNameList(cfg.queueList);
+    std::vector<int> backends;
+    for (const std::string& w : ParseNameList(cfg.writerList)) {
+        if (w == "stdio")       backends.push_back(DaqOptions::kWriterStdio);
+        else if (w == "direct") backends.push_back(DaqOptions::kWriterDirect);
+        else if (w == "uring")  backends.push_back(DaqOptions::kWriterUring);
+        else { ELog::Print(ELog::ERROR, "Unknown writer backend: " + w); return 1; }
+    }
+    for (const std::string& q : queues) {
+        std::unique_ptr<BufferQueue> probe(CreateBenchQueue(q, 1));
+        if (!probe) { ELog::Print(ELog::ERROR, "Unknown queue type: " + q); return 1; }
+    }
+    for (int blockKB : blocks) {
+        if (blockKB <= 0 || blockKB % 4 != 0) { ELog::Print(ELog::ERROR, Form("Invalid block size %d KB (must be a multiple of 4)", blockKB)); return 1; }
+    }
+    for (int depth : depths) {
+        if (depth <= 0) { ELog::Print(ELog::ERROR, Form("Invalid pool depth %d", depth)); return 1; }
+    }
+
+    std::cout << "\033[1;36m[ End-to-End Pipeline ]\033[0m  Source: " << src.name << " | " << cfg.pipelineMB
+              << " MB per point | File: " << cfg.outPath << "\n";
+    std::cout << "   Block KB | Pool |    Queue     |  Writer  |   MB/s   |  kEv/s   | dwell p50 | p99 (us) | p999 (us) | CPU s/GB | Waits | Verify\n";
+    std::cout << "  ----------+------+--------------+----------+----------+----------+-----------+----------+-----------+----------+-------+-------\n";
+
+    std::vector<PipelineResult> results;
+    int failures = 0;
+    for (int blockKB : blocks) {
+        for (int depth : depths) {
+            for (const std::string& q : queues) {
+                for (int backend : backends) {
+                    results.emplace_back();
+                    PipelineResult& r = results.back();
+                    if (!RunPipelinePoint(cfg, src, blockKB, depth, q, backend, r)) return 1;
+                    if (!r.verified) failures++;
+
+                    double gb = r.bytes / 1073741824.0;
+                    std::cout << "   " << std::setw(8) << r.blockKB << " | " << std::setw(4) << r.poolDepth << " | "
+                              << std::left << std::setw(12) << r.queue << " | " << std::setw(8) << r.writer << std::right << " | "
+                              << std::setw(8) << std::fixed << std::setprecision(1) << (r.bytes / 1048576.0) / r.sec << " | "
+                              << std::setw(8) << (r.events / r.sec) / 1000.0 << " | "
+                              << std::setw(9) << r.dwell.PercentileNs(0.50) / 1000.0 << " | "
+                              << std::setw(8) << r.dwell.PercentileNs(0.99) / 1000.0 << " | "
+                              << std::setw(9) << r.dwell.PercentileNs(0.999) / 1000.0 << " | "
+                              << std::setw(8) << std::setprecision(3) << (gb > 0 ? r.cpuSec / gb : 0.0) << " | "
+                              << std::setw(5) << r.poolWaits << " | "
+                              << (r.verified ? "\033[1;32mOK\033[0m" : "\033[1;31mFAIL\033[0m") << "\n";
+                }
+            }
+        }
+    }
+
+    if (!cfg.jsonPath.empty()) WritePipelineJson(cfg.jsonPath, src, results);
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:c:b:n:w:u:q:p:o:l:Q:W:v:r:j:h")) != -1) {
+        switch (opt) {
+            case 'm': cfg.mode = optarg; break;
+            case 'c': cfg.chunkKB = std::atoi(optarg); break;
+            case 'b':
+                cfg.blockList = ParseIntList(optarg);
+                if (!cfg.blockList.empty()) cfg.blockKB = cfg.blockList.front();
+                break;
+            case 'n': cfg.nReads = std::atoi(optarg); break;
+            case 'w': cfg.bandwidthMBps = std::atof(optarg); break;
+            case 'u': cfg.turnaroundUs = std::atoi(optarg); break;
+            case 'q': cfg.queueItems = std::atoi(optarg); break;
+            case 'p':
+                cfg.poolList = ParseIntList(optarg);
+                if (!cfg.poolList.empty()) cfg.poolDepth = cfg.poolList.front();
+                break;
+            case 'o': cfg.outPath = optarg; break;
+            case 'l': cfg.recordLen = std::atoi(optarg); break;
+            case 'Q': cfg.queueList = optarg; break;
+            case 'W': cfg.writerList = optarg; break;
+            case 'v': cfg.pipelineMB = std::atoi(optarg); break;
+            case 'r': cfg.replayPath = optarg; break;
+            case 'j': cfg.jsonPath = optarg; break;
+            case 'h': PrintUsage(); return 0;
+            default: PrintUsage(); return 1;
+        }
+    }
+
+    if (cfg.mode == "usb")   return RunUsbBench(cfg);
+    if (cfg.mode == "queue") return RunQueueBench(cfg);
+    if (cfg.mode == "disk")  return RunDiskBench(cfg);
+    if (cfg.mode == "frame") return RunFrameBench(cfg);
+    if (cfg.mode == "compress") return RunCompressBench(cfg);
+    if (cfg.mode == "pipeline") return RunPipelineBench(cfg);
+
+    ELog::Print(ELog::ERROR, "Unknown benchmark mode: " + cfg.mode);
+    PrintUsage();
+    return 1;
+}
@@ -5,25 +5,247 @@
 #include <chrono>
 #include <getopt.h>
 #include <cstdlib>
-#include <csignal>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <functional>
 
 #include "RunInfo.hh"
 #include "ConfigParser.hh"
 #include "BinaryDaqManager.hh"
+#include "WaveformPublisher.hh"
+#include "RunControl.hh"
 #include "ELog.hh"
 #include "TString.h"
 
 BinaryDaqManager* gDaqManager = nullptr;
+volatile std::sig_atomic_t gDaemonQuit = 0;
+bool gDaemonMode = false;
+bool gScanMode = false;
 
 // Ctrl+C 인터럽트 처리기 (안전 종료)
 void SignalHandler(int signum) {
     std::cout << "\n";
     ELog::Print(ELog::WARNING, "Interrupt signal (Ctrl+C) received! Shutting down gracefully...");
-    if (gDaqManager) {
+    // 문턱값 스캔은 현재 단계에서 멈추고 THR 복구 (스캔 중인 데몬도 같음)
+    if (gScanMode && gDaqManager) gDaqManager->AbortScan();
+    // 데몬 모드는 명령 루프가 진행 중인 런을 정리한 뒤 종료
+    if (gDaemonMode) {
+        gDaemonQuit = 1;
+        return;
+    }
+    if (gDaqManager && !gScanMode) {
         gDaqManager->Stop();
     }
 }
 
+// Config 백업 (런마다 run_<번호>.cfg). 경로는 데몬 configure 명령으로도 들어오므로 셸을 거치지 않고 복사
+void BackupConfig(const std::string& configFile, int runNumber) {
+    std::string backupConfig = Form("run_%04d.cfg", runNumber);
+    std::ifstream in(configFile, std::ios::binary);
+    std::ofstream out(backupConfig, std::ios::binary | std::ios::trunc);
+    if (in && out && (out << in.rdbuf())) {
+        ELog::Print(ELog::INFO, Form("Configuration backed up to: %s", backupConfig.c_str()));
+    } else {
+        ELog::Print(ELog::WARNING, "Cannot back up configuration " + configFile + " to " + backupConfig);
+    }
+}
+
+// 💡 [문턱값 스캔] 파일 기록 없이 THR 대 트리거율 표를 만들어 출력 + thr_scan_<run>.txt 저장
+bool RunThresholdScan(int first, int last, int step, double targetHz, int runNumber, std::string& tableFile) {
+    std::vector<ThresholdScanResult> results;
+    gScanMode = true;
+    const bool complete = gDaqManager->ScanThresholds(first, last, step, results);
+    gScanMode = false;
+    if (results.empty()) return false;
+
+    ThresholdScan::Print(results, targetHz);
+    tableFile = Form("thr_scan_%04d.txt", runNumber);
+    if (ThresholdScan::Save(tableFile, results, targetHz)) {
+        ELog::Print(ELog::INFO, "Threshold scan table saved to: " + tableFile);
+    }
+    return complete;
+}
+
+// 💡 [DACOFF 보정] 보드 pedestal 측정으로 DACOFF 탐색 후 결과를 설정 조각 (DACOFF 줄) dacoff_cal_<run>.txt 로 저장
+// 보정한 값은 이 프로세스의 보드 설정에도 반영됨 (데몬: 다음 런부터 사용)
+bool RunDacCalibration(int targetAdc, int runNumber, std::string& fragmentFile) {
+    std::vector<DacCalibration> results;
+    const bool ok = gDaqManager->CalibrateDacOffsets(targetAdc, results);
+    if (!ok) return false;
+
+    const int tolerance = gDaqManager->GetOptions().dacCalTolerance;
+    fragmentFile = Form("dacoff_cal_%04d.txt", runNumber);
+    FILE* out = std::fopen(fragmentFile.c_str(), "w");
+    if (out) std::fprintf(out, "# DACOFF calibration: pedestal target %d +- %d ADC\n", targetAdc, tolerance);
+    for (const DacCalibration& r : results) {
+        std::string line = Form("DACOFF %d %d %d %d", r.dacoff[0], r.dacoff[1], r.dacoff[2], r.dacoff[3]);
+        std::string missing;
+        for (int ch = 0; ch < 4; ch++) {
+            if (!r.converged[ch]) missing += " " + std::to_string(ch);
+        }
+        const std::string note = missing.empty() ? "" : ", ch" + missing + " cannot reach the target";
+        ELog::Print(missing.empty() ? ELog::INFO : ELog::WARNING,
+                    Form("[MID %d] %s -> pedestal %d %d %d %d (%d measurements, %.0f ms)%s", r.mid, line.c_str(), r.pedestal[0],
+                         r.pedestal[1], r.pedestal[2], r.pedestal[3], r.rounds, r.ms, note.c_str()));
+        if (!out) continue;
+        std::fprintf(out, "# MID %d: pedestal %d %d %d %d (goes under BOARD %d in settings.cfg)\n", r.mid, r.pedestal[0],
+                     r.pedestal[1], r.pedestal[2], r.pedestal[3], r.mid);
+        // 목표에 닿지 못한 채널이 있으면 줄을 주석으로 남김 (케이블/입력 확인)
+        if (missing.empty()) std::fprintf(out, "%s\n", line.c_str());
+        else std::fprintf(out, "# %s   (ch%s: target out of DACOFF range)\n", line.c_str(), missing.c_str());
+    }
+    if (!out) {
+        ELog::Print(ELog::ERROR, "Cannot write DACOFF calibration: " + fragmentFile);
+        return false;
+    }
+    std::fclose(out);
+    ELog::Print(ELog::INFO, "DACOFF calibration saved to: " + fragmentFile);
+    return true;
+}
+
+// 💡 [데몬] 보드를 열어 둔 채 소켓 명령으로 런을 반복 (USB 열기 + 레지스터 설정 + 버퍼 풀 확보는 시작 시 한 번)
+// 명령 (한 줄씩, 응답은 "OK ..." / "ERR ..."):
+//   ping | status | start <file> [maxEvents] [maxTime] | stop | configure [config] | quit
+//   set <THR|DLY|PSW|TRIG_ENABLE> <value> [ch|all] [mid|all]  (런 중이면 다음 BCOUNT 폴링 사이에 적용 + 스트림에 기록)
+//   scan <first> <last> [step] [targetHz]                    (런 사이에만, 끝날 때까지 응답하지 않음)
+//   calibrate <pedestal ADC>                                 (런 사이에만, DACOFF 보정 후 다음 런부터 새 값)
+int RunDaemon(const std::string& socketPath, std::string configFile, std::unique_ptr<RunInfo>& runInfo,
+              const std::function<void(DaqOptions&)>& applyOverrides) {
+    RunControlServer server;
+    if (!server.Open(socketPath)) return 1;
+    ELog::Print(ELog::INFO, "Daemon mode: waiting for run control commands on " + socketPath);
+
+    bool quit = false;
+    std::string line;
+    while (!quit && !gDaemonQuit) {
+        // maxEvents/maxTime 으로 스스로 끝난 런은 명령을 기다리지 않고 바로 정리 (요약 출력, 파일 닫기)
+        if (gDaqManager->HasPendingRun() && !gDaqManager->IsRunning()) gDaqManager->Stop();
+        if (!server.WaitCommand(line, 200)) continue;
+
+        std::istringstream iss(line);
+        std::string cmd;
+        iss >> cmd;
+        const bool running = gDaqManager->IsRunning();
+
+        if (cmd == "ping") {
+            server.Reply("OK pong");
+        } else if (cmd == "status") {
+            server.Reply(Form("OK state=%s run=%d file=%s events=%llu bytes=%llu", running ? "running" : "idle",
+                              runInfo->GetRunNumber(), gDaqManager->GetOutFileName().c_str(),
+                              (unsigned long long)gDaqManager->GetEvents(), (unsigned long long)gDaqManager->GetBytes()));
+        } else if (cmd == "start") {
+            std::string outFile;
+            int maxEvents = 0, maxTime = 0;
+            iss >> outFile >> maxEvents >> maxTime;
+            if (outFile.empty()) {
+                server.Reply("ERR usage: start <file> [maxEvents] [maxTime]");
+            } else if (running) {
+                server.Reply("ERR busy: run in progress (" + gDaqManager->GetOutFileName() + ")");
+            } else {
+                auto t0 = std::chrono::steady_clock::now();
+                BackupConfig(configFile, runInfo->GetRunNumber());
+                if (gDaqManager->Start(outFile, maxEvents, maxTime)) {
+                    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+                    server.Reply(Form("OK started %s in %.1f ms", outFile.c_str(), ms));
+                } else {
+                    server.Reply("ERR cannot start " + outFile);
+                }
+            }
+        } else if (cmd == "stop") {
+            if (!running && !gDaqManager->HasPendingRun()) {
+                server.Reply("ERR not running");
+            } else {
+                gDaqManager->Stop();
+                server.Reply(Form("OK stopped events=%llu bytes=%llu", (unsigned long long)gDaqManager->GetEvents(),
+                                  (unsigned long long)gDaqManager->GetBytes()));
+            }
+        } else if (cmd == "configure") {
+            // 경로는 줄의 나머지 전체 (공백 포함 가능)
+            std::string file;
+            std::getline(iss >> std::ws, file);
+            file.erase(file.find_last_not_of(" \t\r") + 1);
+            if (file.empty()) file = configFile;
+            std::unique_ptr<RunInfo> nextInfo(new RunInfo());
+            DaqOptions nextOptions;
+            ConfigParser parser;
+            if (running) {
+                server.Reply("ERR busy: stop the run before configure");
+            } else if (!parser.Parse(file, nextInfo.get(), &nextOptions)) {
+                server.Reply("ERR cannot parse " + file);
+            } else {
+                applyOverrides(nextOptions);
+                if (gDaqManager->Configure(nextInfo.get(), nextOptions)) {
+                    runInfo.swap(nextInfo);   // 이전 RunInfo 는 매니저가 더 이상 참조하지 않음
+                    configFile = file;
+                    server.Reply(Form("OK configured run=%d", runInfo->GetRunNumber()));
+                } else {
+                    server.Reply("ERR board layout differs from the open session (restart the daemon)");
+                }
+            }
+        } else if (cmd == "set") {
+            std::string name, chArg = "all", midArg = "all";
+            int value = 0;
+            const bool parsed = static_cast<bool>(iss >> name >> value);
+            iss >> chArg >> midArg;
+            const int param = DataFormat::ConfigParamFromName(name);
+            std::string error;
+            if (!parsed || !param) {
+                server.Reply("ERR usage: set <THR|DLY|PSW|TRIG_ENABLE> <value> [ch|all] [mid|all]");
+            } else if (!gDaqManager->QueueLiveChange(midArg == "all" ? -1 : std::atoi(midArg.c_str()), param,
+                                                     chArg == "all" ? -1 : std::atoi(chArg.c_str()), value, error)) {
+                server.Reply("ERR " + error);
+            } else {
+                server.Reply(Form("OK %s %s=%d ch=%s mid=%s", running ? "queued" : "applied", name.c_str(), value, chArg.c_str(), midArg.c_str()));
+            }
+        } else if (cmd == "scan") {
+            int first = 0, last = 0, step = 10;
+            double targetHz = gDaqManager->GetOptions().scanTargetHz;
+            const bool parsed = static_cast<bool>(iss >> first >> last);
+            iss >> step >> targetHz;
+            std::string tableFile;
+            if (!parsed) {
+                server.Reply("ERR usage: scan <first> <last> [step] [targetHz]");
+            } else if (running || gDaqManager->HasPendingRun()) {
+                server.Reply("ERR busy: stop the run before scan");
+            } else if (!RunThresholdScan(first, last, step, targetHz, runInfo->GetRunNumber(), tableFile)) {
+                server.Reply(tableFile.empty() ? std::string("ERR threshold scan not possible (see daemon log)")
+                                               : "ERR threshold scan aborted, partial table in " + tableFile);
+            } else {
+                server.Reply("OK scanned table=" + tableFile);
+            }
+        } else if (cmd == "calibrate") {
+            int targetAdc = 0;
+            std::string fragmentFile;
+            if (!(iss >> targetAdc) || targetAdc < 0 || targetAdc > 4095) {
+                server.Reply("ERR usage: calibrate <pedestal ADC 0-4095>");
+            } else if (running || gDaqManager->HasPendingRun()) {
+                server.Reply("ERR busy: stop the run before calibrate");
+            } else if (!RunDacCalibration(targetAdc, runInfo->GetRunNumber(), fragmentFile)) {
+                server.Reply("ERR DACOFF calibration failed (see daemon log)");
+            } else {
+                std::string values;
+                for (int i = 0; i < runInfo->GetNFadcBD(); i++) {
+                    FadcBD* bd = runInfo->GetFadcBD(i);
+                    values += Form(" DACOFF[%d]=%d,%d,%d,%d", bd->GetMID(), bd->GetDACOFF(0), bd->GetDACOFF(1), bd->GetDACOFF(2), bd->GetDACOFF(3));
+                }
+                server.Reply("OK calibrated file=" + fragmentFile + values);
+            }
+        } else if (cmd == "quit") {
+            server.Reply("OK bye");
+            quit = true;
+        } else {
+            server.Reply("ERR unknown command: " + cmd);
+        }
+    }
+
+    if (gDaqManager->IsRunning() || gDaqManager->HasPendingRun()) gDaqManager->Stop();
+    server.Close();
+    return 0;
+}
+
 // 💡 [UX 강화] 직관적이고 아름다운 Usage 출력 함수
 void PrintUsage() {
     std::cout << "\n\033[1;36m======================================================================\033[0m\n";
@@ -35,6 +257,23 @@ void PrintUsage() {
     std::cout << "  -o <file>     : Output raw data file (default: test_noise.dat)\n";
     std::cout << "  -n <events>   : Stop after N events (default: 0 = infinite)\n";
     std::cout << "  -t <sec>      : Stop after T seconds (default: 0 = infinite)\n";
+    std::cout << "  -a <depth>    : Async USB readout with N transfers in flight (overrides USB_READ_MODE)\n";
+    std::cout << "  -z <chunk_kb> : Zero-copy synchronous USB readout with given transfer size\n";
+    std::cout << "  -W <backend>  : Disk writer (0: fwrite, 1: O_DIRECT pwrite, 2: O_DIRECT + io_uring) (overrides WRITER_BACKEND)\n";
+    std::cout << "  -C <codec>    : Compress raw blocks (0: none, 1: LZ4, 2: zstd) (overrides COMPRESSION)\n";
+    std::cout << "  -R <sec>      : Roll over to a new subrun file every N seconds (run_001.dat, run_002.dat ...) (overrides ROLLOVER_SEC)\n";
+    std::cout << "  -S <MB>       : Roll over to a new subrun file every N MB (overrides ROLLOVER_MB)\n";
+    std::cout << "  -P <port>     : Publish live waveforms for the GUI monitor on tcp://127.0.0.1:<port>, 0: off (overrides ZMQ_PORT)\n";
+    std::cout << "  -c <p>[,<c>]  : Pin board 0 Producer (and Consumer) threads to CPU p (c), board i uses +i (overrides PRODUCER_CPU/CONSUMER_CPU)\n";
+    std::cout << "  -F <prio>     : Run Producer/Consumer with SCHED_FIFO priority (1-99, needs CAP_SYS_NICE) (overrides RT_PRIORITY)\n";
+    std::cout << "  -s <Hz>       : Use the simulated FADC500 at the given trigger rate instead of hardware (overrides DEVICE/SIM_TRIGGER_HZ)\n";
+    std::cout << "  -M            : Multi-board: write one merged file with MID-tagged blocks (overrides OUTPUT_MERGE)\n";
+    std::cout << "  -A            : Force a full ADC/DRAM alignment and refresh the alignment cache (ALIGN_CACHE 2)\n";
+    std::cout << "  -D <socket>   : Daemon mode: keep boards open and take start/stop/configure/status/set/scan/calibrate commands on a Unix socket\n";
+    std::cout << "  -T <a:b[:s]>  : Threshold scan: trigger rate per channel for THR a..b (step s, default 10), no data file, then exit\n";
+    std::cout << "  -w <ms>       : Threshold scan measuring window per point (overrides SCAN_WINDOW_MS)\n";
+    std::cout << "  -g <Hz>       : Threshold scan: suggest the lowest THR per channel at or below this rate (overrides SCAN_TARGET_HZ)\n";
+    std::cout << "  -B <adc>      : DACOFF calibration: find DACOFF per channel for this pedestal, write dacoff_cal_<run>.txt, then exit\n";
     std::cout << "  -h            : Print this help message\n";
     std::cout << "\033[1;36m======================================================================\033[0m\n\n";
 }
@@ -44,15 +283,56 @@ int main(int argc, char** argv) {
     std::string outFile = "test_noise.dat";
     int maxEvents = 0;
     int maxTime = 0;
+    int asyncDepth = 0;
+    int directChunkKB = 0;
+    bool mergeOutput = false;
+    int writerBackend = -1;
+    int compression = -1;
+    int rolloverSec = -1;
+    int rolloverMB = -1;
+    int zmqPort = -1;
+    int producerCpu = -1;
+    int consumerCpu = -1;
+    int rtPriority = -1;
+    int simTriggerHz = -1;
+    bool forceAlign = false;
+    std::string daemonSocket;
+    bool scanMode = false;
+    int scanFirst = 0, scanLast = 0, scanStep = 10;
+    int scanWindowMs = -1;
+    double scanTargetHz = -1;
+    int dacTarget = -1;
 
     // 명령줄 인수 파싱
     int opt;
-    while ((opt = getopt(argc, argv, "f:o:n:t:h")) != -1) {
+    while ((opt = getopt(argc, argv, "f:o:n:t:a:z:W:C:R:S:P:c:F:s:MAD:T:w:g:B:h")) != -1) {
         switch (opt) {
             case 'f': configFile = optarg; break;
             case 'o': outFile = optarg; break;
             case 'n': maxEvents = std::atoi(optarg); break;
             case 't': maxTime = std::atoi(optarg); break;
+            case 'a': asyncDepth = std::atoi(optarg); break;
+            case 'z': directChunkKB = std::atoi(optarg); break;
+            case 'W': writerBackend = std::atoi(optarg); break;
+            case 'C': compression = std::atoi(optarg); break;
+            case 'R': rolloverSec = std::atoi(optarg); break;
+            case 'S': rolloverMB = std::atoi(optarg); break;
+            case 'P': zmqPort = std::atoi(optarg); break;
+            case 'c':
+                if (std::sscanf(optarg, "%d,%d", &producerCpu, &consumerCpu) < 1) { PrintUsage(); return 1; }
+                break;
+            case 'F': rtPriority = std::atoi(optarg); break;
+            case 's': simTriggerHz = std::atoi(optarg); break;
+            case 'M': mergeOutput = true; break;
+            case 'A': forceAlign = true; break;
+            case 'D': daemonSocket = optarg; break;
+            case 'T':
+                if (std::sscanf(optarg, "%d:%d:%d", &scanFirst, &scanLast, &scanStep) < 2) { PrintUsage(); return 1; }
+                scanMode = true;
+                break;
+            case 'w': scanWindowMs = std::atoi(optarg); break;
+            case 'g': scanTargetHz = std::atof(optarg); break;
+            case 'B': dacTarget = std::atoi(optarg); break;
             case 'h': PrintUsage(); return 0;
             default: PrintUsage(); return 1;
         }
@@ -69,32 +349,87 @@ int main(int argc, char** argv) {
     std::signal(SIGTERM, SignalHandler);
 
     // 설정 파싱
-    RunInfo runInfo;
+    std::unique_ptr<RunInfo> runInfo(new RunInfo());
+    DaqOptions daqOptions;
     ConfigParser parser;
-    if (!parser.Parse(configFile, &runInfo)) {
+    if (!parser.Parse(configFile, runInfo.get(), &daqOptions)) {
         return 1;
     }
 
-    // Config 백업
-    std::string backupConfig = Form("run_%04d.cfg", runInfo.GetRunNumber());
-    std::string copyCmd = "cp " + configFile + " " + backupConfig;
-    if (system(copyCmd.c_str()) == 0) {
-        ELog::Print(ELog::INFO, Form("Configuration backed up to: %s", backupConfig.c_str()));
+    // 명령줄 옵션이 설정 파일보다 우선 (데몬 모드의 configure 에도 같은 규칙 적용)
+    auto applyOverrides = [&](DaqOptions& options) {
+        if (asyncDepth > 0) {
+            options.usbReadMode = DaqOptions::kUsbAsync;
+            options.usbAsyncDepth = asyncDepth;
+        } else if (directChunkKB > 0) {
+            options.usbReadMode = DaqOptions::kUsbDirect;
+            options.usbChunkKB = directChunkKB;
+        }
+        if (mergeOutput) options.outputMerge = 1;
+        if (writerBackend >= 0) options.writerBackend = writerBackend;
+        if (compression >= 0) options.compression = compression;
+        if (rolloverSec >= 0) options.rolloverSec = rolloverSec;
+        if (rolloverMB >= 0) options.rolloverMB = rolloverMB;
+        if (zmqPort >= 0) options.zmqPort = zmqPort;
+        if (producerCpu >= 0) options.producerCpu = producerCpu;
+        if (consumerCpu >= 0) options.consumerCpu = consumerCpu;
+        if (rtPriority >= 0) options.rtPriority = rtPriority;
+        if (forceAlign) options.alignCache = 2;
+        if (scanWindowMs > 0) options.scanWindowMs = scanWindowMs;
+        if (scanTargetHz >= 0) options.scanTargetHz = scanTargetHz;
+        if (simTriggerHz > 0) {
+            options.device = DaqOptions::kDeviceSim;
+            options.simTriggerHz = simTriggerHz;
+        }
+    };
+    applyOverrides(daqOptions);
+
+    // DAQ 매니저 생성 (장치 초기화) 및 가동
+    gDaemonMode = !daemonSocket.empty();
+    gDaqManager = new BinaryDaqManager(runInfo.get(), daqOptions);
+    if (dacTarget >= 0 && !gDaemonMode) {
+        std::string fragmentFile;
+        const bool ok = RunDacCalibration(dacTarget, runInfo->GetRunNumber(), fragmentFile);
+        delete gDaqManager;
+        return ok ? 0 : 1;
+    }
+    if (scanMode && !gDaemonMode) {
+        std::string tableFile;
+        const bool complete = RunThresholdScan(scanFirst, scanLast, scanStep, daqOptions.scanTargetHz, runInfo->GetRunNumber(), tableFile);
+        delete gDaqManager;
+        return complete ? 0 : 1;
+    }
+    if (!gDaemonMode) {
+        BackupConfig(configFile, runInfo->GetRunNumber());
+        gDaqManager->Start(outFile, maxEvents, maxTime);
     }
 
-    // DAQ 매니저 생성 및 가동
-    gDaqManager = new BinaryDaqManager(&runInfo);
-    gDaqManager->Start(outFile, maxEvents, maxTime);
+    // 💡 [파형 퍼블리셔] 라이브 링에서 최신 파형만 솎아 GUI 로 전송 (첫 번째 보드, 수집 스레드와 독립)
+    // 데몬 모드에서는 런이 바뀌어도 그대로 유지 (링이 새로 열리면 리더가 다시 붙음)
+    WaveformPublisher* publisher = nullptr;
+    if (daqOptions.zmqPort > 0 && daqOptions.liveRingMB > 0 && runInfo->GetFadcBD(0)) {
+        publisher = new WaveformPublisher(daqOptions.zmqPort, daqOptions.zmqMaxHz, runInfo->GetFadcBD(0)->GetMID());
+        if (!publisher->Start()) {
+            delete publisher;
+            publisher = nullptr;
+        }
+    }
 
-    // 메인 스레드는 DAQ가 끝날 때까지 대기
-    while (gDaqManager->IsRunning()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    int status = 0;
+    if (gDaemonMode) {
+        status = RunDaemon(daemonSocket, configFile, runInfo, applyOverrides);
+    } else {
+        // 메인 스레드는 DAQ가 끝날 때까지 대기
+        while (gDaqManager->IsRunning()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
     }
 
     // 안전하게 자원 해제
+    delete publisher;
     delete gDaqManager;
     
     ELog::Print(ELog::INFO, "DAQ System fully stopped and safely exited.");
 
-    return 0;
-}
\ No newline at end of file
+    return status;
+}
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <cstdlib>
 #include <sys/select.h> // 💡 STDIN 비동기 입력 제어용
 
 #include "TApplication.h"
@@ -15,6 +16,11 @@
 #include "TSystem.h"
 #include "TAxis.h"
 #include "ELog.hh"
+#include "RawStreamReader.hh"
+#include "LiveRing.hh"
+#include "EventFramer.hh"
+#include "StatusPage.hh"
+#include "ThreadTuning.hh"
 
 // 💡 [핵심 픽스] 비동기 키보드 및 파이프 입력 감지
 bool kbhit() {
@@ -30,20 +36,39 @@ int main(int argc, char** argv) {
     std::cout << "\033[1;32m   NKFADC500 Mini - LIVE Online Monitor (Auto-Clear)\033[0m\n";
     std::cout << "\033[1;36m========================================================\033[0m\n\n";
 
-    if (argc < 2) {
-        ELog::Print(ELog::FATAL, "Usage: ./online_monitor <live_data_file.dat>");
-        return 1;
-    }
+    // 💡 [라이브 이벤트 링] 기본은 DAQ 가 게시하는 공유 메모리 링 (디스크/페이지 캐시를 건드리지 않음)
+    //    .dat 경로를 주면 기존처럼 파일을 tail (오프라인 재생 또는 LIVE_RING_MB 0 인 DAQ)
+    std::string source = (argc >= 2) ? argv[1] : "shm";
+    int boardMid = (argc >= 3) ? std::atoi(argv[2]) : -1;   // 다중 보드에서 볼 보드 (-1: 병합 파일은 첫 보드, 링은 모든 보드)
+    const bool useRing = (source == "shm" || source.compare(0, 4, "shm:") == 0);
+    std::string ringName = (useRing && source.size() > 4) ? source.substr(4) : std::string(kLiveRingDefaultName);
 
-    std::string inputFile = argv[1];
-    
-    FILE* fp = fopen(inputFile.c_str(), "rb");
-    if (!fp) {
-        ELog::Print(ELog::FATAL, Form("Cannot open live binary file: %s", inputFile.c_str()));
+    if (!useRing && source.compare(0, 1, "-") == 0) {
+        ELog::Print(ELog::FATAL, "Usage: ./online_monitor [shm[:/name] | <live_data_file.dat>] [board_mid]");
         return 1;
     }
 
-    ELog::Print(ELog::INFO, Form("Tailing live DAQ stream : %s", inputFile.c_str()));
+    // 💡 [스레드 배치] 수집 중인 frontend 의 Producer/Consumer 전용 코어를 피함 (ROOT 스레드도 물려받음)
+    ThreadTuning::AvoidCpus(StatusPage::ActiveDaqCpuMask());
+
+    FILE* fp = nullptr;
+    RawStreamReader* reader = nullptr;
+    LiveRingReader ring;
+
+    if (useRing) {
+        ELog::Print(ELog::INFO, Form("Reading live event ring : /dev/shm%s%s", ringName.c_str(),
+                                     boardMid >= 0 ? Form(" (MID %d)", boardMid) : ""));
+    } else {
+        fp = fopen(source.c_str(), "rb");
+        if (!fp) {
+            ELog::Print(ELog::FATAL, Form("Cannot open live binary file: %s", source.c_str()));
+            return 1;
+        }
+        ELog::Print(ELog::INFO, Form("Tailing live DAQ stream : %s", source.c_str()));
+        // 💡 [다중 보드] 병합 파일은 선택 보드의 블록만 이어 붙여 읽음. 데이터 부족 시 읽은 부분을 보관하고 재시도
+        reader = new RawStreamReader(fp, boardMid);
+    }
+    bool haveHeader = false;
 
     TApplication app("app", &argc, argv);
     TCanvas* c1 = new TCanvas("c1", "FADC500 LIVE Waveform & Spectrum Monitor", 1600, 800);
@@ -71,66 +96,33 @@ int main(int argc, char** argv) {
     unsigned char header[128];
     unsigned int liveEventID = 0;
     auto last_update = std::chrono::steady_clock::now();
+    auto last_attach = last_update - std::chrono::seconds(1);
 
     std::vector<unsigned char> payload;
     std::vector<unsigned short> wave[4];
-
-    while (true) {
-        if (!gROOT->GetListOfCanvases()->FindObject("c1")) {
-            ELog::Print(ELog::INFO, "Monitor window closed by user. Shutting down gracefully...");
-            break;
-        }
-
-        // 💡 [핵심 픽스] GUI 수동 리프레시 명령('c') 또는 종료 명령('q') 감지
-        if (kbhit()) {
-            char cmd; std::cin >> cmd;
-            if (cmd == 'q') break;
-            else if (cmd == 'c') {
-                ELog::Print(ELog::INFO, "Clear command received. Resetting Histograms...");
-                for(int i=0; i<4; i++) { hWave[i]->Reset(); hSpec[i]->Reset(); }
-                c1->Update(); liveEventID = 0;
-            }
-        }
-
-        // 💡 [핵심 픽스] 동일한 파일에 덮어쓰기가 발생하여 파일 크기가 줄어들었을 때 자동 리셋
-        long current_pos = ftell(fp);
-        fseek(fp, 0, SEEK_END);
-        long file_size = ftell(fp);
-        fseek(fp, current_pos, SEEK_SET);
-
-        if (file_size < current_pos) {
-            ELog::Print(ELog::WARNING, "File truncation detected (New Run). Auto-clearing...");
-            rewind(fp);
-            for(int i=0; i<4; i++) { hWave[i]->Reset(); hSpec[i]->Reset(); }
-            c1->Update(); liveEventID = 0;
-            continue;
-        }
-
-        size_t bytes_read = fread(header, 1, 128, fp);
-        
-        if (bytes_read < 128) { 
-            clearerr(fp); 
-            gSystem->ProcessEvents(); 
-            std::this_thread::sleep_for(std::chrono::milliseconds(20)); 
-            if (bytes_read > 0) fseek(fp, -static_cast<long>(bytes_read), SEEK_CUR);
-            continue;
-        }
-
-        unsigned int data_length = header[0] + (header[4] << 8) + (header[8] << 16) + (header[12] << 24);
-        if (data_length <= 32) break; 
-
-        int num_samples = (data_length - 32) / 2; 
-        int payload_bytes = num_samples * 8; 
-
-        payload.resize(payload_bytes);
-        if (fread(payload.data(), 1, payload_bytes, fp) < (size_t)payload_bytes) {
-            fseek(fp, -static_cast<long>(128 + payload_bytes), SEEK_CUR); 
-            clearerr(fp); gSystem->ProcessEvents();
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
-            continue;
-        }
-
+    LiveBlock block;
+
+    // 💡 [상태 페이지] 모니터가 처리한 이벤트 수 + heartbeat (GUI 가 모니터 생존 여부 확인)
+    StatusPage status;
+    status.Create(StatusPage::kMonitor);
+    status.SetState(StatusPage::kRunning);
+
+    auto clearAll = [&]() {
+        for(int i=0; i<4; i++) { hWave[i]->Reset(); hSpec[i]->Reset(); }
+        c1->Update(); liveEventID = 0;
+        status.Header()->events.store(0, std::memory_order_relaxed);
+    };
+
+    auto idle = [&]() {
+        status.Heartbeat();
+        gSystem->ProcessEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    };
+
+    // 이벤트 1개 (128 바이트 헤더 + 파형) 처리: 스펙트럼 누적 + 0.1 초마다 파형 갱신
+    auto processEvent = [&](const unsigned char* data, int num_samples) {
         liveEventID++;
+        status.Header()->events.store(liveEventID, std::memory_order_relaxed);
 
         for(int i=0; i<4; i++) {
             wave[i].clear();
@@ -139,10 +131,10 @@ int main(int argc, char** argv) {
 
         for (int j = 0; j < num_samples; j++) {
             int offset = j * 8;
-            wave[0].push_back((payload[offset + 0] | (payload[offset + 4] << 8)) & 0x0FFF);
-            wave[1].push_back((payload[offset + 1] | (payload[offset + 5] << 8)) & 0x0FFF);
-            wave[2].push_back((payload[offset + 2] | (payload[offset + 6] << 8)) & 0x0FFF);
-            wave[3].push_back((payload[offset + 3] | (payload[offset + 7] << 8)) & 0x0FFF);
+            wave[0].push_back((data[offset + 0] | (data[offset + 4] << 8)) & 0x0FFF);
+            wave[1].push_back((data[offset + 1] | (data[offset + 5] << 8)) & 0x0FFF);
+            wave[2].push_back((data[offset + 2] | (data[offset + 6] << 8)) & 0x0FFF);
+            wave[3].push_back((data[offset + 3] | (data[offset + 7] << 8)) & 0x0FFF);
         }
 
         double bsl[4] = {0};
@@ -187,10 +179,109 @@ int main(int argc, char** argv) {
             }
             c1->Update(); 
             gSystem->ProcessEvents(); 
+            status.Heartbeat();
             last_update = now;
         }
+    };
+
+    while (true) {
+        if (!gROOT->GetListOfCanvases()->FindObject("c1")) {
+            ELog::Print(ELog::INFO, "Monitor window closed by user. Shutting down gracefully...");
+            break;
+        }
+
+        // 💡 [핵심 픽스] GUI 수동 리프레시 명령('c') 또는 종료 명령('q') 감지
+        if (kbhit()) {
+            char cmd; std::cin >> cmd;
+            if (cmd == 'q') break;
+            else if (cmd == 'c') {
+                ELog::Print(ELog::INFO, "Clear command received. Resetting Histograms...");
+                clearAll();
+            }
+        }
+
+        if (useRing) {
+            // DAQ 가 아직 시작 전이면 0.5 초마다 다시 붙어 봄 (모니터를 먼저 띄워도 됨)
+            if (!ring.IsAttached()) {
+                auto now = std::chrono::steady_clock::now();
+                if (now - last_attach > std::chrono::milliseconds(500)) {
+                    last_attach = now;
+                    if (ring.Attach(ringName)) {
+                        ELog::Print(ELog::INFO, "Attached to live event ring.");
+                        ThreadTuning::AvoidCpus(StatusPage::ActiveDaqCpuMask());   // 모니터를 DAQ 보다 먼저 띄운 경우
+                    }
+                }
+                idle();
+                continue;
+            }
+
+            LiveRingReader::Status st = ring.Next(block, boardMid);
+            if (st == LiveRingReader::kNewRun) {
+                ELog::Print(ELog::WARNING, "New run detected on live ring. Auto-clearing...");
+                clearAll();
+                continue;
+            }
+            if (st == LiveRingReader::kEmpty) {
+                idle();
+                continue;
+            }
+
+            // 슬롯 = 128 바이트 헤더로 시작하는 완결된 이벤트들
+            size_t pos = 0;
+            while (pos + EventFramer::kHeaderBytes <= block.data.size()) {
+                uint64_t evBytes = EventFramer::EventBytes(block.data.data() + pos);
+                if (evBytes == 0 || pos + evBytes > block.data.size()) break;
+                int num_samples = (int)((evBytes - EventFramer::kHeaderBytes) / 8);
+                processEvent(block.data.data() + pos + EventFramer::kHeaderBytes, num_samples);
+                pos += evBytes;
+            }
+            continue;
+        }
+
+        // 💡 [핵심 픽스] 동일한 파일에 덮어쓰기가 발생하여 파일 크기가 줄어들었을 때 자동 리셋
+        long current_pos = ftell(fp);
+        fseek(fp, 0, SEEK_END);
+        long file_size = ftell(fp);
+        fseek(fp, current_pos, SEEK_SET);
+
+        if (file_size < current_pos) {
+            ELog::Print(ELog::WARNING, "File truncation detected (New Run). Auto-clearing...");
+            reader->Rewind();
+            haveHeader = false;
+            clearAll();
+            continue;
+        }
+
+        if (!haveHeader) {
+            if (!reader->Read(header, 128)) { 
+                idle();
+                continue;
+            }
+            haveHeader = true;
+        }
+
+        unsigned int data_length = header[0] + (header[4] << 8) + (header[8] << 16) + (header[12] << 24);
+        if (data_length <= 32) break; 
+
+        int num_samples = (data_length - 32) / 2; 
+        int payload_bytes = num_samples * 8; 
+
+        payload.resize(payload_bytes);
+        if (!reader->Read(payload.data(), payload_bytes)) {
+            idle();
+            continue;
+        }
+        haveHeader = false;
+
+        processEvent(payload.data(), num_samples);
     }
 
-    fclose(fp);
+    if (useRing && ring.GetSkipped() > 0) {
+        ELog::Print(ELog::INFO, Form("Live ring: %llu blocks read, %llu skipped (monitor slower than DAQ)",
+                                     (unsigned long long)ring.GetRead(), (unsigned long long)ring.GetSkipped()));
+    }
+    delete reader;
+    if (fp) fclose(fp);
+    status.Close(StatusPage::kFinished);
     return 0;
 }
\ No newline at end of file
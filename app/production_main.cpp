@@ -5,6 +5,7 @@
 #include <string>
 #include <cstdint>
 #include <algorithm>
+#include <cstdlib>
 #include <chrono>
 #include <iomanip>
 #include <unistd.h>
@@ -20,6 +21,11 @@
 #include "TLine.h"
 #include "TSystem.h"
 #include "ELog.hh"
+#include "RawStreamReader.hh"
+#include "EventIndex.hh"
+#include "EventFramer.hh"
+#include "StatusPage.hh"
+#include "ThreadTuning.hh"
 
 // =========================================================================
 // [아키텍처 확장] Browser History Cache Manager (로컬 파일 DB)
@@ -83,6 +89,15 @@ bool kbhit() {
     return select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv) > 0;
 }
 
+// 인덱스로 이벤트 n 의 헤더 위치로 바로 이동 (성공 시 eventID = n)
+bool SeekToEvent(RawStreamReader& reader, const EventIndex* index, unsigned int n, unsigned int& eventID) {
+    if (!index) return false;
+    const DataFormat::IndexEntry* entry = index->FindEvent(n);
+    if (!entry || !reader.Seek(entry->offset, entry->blockSkip)) return false;
+    eventID = n;
+    return true;
+}
+
 void PrintUsage() {
     std::cout << "\n\033[1;36m======================================================================\033[0m\n";
     std::cout << "\033[1;32m      NKFADC500 Mini - Offline Production & Analysis Tool\033[0m\n";
@@ -93,6 +108,8 @@ void PrintUsage() {
     std::cout << "\033[1;37m[Optional]\033[0m\n";
     std::cout << "  -w             : Save full waveforms in the output tree (Warning: Large File)\n";
     std::cout << "  -d             : Interactive Event Display Mode (Visual Waveform Debugger)\n";
+    std::cout << "  -b <mid>       : Board MID to extract from a merged multi-board file (default: first board)\n";
+    std::cout << "  -r <first:last>: Process only events first..last (uses the .idx sidecar to seek; for parallel chunks)\n";
     std::cout << "\033[1;36m======================================================================\033[0m\n\n";
 }
 
@@ -100,11 +117,21 @@ int main(int argc, char** argv) {
     std::string inputFile = "";
     bool saveWaveform = false;
     bool interactiveMode = false;
+    int boardMid = -1;
+    long long rangeFirst = 0, rangeLast = -1;
 
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
         if (arg == "-w") saveWaveform = true;
         else if (arg == "-d") interactiveMode = true;
+        else if (arg == "-b" && i + 1 < argc) boardMid = std::atoi(argv[++i]);
+        else if (arg == "-r" && i + 1 < argc) {
+            std::string range = argv[++i];
+            size_t colon = range.find(':');
+            rangeFirst = std::atoll(range.substr(0, colon).c_str());
+            if (colon != std::string::npos && colon + 1 < range.size()) rangeLast = std::atoll(range.substr(colon + 1).c_str());
+            if (rangeFirst < 0) rangeFirst = 0;
+        }
         else if (arg[0] != '-') inputFile = arg;
     }
 
@@ -134,11 +161,26 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    // 💡 [스레드 배치] 같은 머신에서 수집 중인 frontend 의 Producer/Consumer 전용 코어를 피함
+    ThreadTuning::AvoidCpus(StatusPage::ActiveDaqCpuMask());
+
     fseek(fp, 0, SEEK_END);
     size_t totalBytes = ftell(fp);
     rewind(fp);
     double totalMB = totalBytes / 1048576.0;
 
+    // 💡 [다중 보드] 병합 파일이면 선택한 보드(MID)의 블록만 이어 붙여 읽고, 단일 보드 파일은 그대로 통과
+    RawStreamReader reader(fp, boardMid);
+
+    // 💡 [이벤트 인덱스] 수집 시 기록된 .idx 가 있으면 이벤트 N 으로 바로 이동 (없으면 기존처럼 순차 탐색)
+    EventIndex index;
+    bool haveIndex = index.Open(EventIndex::PathFor(inputFile, boardMid));
+    if (haveIndex && boardMid >= 0 && index.GetMID() != boardMid) {
+        ELog::Print(ELog::WARNING, "Event index belongs to another board. Ignoring it.");
+        index.Close();
+        haveIndex = false;
+    }
+
     // 트리거 딜레이(DLY) 파싱 및 동적 베이스라인 윈도우(40%) 계산
     double trigger_delay_ns = GetTriggerDelayFromConfig("config/settings.cfg");
     double base_window_ns = trigger_delay_ns * 0.40;
@@ -150,10 +192,16 @@ int main(int argc, char** argv) {
     std::cout << "\n\033[1;36m========================================================\033[0m\n";
     std::cout << "\033[1;32m       NKFADC500 Mini - Offline Production\033[0m\n";
     std::cout << "       [Input File]   " << inputFile << " (" << std::fixed << std::setprecision(2) << totalMB << " MB)\n";
+    if (haveIndex) std::cout << "       [Event Index]  " << EventIndex::PathFor(inputFile, boardMid) << " (" << index.Size() << " events)\n";
+    if (rangeFirst > 0 || rangeLast >= 0) {
+        std::cout << "       [Event Range]  " << rangeFirst << " ~ " << (rangeLast >= 0 ? std::to_string(rangeLast) : std::string("end")) << "\n";
+    }
     if (!interactiveMode) {
         std::string outputFile = inputFile;
         size_t dotPos = outputFile.find_last_of(".");
         if (dotPos != std::string::npos) outputFile = outputFile.substr(0, dotPos);
+        if (boardMid >= 0) outputFile += Form("_b%d", boardMid);
+        if (rangeFirst > 0 || rangeLast >= 0) outputFile += Form("_e%lld-%lld", rangeFirst, rangeLast);
         outputFile += "_prod.root";
         std::cout << "       [Output File]  " << outputFile << "\n";
     }
@@ -165,6 +213,8 @@ int main(int argc, char** argv) {
         std::string outputFile = inputFile;
         size_t dotPos = outputFile.find_last_of(".");
         if (dotPos != std::string::npos) outputFile = outputFile.substr(0, dotPos);
+        if (boardMid >= 0) outputFile += Form("_b%d", boardMid);
+        if (rangeFirst > 0 || rangeLast >= 0) outputFile += Form("_e%lld-%lld", rangeFirst, rangeLast);
         outputFile += "_prod.root";
 
         TFile* rootFile = new TFile(outputFile.c_str(), "RECREATE");
@@ -198,26 +248,52 @@ int main(int argc, char** argv) {
         auto start_time = std::chrono::steady_clock::now();
         auto ui_timer = start_time;
 
+        // 💡 [상태 페이지] GUI 진행률: 바이트 기준 (이벤트 범위 모드는 이벤트 기준)
+        StatusPage status;
+        status.Create(StatusPage::kProduction);
+        StatusPageHeader* st = status.Header();
+        st->progressTotal.store(rangeLast >= 0 ? (uint64_t)(rangeLast - rangeFirst + 1) : (uint64_t)totalBytes, std::memory_order_relaxed);
+        status.SetState(StatusPage::kRunning);
+
         std::cout << "\033[1;36m[  Production Real-time Monitor  ]\033[0m\n";
 
-        while (fread(header, 1, 128, fp) == 128) {
-            currentBytes += 128;
+        // 💡 [-r] 시작 이벤트로 이동: 인덱스가 있으면 Seek 한 번, 없으면 헤더를 따라 순차 건너뜀
+        if (rangeFirst > 0) {
+            const DataFormat::IndexEntry* entry = haveIndex ? index.FindEvent(rangeFirst) : nullptr;
+            if (entry && reader.Seek(entry->offset, entry->blockSkip)) {
+                eventID = (unsigned int)rangeFirst;
+            } else {
+                if (haveIndex) ELog::Print(ELog::WARNING, Form("Event %lld is not in the index. Scanning sequentially.", rangeFirst));
+                while (eventID < rangeFirst && reader.Read(header, 128)) {
+                    uint64_t eventBytes = EventFramer::EventBytes(header);
+                    if (eventBytes == 0 || !reader.Skip(eventBytes - 128)) break;
+                    eventID++;
+                }
+            }
+        }
+
+        while ((rangeLast < 0 || eventID <= rangeLast) && reader.Read(header, 128)) {
             unsigned int data_length = header[0] + (header[4] << 8) + (header[8] << 16) + (header[12] << 24);
             
+            // 보드별 파일 끝의 live time / 설정 변경 레코드: 이벤트 스트림의 정상 종료
+            if (DataFormat::IsAuxRecord(header)) {
+                reader.ReadTrailer(header);
+                break;
+            }
             if (data_length <= 32 || data_length > 100000000) {
                  ELog::Print(ELog::WARNING, Form("Corrupted header detected (Length: %u). Aborting loop securely.", data_length));
                  break;
             }
 
             runNumber = header[16] + (header[20] << 8);
-            triggerTime = header[44] * 8 + header[48] * 1000 + (header[52] << 8) * 1000 + (header[56] << 16) * 1000;  
+            triggerTime = EventFramer::TriggerTime(header);
 
             recordLength = (data_length - 32) / 2;
             int payload_bytes = recordLength * 8; 
 
             std::vector<unsigned char> payload(payload_bytes);
-            if (fread(payload.data(), 1, payload_bytes, fp) != (size_t)payload_bytes) break; 
-            currentBytes += payload_bytes;
+            if (!reader.Read(payload.data(), payload_bytes)) break; 
+            currentBytes = ftell(fp);
 
             for(int i=0; i<4; i++) {
                 baseline[i] = 0; amplitude[i] = -9999; charge[i] = 0; peakTime[i] = 0;
@@ -267,11 +343,17 @@ int main(int argc, char** argv) {
 
             tree->Fill();
             eventID++;
+
+            st->events.store(eventID, std::memory_order_relaxed);
+            st->bytes.store(currentBytes, std::memory_order_relaxed);
+            st->progressDone.store(rangeLast >= 0 ? (uint64_t)(eventID - rangeFirst) : (uint64_t)currentBytes, std::memory_order_relaxed);
             
             auto now = std::chrono::steady_clock::now();
             if (std::chrono::duration<double>(now - ui_timer).count() >= 0.5) {
+                status.Heartbeat();
                 double total_elapsed = std::chrono::duration<double>(now - start_time).count();
                 double progress = (currentBytes / (double)totalBytes) * 100.0;
+                if (rangeLast >= 0) progress = (eventID - rangeFirst) * 100.0 / (rangeLast - rangeFirst + 1);
                 double speed_mbps = (currentBytes / 1048576.0) / total_elapsed;
                 double eta_sec = (speed_mbps > 0) ? (totalMB - (currentBytes / 1048576.0)) / speed_mbps : 0;
 
@@ -292,11 +374,36 @@ int main(int argc, char** argv) {
 
         std::cout << "\n\n\033[1;36m========================================================\033[0m\n";
         std::cout << "\033[1;32m   [ Production Summary ]\033[0m\n";
+        if (reader.IsMerged()) {
+            std::cout << "   Board MID     : " << reader.GetSelectedMID() << " (boards in file:";
+            for (int mid : reader.GetSeenMIDs()) std::cout << " " << mid;
+            std::cout << ")\n";
+        }
         std::cout << "   Total Events  : " << eventID << "\n";
+        std::vector<DataFormat::LiveTimeSample> liveTime = reader.GetLiveTime();
+        if (liveTime.size() >= 2) {
+            double live = DataFormat::LiveFraction(liveTime.front(), liveTime.back());
+            double span = (liveTime.back().timeNs - liveTime.front().timeNs) / 1e9;
+            if (live >= 0) {
+                std::cout << "   Live Time     : " << std::fixed << std::setprecision(2) << live * 100.0 << "% of " << span
+                          << " s (" << liveTime.size() << " board counter samples)\n";
+            } else {
+                std::cout << "   Live Time     : n/a (board counter did not advance)\n";
+            }
+        }
+        // 💡 [라이브 재설정] 수집 중 바뀐 설정: 표시한 이벤트 수까지가 이전 값 (이벤트 번호로 구간을 나눠 분석)
+        for (const DataFormat::ConfigChange& change : reader.GetConfigChanges()) {
+            std::cout << "   Config Change : " << DataFormat::ConfigParamName(change.param);
+            if (change.channel >= 0) std::cout << " ch" << change.channel;
+            std::cout << " " << change.oldValue << " -> " << change.newValue << " after event " << change.events;
+            if (!change.applied) std::cout << " (not applied)";
+            std::cout << "\n";
+        }
         std::cout << "   Time Taken    : " << std::fixed << std::setprecision(2) << final_elapsed << " sec\n";
         std::cout << "\033[1;36m========================================================\033[0m\n";
         
         rootFile->Write(); rootFile->Close(); fclose(fp);
+        status.Close(StatusPage::kFinished);
         return 0;
     }
 
@@ -336,9 +443,10 @@ int main(int argc, char** argv) {
         std::cout << "   -> \033[1;31m[q]\033[0m       : Quit\n";
         std::cout << "\033[1;35m========================================================\033[0m\n\n";
 
-        while (fread(header, 1, 128, fp) == 128) {
+        while (reader.Read(header, 128)) {
             unsigned int data_length = header[0] + (header[4] << 8) + (header[8] << 16) + (header[12] << 24);
             
+            if (DataFormat::IsAuxRecord(header)) break;
             if (data_length <= 32 || data_length > 100000000) {
                  ELog::Print(ELog::WARNING, Form("Corrupted header detected. Aborting."));
                  break;
@@ -348,13 +456,13 @@ int main(int argc, char** argv) {
             int payload_bytes = recordLength * 8; 
 
             if (eventID < targetEventID) {
-                fseek(fp, payload_bytes, SEEK_CUR);
+                if (!reader.Skip(payload_bytes)) break;
                 eventID++;
                 continue;
             }
 
             std::vector<unsigned char> payload(payload_bytes);
-            if (fread(payload.data(), 1, payload_bytes, fp) != (size_t)payload_bytes) break; 
+            if (!reader.Read(payload.data(), payload_bytes)) break; 
 
             std::vector<std::vector<unsigned short>> rawWave(4, std::vector<unsigned short>(recordLength));
 
@@ -437,9 +545,11 @@ int main(int argc, char** argv) {
                 } 
                 else if (input == "p" || input == "P") { 
                     if (eventID > 0) {
-                        rewind(fp); 
-                        eventID = 0;
-                        targetEventID = targetEventID - 1; 
+                        targetEventID = eventID - 1;
+                        if (!SeekToEvent(reader, haveIndex ? &index : nullptr, targetEventID, eventID)) {
+                            reader.Rewind();
+                            eventID = 0;
+                        }
                         requires_rewind = true;
                         break;
                     } else {
@@ -459,8 +569,12 @@ int main(int argc, char** argv) {
                         int jump_idx = std::stoi(destStr);
                         if (jump_idx < 0) {
                             std::cout << "\033[1;31mEvent number cannot be negative.\033[0m\n";
+                        } else if (SeekToEvent(reader, haveIndex ? &index : nullptr, jump_idx, eventID)) {
+                            targetEventID = jump_idx;
+                            requires_rewind = true;
+                            break;
                         } else if (jump_idx <= (int)eventID) {
-                            rewind(fp); 
+                            reader.Rewind(); 
                             eventID = 0;
                             targetEventID = jump_idx;
                             requires_rewind = true;
@@ -0,0 +1,58 @@
+#ifndef ADAPTIVEPOLLER_HH
+#define ADAPTIVEPOLLER_HH
+
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+
+// =========================================================================
+// 💡 [BCOUNT 폴링] 보드 버퍼 채움 속도를 추적하는 적응형 폴링 간격 계산기
+// - 데이터가 들어오면 EWMA 로 채움 속도(KB/s)를 갱신하고, 목표량이 쌓일 예상 시간만큼만 대기
+// - 빈 폴링이 연속되면 min 에서 시작해 2배씩 backoff 하여 idle 시 USB 제어 전송/wakeup 을 줄임
+// - 데이터가 다시 보이면 즉시 min 간격으로 복귀하여 버스트를 놓치지 않음
+// =========================================================================
+class AdaptivePoller {
+public:
+    AdaptivePoller(int minUs = 20, int maxUs = 2000, unsigned int targetKB = 64)
+        : fMinUs(std::max(minUs, 1)), fMaxUs(std::max(maxUs, minUs)), fTargetKB(targetKB),
+          fRateKBps(0.0), fEmptyPolls(0), fHasLast(false) {}
+
+    // BCOUNT > 0 을 관측했을 때 호출
+    void OnData(unsigned int kb) {
+        auto now = std::chrono::steady_clock::now();
+        if (fHasLast) {
+            double dt = std::chrono::duration<double>(now - fLastData).count();
+            if (dt > 0) {
+                double inst = kb / dt;
+                fRateKBps = (fRateKBps > 0) ? (0.8 * fRateKBps + 0.2 * inst) : inst;
+            }
+        }
+        fLastData = now;
+        fHasLast = true;
+        fEmptyPolls = 0;
+    }
+
+    // BCOUNT == 0 일 때 다음 폴링까지 대기할 시간 (us)
+    int NextIdleUs() {
+        double backoffUs = (double)fMinUs * (double)(1u << std::min(fEmptyPolls, 16));
+        double predictUs = (fRateKBps > 0) ? (fTargetKB / fRateKBps) * 1e6 : (double)fMaxUs;
+        fEmptyPolls++;
+
+        double us = std::min(backoffUs, predictUs);
+        return (int)std::max((double)fMinUs, std::min(us, (double)fMaxUs));
+    }
+
+    double GetRateKBps() const { return fRateKBps; }
+
+private:
+    int fMinUs;
+    int fMaxUs;
+    unsigned int fTargetKB;
+
+    double fRateKBps;
+    int fEmptyPolls;
+    bool fHasLast;
+    std::chrono::steady_clock::time_point fLastData;
+};
+
+#endif
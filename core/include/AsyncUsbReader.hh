@@ -0,0 +1,45 @@
+#ifndef ASYNCUSBREADER_HH
+#define ASYNCUSBREADER_HH
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "UsbTransport.hh"
+#include "LatencyHistogram.hh"
+
+// 💡 [USB 파이프라이닝] N개의 bulk IN 전송을 동시에 걸어두고, 완료되는 즉시 다음 청크를 재제출하여
+// FX3 엔드포인트가 청크 사이에서 놀지 않도록 하는 리드아웃 엔진.
+// 각 청크는 호출자가 넘긴 최종 목적지(RawBuffer::data)의 해당 오프셋으로 직접 수신됩니다.
+class AsyncUsbReader {
+public:
+    AsyncUsbReader(UsbTransport* transport, int depth, size_t chunkBytes);
+    ~AsyncUsbReader();
+
+    // addr 영역에서 bytes 만큼 읽어 dest 에 채움. 성공 시 0, 실패 시 <0
+    int Read(unsigned char* dest, size_t bytes, uint32_t addr = 0x40000000);
+
+    int    GetDepth() const      { return (int)fSlots.size(); }
+    size_t GetChunkBytes() const { return fChunkBytes; }
+
+    // 전송 1건당 제출~완료 지연 분포 및 누적 카운터
+    const LatencyHistogram& GetLatency() const { return fLatency; }
+    uint64_t GetTotalBytes() const     { return fTotalBytes; }
+    uint64_t GetTotalTransfers() const { return fTotalTransfers; }
+    uint64_t GetErrorCount() const     { return fErrors; }
+    void     ResetStats();
+
+private:
+    void DrainInFlight(int head, int inFlight);
+
+    UsbTransport* fTransport;
+    size_t fChunkBytes;
+    std::vector<UsbTransfer> fSlots;
+
+    LatencyHistogram fLatency;
+    uint64_t fTotalBytes;
+    uint64_t fTotalTransfers;
+    uint64_t fErrors;
+};
+
+#endif
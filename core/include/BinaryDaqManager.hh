@@ -3,35 +3,193 @@
 
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
 
-#include "Fadc500Device.hh"
+#include "DaqDevice.hh"
 #include "RawBufferPool.hh"
 #include "RunInfo.hh"
+#include "DaqOptions.hh"
+#include "RawWriter.hh"
+#include "BufferArena.hh"
+#include "CompressionPool.hh"
+#include "DataFormat.hh"
+#include "LatencyHistogram.hh"
+#include "LiveRing.hh"
+#include "StatusPage.hh"
+#include "ThreadTuning.hh"
+#include "OverflowSink.hh"
+#include "ThresholdScan.hh"
+
+// 💡 [라이브 재설정] 런 중 설정 변경 요청 1건 (BinaryDaqManager::QueueLiveChange)
+struct LiveChangeRequest {
+    int param;     // DataFormat::ConfigParam
+    int ch;        // 0~3, -1 = 모든 채널 (TRIG_ENABLE 은 항상 -1)
+    int value;
+};
+
+// 💡 [다중 보드] 보드 1대당 독립된 장치/버퍼 풀/Producer-Consumer 스레드 묶음
+struct BoardContext {
+    int mid;
+    DaqDevice* device;         // 실제 보드 또는 시뮬레이터 (DEVICE)
+    BufferQueue* dataQueue;
+    BufferQueue* freeQueue;
+    BufferArena* arena;        // freeQueue 버퍼들의 실제 메모리 (고정 예산)
+    int poolBuffers;
+
+    std::atomic<uint64_t> poolExhausted;   // Free 큐가 비어 Producer 가 반납을 기다린 횟수
+    std::atomic<uint64_t> poolWaitNs;      // 그 대기 시간 합계
+    std::atomic<bool> producerDone;        // Producer 가 마지막 블록까지 DataQ 에 넣고 종료함
+
+    std::thread producer;
+    std::thread consumer;
+    std::string outFileName;   // 보드별 파일 모드에서만 사용 (롤오버 시 현재 서브런 파일)
+    std::string indexFileName; // EVENT_INDEX 사이드카
+    std::atomic<int> subrun;   // 현재 서브런 번호 (롤오버 미사용 시 0)
+    RawWriter* writer;         // 보드별 파일 모드의 디스크 Writer (병합 모드는 fMergedWriter 공유)
+    StatusPageBoard* status;   // 상태 페이지의 이 보드 항목 (Producer/Consumer 가 블록마다 직접 갱신)
+
+    // 스레드 배치 (PRODUCER_CPU/CONSUMER_CPU + 보드 순번, -1: 고정 안 함) 와 스레드 종료 시점의 스케줄링 상태
+    int producerCpu;
+    int consumerCpu;
+    ThreadSchedInfo producerSched;
+    ThreadSchedInfo consumerSched;
+
+    // 블록 압축 (COMPRESSION != 0)
+    BufferQueue* zFreeQueue;               // 압축 결과 버퍼 (Writer 완료 시 반납, 병합 모드는 다른 보드 스레드가 반납할 수 있음)
+    LatencyHistogram compressLatency;      // 블록 1개 필터 + 압축 시간 (Consumer 스레드에서만 기록)
+
+    // 블록 레코드 파일(병합/압축)의 위치 테이블. 보드별 파일은 fileOffset 이 현재 파일의 다음 기록 위치
+    std::vector<DataFormat::BlockTableEntry> blockTable;
+    uint64_t fileOffset;
+
+    std::atomic<uint64_t> writtenBytes;
+    std::atomic<uint64_t> storedBytes;     // 디스크에 기록된 본문 크기 (압축 후, 패딩 제외)
+    std::atomic<uint64_t> events;          // EventFramer 가 센 정확한 이벤트 수
+    std::atomic<uint64_t> framingErrors;   // 헤더 손상으로 동기를 잃은 횟수
+    uint64_t truncatedBytes;               // 런 종료 시 끝이 잘려 버린 마지막 이벤트의 바이트 (Consumer 만 갱신, 요약은 스레드 종료 후)
+    uint64_t blockSeq;
+
+    // 💡 [Live time] Producer 가 BCOUNT 폴링 사이에 읽은 보드 카운터 샘플. Consumer 가 꺼내 스트림에 기록
+    std::mutex liveMutex;
+    std::vector<DataFormat::LiveTimeSample> liveQueue;
+    std::atomic<bool> livePending;
+    uint64_t liveSamples;                  // 아래 두 값은 Producer 만 갱신 (요약은 스레드 종료 후 읽음)
+    DataFormat::LiveTimeSample liveFirst;  // StartDAQ 직후 샘플
+    DataFormat::LiveTimeSample liveLast;   // 마지막 샘플 (StopDAQ 직전)
+
+    // 💡 [라이브 재설정] 요청은 liveMutex 보호 + changeRequested 로 알림. Producer 가 적용한 결과는 changeQueue 로
+    // Consumer 에 넘겨 (livePending) kAuxConfigChange 레코드로 기록
+    std::vector<LiveChangeRequest> changeRequests;
+    std::atomic<bool> changeRequested;
+    std::vector<DataFormat::ConfigChange> changeQueue;
+    std::vector<DataFormat::ConfigChange> changeLog;   // 이번 런에 적용한 변경 (Producer 만 갱신, 요약은 스레드 종료 후)
+
+    // 💡 [백프레셔] BACKPRESSURE 1~3: 풀이 고갈된 구간의 이벤트를 overflow 로 돌림 (Producer 만 갱신, 요약은 스레드 종료 후)
+    OverflowSink* overflow;                // BACKPRESSURE 0 이면 nullptr
+    uint64_t divertEpisodes;               // 정상 기록 -> 전환 횟수
+    uint64_t divertedEvents;               // 전환 구간에서 헤더를 읽은 이벤트
+    uint64_t divertedNs;                   // 전환 상태로 보낸 시간
+    unsigned int peakDramKB;               // 런 중 관측한 최대 BCOUNT (보드 DRAM 사용량)
+
+    BoardContext() : mid(0), device(nullptr), dataQueue(nullptr), freeQueue(nullptr), arena(nullptr), poolBuffers(0),
+                     poolExhausted(0), poolWaitNs(0), producerDone(false), subrun(0), writer(nullptr), status(nullptr), producerCpu(-1), consumerCpu(-1), zFreeQueue(nullptr), fileOffset(0),
+                     writtenBytes(0), storedBytes(0), events(0), framingErrors(0), truncatedBytes(0), blockSeq(0),
+                     livePending(false), liveSamples(0), liveFirst(), liveLast(), changeRequested(false),
+                     overflow(nullptr), divertEpisodes(0), divertedEvents(0), divertedNs(0), peakDramKB(0) {}
+};
 
 class BinaryDaqManager {
 public:
-    BinaryDaqManager(RunInfo* runInfo);
+    BinaryDaqManager(RunInfo* runInfo, const DaqOptions& options = DaqOptions());
     ~BinaryDaqManager();
 
-    // 💡 maxEvents 파라미터 부활
-    void Start(const std::string& outFileName, int maxEvents = 0, int maxTime = 0);
+    // 💡 maxEvents 파라미터 부활. 같은 매니저로 여러 번 Start/Stop 가능 (데몬 모드: 장치는 생성 시 한 번만 초기화)
+    bool Start(const std::string& outFileName, int maxEvents = 0, int maxTime = 0);
     void Stop();
     bool IsRunning() const { return fIsRunning.load(); }
+    bool HasPendingRun() const { return fSummaryPending; }   // 스스로 끝난 (maxEvents/maxTime) 런: Stop 으로 정리 필요
+
+    // 💡 [데몬] 런 사이에 새 설정 적용: 보드 레지스터 재설정 + 런 단위 옵션 교체
+    // 보드 구성(개수/MID) 이 다르면 false. 생성 시 정해지는 옵션(장치, USB 모드, 버퍼 풀, 압축 풀, 코어 배치)은 유지
+    bool Configure(RunInfo* runInfo, const DaqOptions& options);
+
+    // 💡 [라이브 재설정] THR/DLY/PSW/TRIG_ENABLE 변경 (param = DataFormat::ConfigParam, ch = -1: 모든 채널, mid = -1: 모든 보드)
+    // 런 중이면 Producer 가 다음 BCOUNT 폴링 사이에 레지스터를 쓰고 스트림에 kAuxConfigChange 레코드를 남김.
+    // 런이 아니면 바로 보드에 반영. 잘못된 요청이면 false + error
+    bool QueueLiveChange(int mid, int param, int ch, int value, std::string& error);
+
+    // 💡 [문턱값 스캔] 런 사이에만: 보드마다 (동시에) 채널별 THR first~last 대 트리거율 측정, 파일 기록 없음.
+    // 끝나면 원래 THR 로 복구. 런 중이거나 장치가 THR 변경을 지원하지 않으면 false (AbortScan 으로 중단해도 false)
+    bool ScanThresholds(int first, int last, int step, std::vector<ThresholdScanResult>& results);
+    void AbortScan() { fScanAbort = true; }
+
+    // 💡 [DACOFF 보정] 런 사이에만: 보드마다 (동시에) 채널별 pedestal 이 targetAdc 가 되는 DACOFF 탐색 (DACOFF_CAL_*).
+    // 결과는 RunInfo 의 보드 설정에 반영되어 다음 런부터 사용. 런 중이거나 장치가 지원하지 않으면 false
+    bool CalibrateDacOffsets(int targetAdc, std::vector<DacCalibration>& results);
+
+    uint64_t GetEvents() const;
+    uint64_t GetBytes() const;
+    const std::string& GetOutFileName() const { return fOutFileName; }
+    const DaqOptions& GetOptions() const { return fOptions; }
 
 private:
-    void ProducerWorker(int maxTime);
-    void ConsumerWorker(const std::string& outFileName, int maxEvents); // 💡 인자 추가
+    void ProducerWorker(BoardContext* bd, int maxTime);
+    void ConsumerWorker(BoardContext* bd, int maxEvents); // 💡 인자 추가
+    void StatusWorker();
+    void PublishStatus();
+    void ApplyLiveChanges(BoardContext* bd, unsigned int dramKB, uint64_t streamBytes, bool inRun);
+    void PlaceThread(const std::string& name, int cpu, int priority);
+    void ResetRunState();
+    void PrintRunSummary();
+    void PrintWriterSummary(const RawWriter* writer, int mid);
+    void WriteBlockTable(RawWriter* writer, uint64_t offset, const std::vector<DataFormat::BlockTableEntry>& table);
+    std::string BoardOutputPath(const BoardContext* bd, int subrun) const;
 
     RunInfo* fRunInfo;
-    Fadc500Device* fDevice;
+    DaqOptions fOptions;
+    std::vector<BoardContext*> fBoards;
 
     std::atomic<bool> fIsRunning;
-    std::thread fProducerThread;
-    std::thread fConsumerThread;
+    std::atomic<int>  fActiveConsumers;
+    std::thread fStatusThread;
+    std::mutex  fStatusMutex;
+    std::condition_variable fStatusCv;
+
+    // 병합(merged) 출력 모드: 모든 보드가 하나의 파일을 공유하며 블록 단위로 MID 태그를 붙여 기록
+    RawWriter* fMergedWriter;
+    std::mutex fMergedMutex;
+    uint64_t fMergedOffset;      // 병합 파일에 다음 기록될 위치 (fMergedMutex 보호, 인덱스 엔트리용)
+    std::string fOutFileName;
+
+    // 서브런 롤오버 (ROLLOVER_MB / ROLLOVER_SEC, 보드별 파일 모드에서만)
+    bool fRollover;
+    int  fMaxTime;
+
+    // 블록 압축 워커 풀 (모든 보드 공유, COMPRESSION == 0 이거나 코덱 미지원이면 nullptr)
+    CompressionPool* fCompressPool;
+    int fCodec;
+
+    // 온라인 모니터용 공유 메모리 이벤트 링 (LIVE_RING_MB == 0 이거나 생성 실패 시 열리지 않음)
+    LiveRingWriter fLiveRing;
+
+    // GUI/스크립트용 공유 메모리 상태 페이지 (/dev/shm/nkfadc500_status_<pid>)
+    StatusPage fStatus;
+
+    // Producer/Consumer 전용 코어 (CPU 0..63 비트마스크). 나머지 스레드와 다른 프로세스는 이 코어들을 피함
+    uint64_t fDaqCpuMask;
+    std::atomic<bool> fRtWarned;
+
+    std::atomic<bool> fScanAbort;
 
-    RawBufferPool fDataQueue; 
-    RawBufferPool fFreeQueue; 
+    std::chrono::system_clock::time_point fSysStartTime;
+    std::chrono::steady_clock::time_point fPerfStartTime;
+    bool fSummaryPending;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,43 @@
+#ifndef BLOCKCODEC_HH
+#define BLOCKCODEC_HH
+
+#include <cstdint>
+#include <cstddef>
+
+// =========================================================================
+// 💡 [블록 압축] 원시 USB 블록용 압축 코덱 래퍼 (LZ4 / zstd)
+// - 빌드 시 라이브러리가 발견된 코덱만 사용 가능 (NKFADC_HAVE_LZ4 / NKFADC_HAVE_ZSTD)
+// - Delta8 필터: 샘플 1개 = 8 바이트 (4채널 x 하위/상위 바이트) 이므로 8 바이트 전 값과의 차이로 바꾸면
+//   평탄한 베이스라인 구간이 거의 0 이 되어 압축률이 크게 오름 (제자리 변환, 역변환 가능)
+// =========================================================================
+namespace BlockCodec {
+
+enum Codec {
+    kNone = 0,   // 무압축 (압축이 이득이 없는 블록은 필터만 적용하여 그대로 저장)
+    kLz4  = 1,
+    kZstd = 2
+};
+
+enum Filter {
+    kFilterNone   = 0,
+    kFilterDelta8 = 1
+};
+
+bool        Available(int codec);
+const char* Name(int codec);
+
+// 최악의 경우 압축 결과 크기
+size_t Bound(int codec, size_t rawBytes);
+
+// 성공 시 압축된 크기, 실패(또는 dst 부족) 시 0
+size_t Compress(int codec, int level, const unsigned char* src, size_t n, unsigned char* dst, size_t cap);
+
+// dst 에 정확히 rawBytes 가 복원되면 true
+bool Decompress(int codec, const unsigned char* src, size_t n, unsigned char* dst, size_t rawBytes);
+
+void Delta8Encode(unsigned char* buf, size_t n);
+void Delta8Decode(unsigned char* buf, size_t n);
+
+} // namespace BlockCodec
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef BUFFERARENA_HH
+#define BUFFERARENA_HH
+
+#include <cstddef>
+
+#include "RawBufferPool.hh"
+
+// =========================================================================
+// 💡 [메모리] RawBuffer 풀 전체를 받치는 단일 연속 메모리 영역
+// - 2MB Huge Page 우선 (MAP_HUGETLB -> 실패 시 Transparent Huge Page madvise -> 일반 4KB 페이지)
+// - 시작 시 mlock + 모든 페이지 선(先)접근(pre-fault) 하여 런 초반 첫 접근 page fault / TLB miss 제거
+// - 고정 예산: 런 도중 추가 할당/재할당 없음 (풀이 바닥나면 Producer 가 반납을 기다림)
+// =========================================================================
+class BufferArena {
+public:
+    enum PageMode {
+        kPageNormal  = 0,   // 4KB 페이지
+        kPageTHP     = 1,   // Transparent Huge Page (madvise)
+        kPageHugeTLB = 2    // hugetlbfs 예약 페이지 (MAP_HUGETLB)
+    };
+
+    BufferArena(size_t totalBytes, bool tryHugePages = true, bool lockMemory = true);
+    ~BufferArena();
+
+    bool IsValid() const { return fBase != nullptr; }
+
+    // 영역을 bufferBytes 크기 조각으로 나누어 비소유(non-owning) RawBuffer 로 queue 에 넣음. 넣은 개수 반환
+    int Populate(BufferQueue* queue, size_t bufferBytes);
+
+    size_t      GetSize() const     { return fSize; }
+    PageMode    GetPageMode() const { return fPageMode; }
+    bool        IsLocked() const    { return fLocked; }
+    double      GetPrefaultMs() const { return fPrefaultMs; }
+    const char* GetPageModeName() const;
+
+private:
+    unsigned char* fBase;
+    size_t   fSize;
+    PageMode fPageMode;
+    bool     fLocked;
+    double   fPrefaultMs;
+};
+
+#endif
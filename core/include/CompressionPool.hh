@@ -0,0 +1,57 @@
+#ifndef COMPRESSIONPOOL_HH
+#define COMPRESSIONPOOL_HH
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <cstdint>
+
+#include "RawBufferPool.hh"
+
+// 압축 작업 1건: raw 블록 -> out 버퍼 (Consumer 가 제출 순서대로 회수하여 기록)
+struct CompressionJob {
+    RawBuffer* raw = nullptr;
+    RawBuffer* out = nullptr;   // 용량 >= BlockCodec::Bound(codec, raw->size)
+    int codec = 0;
+    int level = 1;
+    int filter = 0;
+
+    // 결과 (done 이후 유효)
+    int      usedCodec = 0;     // 압축 이득이 없으면 BlockCodec::kNone (raw 를 필터만 적용한 채 기록)
+    uint32_t rawBytes = 0;
+    uint32_t compBytes = 0;
+    uint64_t latencyNs = 0;     // 필터 + 압축 소요 시간
+    bool     done = false;
+};
+
+// =========================================================================
+// 💡 [압축 워커 풀] 모든 보드가 공유하는 N 개의 압축 스레드
+// - Consumer 는 블록을 제출만 하고 다음 블록을 계속 받으며, 완료된 작업을 제출 순서대로 기록
+// - 블록 하나는 한 스레드가 처리하므로 코어 수만큼 처리량이 늘어남
+// =========================================================================
+class CompressionPool {
+public:
+    explicit CompressionPool(int threads);
+    ~CompressionPool();
+
+    void Submit(CompressionJob* job);
+    bool IsDone(const CompressionJob* job);
+    void Wait(const CompressionJob* job);
+
+    int GetThreads() const { return (int)fThreads.size(); }
+
+private:
+    void Worker();
+    static void Run(CompressionJob* job);
+
+    std::vector<std::thread> fThreads;
+    std::deque<CompressionJob*> fJobs;
+    std::mutex fMutex;
+    std::condition_variable fJobCv;
+    std::condition_variable fDoneCv;
+    bool fStop;
+};
+
+#endif
@@ -3,10 +3,12 @@
 
 #include <string>
 #include "RunInfo.hh"
+#include "DaqOptions.hh"
 
 class ConfigParser {
 public:
-    static bool Parse(const std::string& filename, RunInfo* runInfo);
+    // options 가 주어지면 DAQ 파이프라인 글로벌 키(USB_* 등)도 함께 파싱
+    static bool Parse(const std::string& filename, RunInfo* runInfo, DaqOptions* options = nullptr);
 };
 
 #endif
@@ -0,0 +1,71 @@
+#ifndef DAQDEVICE_HH
+#define DAQDEVICE_HH
+
+#include <cstdint>
+
+#include "FadcBD.hh"
+#include "DaqOptions.hh"
+
+class AsyncUsbReader;
+
+// 보드 하드웨어 카운터 (StartDAQ 이후 누적)
+struct DeviceCounters {
+    uint64_t liveTicks;      // live time (DaqOptions::liveTimeTickNs 단위)
+    uint32_t triggers[4];    // 채널별 트리거 카운터
+};
+
+// DACOFF 보정 결과 (DaqDevice::CalibrateDacOffset)
+struct DacCalibration {
+    int  mid;
+    int  dacoff[4];          // 찾은 DACOFF
+    int  pedestal[4];        // 그 값에서 측정한 pedestal (ADC)
+    bool converged[4];       // false: 목표가 DACOFF 0~4095 로 닿는 범위 밖 (가장 가까운 끝값) 이거나 탐색을 마치지 못함
+    int  rounds;             // pedestal 측정 횟수 (1회 = 4채널 동시)
+    double ms;
+};
+
+// =========================================================================
+// 💡 [장치 인터페이스] BinaryDaqManager 가 보드 1대와 주고받는 연산 (BCOUNT 폴링 + 블록 리드아웃)
+// - Fadc500Device    : 실제 FADC500 Mini (USB3)
+// - SimFadc500Device : 하드웨어 없이 같은 형식의 데이터 스트림을 만드는 시뮬레이터 (DEVICE 1)
+// =========================================================================
+class DaqDevice {
+public:
+    virtual ~DaqDevice() {}
+
+    // DaqOptions::device 에 따라 실제 보드 또는 시뮬레이터 생성
+    static DaqDevice* Create(int mid, const DaqOptions& options);
+
+    virtual const char* GetName() const = 0;
+
+    virtual void Initialize(FadcBD* bdConfig) = 0;
+    virtual void StartDAQ() = 0;
+    virtual void StopDAQ() = 0;
+
+    // 하위 16 비트: 보드 DRAM 에 쌓인 데이터 (KB), 0xFFFFFFFF: 통신 오류
+    virtual unsigned int ReadBCOUNT() = 0;
+    virtual void ReadDATA(unsigned int bcount_kb, unsigned char* dest) = 0;
+
+    // live time / 트리거 카운터 (레지스터 읽기 몇 번, BCOUNT 폴링 사이에 호출). 지원하지 않는 장치는 false
+    virtual bool ReadCounters(DeviceCounters& counters) { (void)counters; return false; }
+
+    // 💡 [라이브 재설정] 런 중 설정 1건 (DataFormat::ConfigParam, ch = -1: 보드 전체) 을 보드에 반영.
+    // bdConfig 는 이미 새 값으로 갱신된 상태. Producer 스레드가 BCOUNT 폴링 사이에 호출. 지원하지 않으면 false
+    virtual bool ApplyLiveChange(FadcBD* bdConfig, int param, int ch) { (void)bdConfig; (void)param; (void)ch; return false; }
+
+    // 💡 [DACOFF 보정] 채널마다 pedestal 이 targetAdc (±tolerance) 가 되는 DACOFF 를 이분 탐색. 4채널을 한 번에 쓰고 측정하므로
+    // 전체 측정 횟수는 채널 수와 무관 (양 끝 2회 + 최대 12회 + 확인 1회). 끝나면 bdConfig 와 보드 모두 찾은 값
+    // (보드 내부 pedestal 도 그 값으로 측정된 상태). 런 사이에만 호출. MeasurePedestals 를 지원하지 않는 장치는 false
+    bool CalibrateDacOffset(FadcBD* bdConfig, int targetAdc, int tolerance, DacCalibration& result);
+
+    // 리드아웃 모드 (해당 없는 장치는 무시)
+    virtual void EnableAsyncReadout(int depth, int chunkKB) { (void)depth; (void)chunkKB; }
+    virtual void EnableDirectReadout(int chunkKB) { (void)chunkKB; }
+    virtual const AsyncUsbReader* GetAsyncReader() const { return nullptr; }
+
+protected:
+    // bdConfig 의 DACOFF 를 보드에 쓰고 안정화를 기다린 뒤 채널별 pedestal (ADC) 측정. 지원하지 않으면 false
+    virtual bool MeasurePedestals(FadcBD* bdConfig, int pedestal[4]) { (void)bdConfig; (void)pedestal; return false; }
+};
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef DAQOPTIONS_HH
+#define DAQOPTIONS_HH
+
+#include <string>
+
+// 💡 보드 레지스터 설정(FadcBD)과 분리된 DAQ 파이프라인 튜닝 파라미터
+// settings.cfg 의 글로벌 키 또는 frontend 명령줄 옵션으로 지정합니다.
+struct DaqOptions {
+    enum UsbReadMode {
+        kUsbVendor = 0,   // 제조사 NKFADC500read_DATA (16KB 동기 전송)
+        kUsbAsync  = 1,   // libusb 비동기 API 기반 다중 in-flight 전송
+        kUsbDirect = 2    // libusb 동기 전송, RawBuffer 로 직접 수신 (Zero-Copy)
+    };
+
+    enum QueueType {
+        kQueueMutex = 0,  // RawBufferPool (std::queue + mutex/condvar)
+        kQueueSpsc  = 1   // SpscBufferQueue (lock-free 링 + eventfd)
+    };
+
+    enum DeviceType {
+        kDeviceHardware = 0,  // FADC500 Mini (USB3)
+        kDeviceSim      = 1   // SimFadc500Device: 하드웨어 없이 같은 형식의 스트림 생성
+    };
+
+    // [장치]
+    int device = kDeviceHardware;     // DEVICE
+
+    // [시뮬레이터] DEVICE 1 일 때만 사용. 레코드 길이/샘플링/DLY/THR/POL/DACOFF 는 BOARD 블록 값을 따름
+    int simTriggerHz    = 1000;       // SIM_TRIGGER_HZ     : 평균 트리거율 (Poisson, THR 미만 펄스는 버려짐)
+    int simPulseAdc     = 400;        // SIM_PULSE_ADC      : 평균 펄스 높이 (ADC, 분포 폭 25%)
+    int simRiseNs       = 6;          // SIM_RISE_NS        : 펄스 상승 시정수
+    int simDecayNs      = 40;         // SIM_DECAY_NS       : 펄스 감쇠 시정수
+    int simNoiseAdc     = 3;          // SIM_NOISE_ADC      : 가우시안 잡음 RMS (ADC)
+    int simUsbLatencyUs = 100;        // SIM_USB_LATENCY_US : USB 전송 1회 고정 지연 (BCOUNT 는 절반)
+    int simUsbJitterUs  = 30;         // SIM_USB_JITTER_US  : 지수 분포 추가 지연의 평균
+    int simUsbMBps      = 350;        // SIM_USB_MBPS       : ReadDATA 대역폭 (MB/s), 0: 무제한
+    int simDramMB       = 512;        // SIM_DRAM_MB        : 보드 DRAM (가득 차면 트리거 손실)
+
+    // [USB 리드아웃]
+    int usbReadMode   = kUsbVendor;   // USB_READ_MODE
+    int usbAsyncDepth = 8;            // USB_ASYNC_DEPTH : 동시에 걸어둘 bulk transfer 개수
+    int usbChunkKB    = 256;          // USB_CHUNK_KB    : transfer 1개당 크기 (KB, Direct 모드는 블록 전체까지 허용)
+
+    // [레지스터 설정] 보드 설정 레지스터는 섀도 캐시와 비교해 바뀐 것만 보냄
+    int regBatch      = 0;            // REG_BATCH : bulk OUT 전송 1번에 묶는 쓰기 명령 수, 0: 벤더 USB3Write (명령마다 ~1 ms 대기, 기본)
+
+    // [ADC/DRAM 정렬 캐시] 보드(MID) x SAMPLING_RATE 별 정렬 결과를 저장해 두고 다음 시작 때 확인 후 재사용
+    int alignCache    = 1;            // ALIGN_CACHE     : 1: 캐시 사용 (확인 실패 시 전체 정렬), 2: 강제 전체 정렬 후 갱신, 0: 매번 벤더 정렬
+    std::string alignCacheDir;        // ALIGN_CACHE_DIR : 비어 있으면 $HOME/.cache/nkfadc500
+
+    // [Producer/Consumer 큐]
+    int queueType     = kQueueMutex;  // QUEUE_TYPE
+    int queueWakeup   = 1;            // QUEUE_WAKEUP : SPSC 큐 대기 방식 (1: eventfd, 0: spin)
+
+    enum WriterBackend {
+        kWriterStdio  = 0,  // fwrite + 16MB setvbuf (페이지 캐시 경유)
+        kWriterDirect = 1,  // O_DIRECT pwrite (페이지 캐시 우회)
+        kWriterUring  = 2   // O_DIRECT + io_uring 비동기 기록 (미지원 커널은 Direct 로 강등)
+    };
+
+    // [Writer 백엔드]
+    int writerBackend    = kWriterStdio;  // WRITER_BACKEND
+    int writerQueueDepth = 8;             // WRITER_QUEUE_DEPTH : io_uring 동시 기록 블록 수
+
+    // [버퍼 풀] 보드마다 고정 예산의 단일 Arena (Huge Page + mlock + pre-fault) 에서 4MB 버퍼를 잘라 사용
+    int bufferPoolMB    = 256;        // BUFFER_POOL_MB   : 보드당 버퍼 풀 예산 (MB)
+    int bufferHugePages = 1;          // BUFFER_HUGEPAGES : 1: 2MB Huge Page 시도, 0: 일반 페이지
+    int bufferMlock     = 1;          // BUFFER_MLOCK     : 1: mlock 으로 스왑 방지
+
+    // [블록 압축] Consumer 와 Writer 사이에서 블록을 워커 풀로 압축 (BlockCodec::Codec 값)
+    int compression        = 0;       // COMPRESSION         : 0: 무압축, 1: LZ4, 2: zstd
+    int compressionLevel   = 1;       // COMPRESSION_LEVEL   : zstd 레벨 / LZ4 acceleration
+    int compressionThreads = 4;       // COMPRESSION_THREADS : 모든 보드가 공유하는 압축 스레드 수
+    int compressionFilter  = 1;       // COMPRESSION_FILTER  : 1: Delta8 (샘플 간 차분), 0: 없음
+
+    // [이벤트 인덱스]
+    int eventIndex      = 1;          // EVENT_INDEX : 1: .dat 옆에 .idx 사이드카 기록 (이벤트 위치/번호/트리거 시각)
+
+    // [서브런 롤오버] 한 세션 안에서 크기/시간 한도마다 새 파일로 전환 (장치 재초기화 없음, 이벤트 경계에서 분할)
+    // 활성화 시 출력 파일명은 run.dat -> run_001.dat, run_002.dat ... (보드별/병합 규칙은 그 위에 적용)
+    int rolloverMB    = 0;            // ROLLOVER_MB  : 파일당 최대 크기 (MB), 0: 사용 안 함
+    int rolloverSec   = 0;            // ROLLOVER_SEC : 파일당 최대 시간 (초, 런 시작 기준 배수), 0: 사용 안 함
+
+    // [라이브 이벤트 링] 온라인 모니터가 .dat 파일 대신 읽는 공유 메모리 링 (/dev/shm/nkfadc500_live)
+    int liveRingMB     = 16;          // LIVE_RING_MB      : 링 전체 크기 (MB), 0: 사용 안 함
+    int liveRingSlotKB = 256;         // LIVE_RING_SLOT_KB : 블록당 게시하는 최대 크기 (KB, 완결된 이벤트 단위)
+
+    // [파형 퍼블리셔] GUI Online Monitor 탭 (ZmqWorker) 으로 최신 파형을 ZeroMQ 로 전송 (라이브 링에서 읽음)
+    int zmqPort  = 5555;              // ZMQ_PORT   : tcp://127.0.0.1:<port>, 0: 사용 안 함
+    int zmqMaxHz = 20;                // ZMQ_MAX_HZ : 초당 최대 파형 프레임 수 (채널 4개 = 1 프레임)
+
+    // [다중 보드 출력]
+    int outputMerge   = 0;            // OUTPUT_MERGE : 0: 보드별 파일 (run_b<MID>.dat), 1: MID 태그 병합 스트림 1개
+
+    // [스레드 배치] 보드 i 의 Producer/Consumer 를 <CPU>+i 번 코어에 고정하고, 나머지 스레드(압축, 상태, 퍼블리셔)와
+    // 같은 머신의 GUI/모니터/production 은 그 코어들을 피함 (상태 페이지로 알림)
+    int producerCpu = -1;             // PRODUCER_CPU : 보드 0 Producer 코어, -1: 고정 안 함
+    int consumerCpu = -1;             // CONSUMER_CPU : 보드 0 Consumer 코어, -1: 고정 안 함
+    int rtPriority  = 0;              // RT_PRIORITY  : Producer SCHED_FIFO 우선순위 (1-99, Consumer 는 한 단계 아래), 0: 일반
+
+    // [Live time] Producer 가 BCOUNT 폴링 사이에 보드 live time / 트리거 카운터를 읽어 출력 스트림에 kAuxLiveTime 레코드로 기록
+    int liveTimeSampleMs = -1;        // LIVETIME_SAMPLE_MS : 샘플 간격 (ms), 0: 사용 안 함, -1: DEVICE 0 은 0 / 시뮬레이터는 1000
+                                      //   (벤더 read_LIVETIME 은 read_PSCALE/read_DSR 와 같은 레지스터를 읽음. 보드에서 미검증)
+    int liveTimeTickNs   = 8;         // LIVETIME_TICK_NS   : 보드 live time 카운터 1 단위 (ns, 125 MHz 시스템 클럭)
+
+    // [문턱값 스캔] frontend -T: 장치를 켜 둔 채 채널마다 THR 을 바꿔 가며 보드 카운터로 트리거율 측정 (원시 데이터 기록 없음)
+    int scanWindowMs    = 20;         // SCAN_WINDOW_MS : 단계당 측정 시간 (ms)
+    double scanTargetHz = 0;          // SCAN_TARGET_HZ : 채널마다 트리거율이 이 값 이하가 되는 가장 낮은 THR 을 제안, 0: 사용 안 함
+
+    // [DACOFF 보정] frontend -B <ADC>: 보드 pedestal 측정으로 채널별 DACOFF 이분 탐색 (4채널 동시) -> dacoff_cal_<RUN>.txt
+    int dacCalTolerance = 2;          // DACOFF_CAL_TOLERANCE : 목표 pedestal 허용 오차 (ADC)
+    int dacCalSettleMs  = 1000;       // DACOFF_CAL_SETTLE_MS : DACOFF 를 쓴 뒤 pedestal 측정까지 대기 (ms, 벤더 NKFADC500write_DACOFF 의 sleep(1) 과 같음). 초기화 시 measure_PED 에도 적용
+
+    enum BackpressurePolicy {
+        kBackpressureBlock    = 0,  // 빈 버퍼를 기다림 (메모리 고정, 그동안 보드 DRAM 이 흡수하고 넘치면 트리거 손실)
+        kBackpressureDrop     = 1,  // 보드에서 읽은 이벤트를 버리고 개수만 집계
+        kBackpressureSpill    = 2,  // SPILL_DIR (보조 고속 디스크) 의 <run>_spill.dat 에 기록
+        kBackpressureFeatures = 3   // 파형 대신 이벤트당 특징량만 <run>.feat 에 기록
+    };
+
+    // [백프레셔] 버퍼 풀이 모두 Consumer/Writer 에 잡혀 있을 때 (디스크가 못 따라감) Producer 의 처리 방식
+    // 1~3 은 이벤트 경계에서 전환하고, 풀의 RESUME_PCT 이상이 다시 비면 정상 기록으로 복귀. 모든 결정은 런 요약에 집계
+    int backpressure          = kBackpressureBlock; // BACKPRESSURE
+    int backpressureResumePct = 25;                 // BACKPRESSURE_RESUME_PCT : 복귀 기준 (풀 대비 빈 버퍼 %)
+    std::string spillDir;                           // SPILL_DIR               : BACKPRESSURE 2 의 기록 위치 (비어 있으면 1 로 동작)
+    int featurePedSamples     = 16;                 // FEATURE_PED_SAMPLES     : BACKPRESSURE 3 baseline 샘플 수
+
+    // [BCOUNT 폴링] 관측된 채움 속도에 따라 min ~ max 사이에서 자동 조절
+    int bcountPollMinUs = 20;         // BCOUNT_POLL_MIN_US
+    int bcountPollMaxUs = 2000;       // BCOUNT_POLL_MAX_US : idle 시 최대 폴링 간격
+};
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef DATAFORMAT_HH
+#define DATAFORMAT_HH
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+// =========================================================================
+// 💡 [데이터 포맷] FADC500 이벤트 스트림 사이에 끼워 넣는 128 바이트 보조(Aux) 레코드
+// - 이벤트 헤더와 동일한 128 바이트 크기, bytes 0~15 = 0 (data_length == 0)
+//   => 기존 리더는 'data_length <= 32' 검사에서 안전하게 멈추고, 신규 리더(RawStreamReader)는 건너뜀
+// - bytes 16~19 의 매직 "NKAX" 로 실제 이벤트 헤더와 구분
+// - 레코드 뒤에 prePadBytes 만큼의 0 패딩, payloadBytes 만큼의 본문, padBytes 만큼의 0 패딩 순으로 따라옴
+// - 블록 레코드(태그/압축 블록)로 기록된 파일은 끝에 블록 위치 테이블 + Footer 레코드가 붙음
+//   (O_DIRECT Writer 사용 시 레코드와 본문을 각각 4KB 경계에 맞추기 위한 패딩)
+// =========================================================================
+namespace DataFormat {
+
+static const size_t   kEventHeaderBytes = 128;
+static const size_t   kAuxRecordBytes   = 128;
+static const uint32_t kAuxMagic         = 0x58414B4E;   // "NKAX" (little-endian)
+
+enum AuxType {
+    kAuxBlockTag    = 1,   // 본문 = 보드(mid)에서 읽은 원시 블록. 병합 스트림에서 보드별 스트림을 복원하는 데 사용
+    kAuxZBlock      = 2,   // 본문 = 압축된 원시 블록 (codec/filter/rawBytes 로 복원)
+    kAuxBlockTable  = 3,   // 본문 = BlockTableEntry 배열 (파일 끝, 블록 레코드 위치 목록)
+    kAuxTableFooter = 4,   // 파일 마지막 레코드. seq = kAuxBlockTable 레코드의 파일 오프셋
+    kAuxLiveTime    = 5,   // 본문 없음. reserved 영역 = LiveTimeSample (보드 live time / 트리거 카운터 샘플)
+    kAuxConfigChange = 6   // 본문 없음. reserved 영역 = ConfigChange (런 중 바꾼 보드 설정 1건)
+};
+
+// kAuxConfigChange 의 설정 항목 (settings.cfg 키와 같은 이름)
+enum ConfigParam {
+    kCfgTHR    = 1,
+    kCfgDLY    = 2,
+    kCfgPSW    = 3,
+    kCfgTRIGEN = 4    // TRIG_ENABLE (보드 전체, channel = -1)
+};
+
+inline const char* ConfigParamName(int param) {
+    switch (param) {
+        case kCfgTHR:    return "THR";
+        case kCfgDLY:    return "DLY";
+        case kCfgPSW:    return "PSW";
+        case kCfgTRIGEN: return "TRIG_ENABLE";
+        default:         return "?";
+    }
+}
+
+inline int ConfigParamFromName(const std::string& name) {
+    for (int param = kCfgTHR; param <= kCfgTRIGEN; param++) {
+        if (name == ConfigParamName(param)) return param;
+    }
+    return 0;
+}
+
+#pragma pack(push, 1)
+struct AuxRecord {
+    uint32_t zero[4];        //  0 : 항상 0 (이벤트 헤더의 data_length 자리)
+    uint32_t magic;          // 16 : kAuxMagic
+    uint16_t type;           // 20 : AuxType
+    uint16_t mid;            // 22 : 보드 MID
+    uint32_t payloadBytes;   // 24 : 뒤따르는 본문 크기
+    uint32_t padBytes;       // 28 : 본문 뒤 0 패딩 크기
+    uint64_t seq;            // 32 : 보드별 레코드 일련번호
+    uint64_t timeNs;         // 40 : 기록 시각 (steady_clock ns)
+    uint32_t prePadBytes;    // 48 : 레코드와 본문 사이 0 패딩 크기
+    uint32_t rawBytes;       // 52 : kAuxZBlock 복원 후 크기
+    uint8_t  codec;          // 56 : kAuxZBlock 코덱 (BlockCodec::Codec)
+    uint8_t  filter;         // 57 : kAuxZBlock 필터 (BlockCodec::Filter)
+    uint8_t  reserved[70];   // 58 : 타입별 확장 영역
+};
+
+// kAuxBlockTable 본문 엔트리: 블록 레코드(태그/압축 블록) 1개
+struct BlockTableEntry {
+    uint64_t fileOffset;     //  0 : 블록 레코드의 파일 오프셋
+    uint64_t rawOffset;      //  8 : 해당 보드 스트림(복원 후) 기준 블록 시작 위치
+    uint32_t rawBytes;       // 16 : 복원 후 크기
+    uint32_t storedBytes;    // 20 : 파일에 저장된 본문 크기
+    uint16_t mid;            // 24
+    uint8_t  codec;          // 26
+    uint8_t  reserved[5];    // 27
+};
+
+// kAuxLiveTime 레코드의 reserved 영역. Producer 가 LIVETIME_SAMPLE_MS 마다 읽은 보드 카운터
+// 블록 레코드 파일은 블록 사이에, 보드별(태그 없는) 파일은 마지막 이벤트 뒤에 모아서 기록
+struct LiveTimeSample {
+    uint64_t timeNs;         //  0 : 샘플 시각 (steady_clock ns, AuxRecord::timeNs 와 동일)
+    uint64_t liveTicks;      //  8 : 보드 live time 카운터 (NKFADC500read_LIVETIME)
+    uint32_t triggers[4];    // 16 : 채널별 트리거 카운터 (NKFADC500read_EVENT_NUMBER, 채널 1~4)
+    uint32_t dramKB;         // 32 : 샘플 직전 BCOUNT (보드 DRAM 에 남아 있던 데이터)
+    uint32_t tickNs;         // 36 : liveTicks 1 단위 (ns)
+    uint64_t events;         // 40 : 레코드를 기록할 때까지 Consumer 가 센 이벤트 (런 시작 기준)
+};
+
+// kAuxConfigChange 레코드의 reserved 영역. Producer 가 BCOUNT 폴링 사이에 레지스터를 쓴 시점의 기록
+// 보드 DRAM 에 이미 있던 데이터는 이전 설정으로 수집된 것: 보드 스트림의 streamBytes + dramKB * 1024 바이트까지가 변경 전
+struct ConfigChange {
+    uint64_t timeNs;         //  0 : 레지스터를 쓴 시각 (steady_clock ns, AuxRecord::timeNs 와 동일)
+    uint64_t streamBytes;    //  8 : 그때까지 기록 스트림으로 넘긴 이 보드의 원시 데이터 (backpressure 로 돌린 블록 제외)
+    uint32_t dramKB;         // 16 : 직전 BCOUNT (보드 DRAM 에 남아 있던 데이터)
+    uint16_t param;          // 20 : ConfigParam
+    int16_t  channel;        // 22 : 채널 0~3, -1 = 보드 전체
+    int32_t  oldValue;       // 24
+    int32_t  newValue;       // 28
+    uint64_t events;         // 32 : 경계 전까지의 이벤트 수 (런 시작 기준, 다음 이벤트부터 새 값). 경계 전에 런이 끝나면 전체 수
+    uint8_t  applied;        // 40 : 0 = 장치가 거부 (보드 설정은 그대로)
+    uint8_t  reserved[7];    // 41
+};
+#pragma pack(pop)
+
+static_assert(sizeof(AuxRecord) == kAuxRecordBytes, "AuxRecord must be 128 bytes");
+static_assert(sizeof(BlockTableEntry) == 32, "BlockTableEntry must be 32 bytes");
+static_assert(sizeof(LiveTimeSample) <= sizeof(AuxRecord::reserved), "LiveTimeSample must fit the aux record");
+static_assert(sizeof(ConfigChange) <= sizeof(AuxRecord::reserved), "ConfigChange must fit the aux record");
+
+inline void InitAuxRecord(AuxRecord& rec, uint16_t type, uint16_t mid, uint32_t payloadBytes) {
+    std::memset(&rec, 0, sizeof(rec));
+    rec.magic = kAuxMagic;
+    rec.type = type;
+    rec.mid = mid;
+    rec.payloadBytes = payloadBytes;
+}
+
+inline void InitLiveTimeRecord(AuxRecord& rec, uint16_t mid, uint64_t seq, const LiveTimeSample& sample) {
+    InitAuxRecord(rec, kAuxLiveTime, mid, 0);
+    rec.seq = seq;
+    rec.timeNs = sample.timeNs;
+    std::memcpy(rec.reserved, &sample, sizeof(sample));
+}
+
+inline LiveTimeSample GetLiveTimeSample(const AuxRecord& rec) {
+    LiveTimeSample sample;
+    std::memcpy(&sample, rec.reserved, sizeof(sample));
+    return sample;
+}
+
+inline void InitConfigChangeRecord(AuxRecord& rec, uint16_t mid, uint64_t seq, const ConfigChange& change) {
+    InitAuxRecord(rec, kAuxConfigChange, mid, 0);
+    rec.seq = seq;
+    rec.timeNs = change.timeNs;
+    std::memcpy(rec.reserved, &change, sizeof(change));
+}
+
+inline ConfigChange GetConfigChange(const AuxRecord& rec) {
+    ConfigChange change;
+    std::memcpy(&change, rec.reserved, sizeof(change));
+    return change;
+}
+
+// 두 샘플 사이 live 비율 (0 ~ 1, 구간이 없거나 카운터가 멈춰 있으면 -1)
+inline double LiveFraction(const LiveTimeSample& a, const LiveTimeSample& b) {
+    if (b.timeNs <= a.timeNs || b.liveTicks <= a.liveTicks) return -1.0;
+    double live = (double)(b.liveTicks - a.liveTicks) * b.tickNs;
+    double frac = live / (double)(b.timeNs - a.timeNs);
+    return frac > 1.0 ? 1.0 : frac;
+}
+
+inline bool IsAuxRecord(const unsigned char* rec128) {
+    for (int i = 0; i < 16; i++) if (rec128[i] != 0) return false;
+    uint32_t magic;
+    std::memcpy(&magic, rec128 + 16, sizeof(magic));
+    return magic == kAuxMagic;
+}
+
+// =========================================================================
+// 💡 [이벤트 인덱스] 수집 중 함께 기록하는 .idx 사이드카 (보드당 1개)
+// - 64 바이트 IndexHeader + 이벤트당 32 바이트 IndexEntry (이벤트 번호 순)
+// - 보드별(태그 없는) 파일: offset = 이벤트 헤더의 파일 오프셋, blockSkip = 0
+// - 병합/압축 파일: offset = 이벤트 헤더가 시작되는 블록 레코드(태그/압축 블록)의 오프셋,
+//   blockSkip = 그 블록 (복원 후) 본문 시작부터 헤더까지의 바이트 (RawStreamReader::Seek 로 이동)
+// =========================================================================
+static const uint32_t kIndexMagic   = 0x58494B4E;   // "NKIX" (little-endian)
+static const uint16_t kIndexVersion = 1;
+
+enum IndexFlag {
+    kIndexBlockAddressed = 1    // offset 이 블록 레코드 위치를 가리킴 (병합/압축 파일)
+};
+
+#pragma pack(push, 1)
+struct IndexHeader {
+    uint32_t magic;          //  0 : kIndexMagic
+    uint16_t version;        //  4 : kIndexVersion
+    uint16_t entryBytes;     //  6 : sizeof(IndexEntry)
+    int32_t  mid;            //  8 : 보드 MID
+    uint32_t flags;          // 12 : IndexFlag
+    uint8_t  reserved[48];   // 16
+};
+
+struct IndexEntry {
+    uint64_t offset;         //  0 : 파일 오프셋 (위 설명 참조)
+    uint64_t event;          //  8 : 보드별 이벤트 번호 (0 부터)
+    uint64_t triggerTime;    // 16 : 헤더의 트리거 시각 (production_main 의 TriggerTime 과 동일한 해석)
+    uint32_t recordLength;   // 24 : 샘플 수
+    uint32_t blockSkip;      // 28 : 병합 파일에서 블록 본문 안의 헤더 위치
+};
+#pragma pack(pop)
+
+static_assert(sizeof(IndexHeader) == 64, "IndexHeader must be 64 bytes");
+static_assert(sizeof(IndexEntry) == 32, "IndexEntry must be 32 bytes");
+
+// =========================================================================
+// 💡 [Features-only] 백프레셔 (BACKPRESSURE 3) 로 파형을 기록하지 못한 이벤트의 .feat 사이드카 (보드당 1개)
+// - 64 바이트 FeatureHeader + 이벤트당 80 바이트 FeatureRecord (리드아웃 순서)
+// - 특징량은 production_main.cpp 와 같은 정의: baseline = 앞 pedSamples 샘플 평균, 신호 = baseline - ADC,
+//   amplitude = 신호 최대값, charge = 양의 신호 합, peak = 최대값의 샘플 번호
+// =========================================================================
+static const uint32_t kFeatureMagic   = 0x46464B4E;   // "NKFF" (little-endian)
+static const uint16_t kFeatureVersion = 1;
+
+#pragma pack(push, 1)
+struct FeatureHeader {
+    uint32_t magic;          //  0 : kFeatureMagic
+    uint16_t version;        //  4 : kFeatureVersion
+    uint16_t recordBytes;    //  6 : sizeof(FeatureRecord)
+    int32_t  mid;            //  8 : 보드 MID
+    uint32_t pedSamples;     // 12 : baseline 에 사용한 샘플 수
+    uint8_t  reserved[48];   // 16
+};
+
+struct FeatureRecord {
+    uint64_t triggerTime;    //  0 : 헤더의 트리거 시각 (EventFramer::TriggerTime)
+    uint32_t triggerNumber;  //  8 : 보드 트리거 번호 (헤더 필드 7~10)
+    uint32_t recordLength;   // 12 : 샘플 수
+    float    baseline[4];    // 16
+    float    amplitude[4];   // 32
+    float    charge[4];      // 48
+    uint16_t peak[4];        // 64
+    uint32_t pattern;        // 72 : 트리거 패턴 (헤더 필드 21~24)
+    uint8_t  reserved[4];    // 76
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FeatureHeader) == 64, "FeatureHeader must be 64 bytes");
+static_assert(sizeof(FeatureRecord) == 80, "FeatureRecord must be 80 bytes");
+
+} // namespace DataFormat
+
+#endif
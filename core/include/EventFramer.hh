@@ -0,0 +1,68 @@
+#ifndef EVENTFRAMER_HH
+#define EVENTFRAMER_HH
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <functional>
+
+// =========================================================================
+// 💡 [이벤트 프레이밍] USB 블록 안의 128 바이트 이벤트 헤더를 따라가며 정확한 이벤트 수를 셈
+// - data_length 해석은 production_main.cpp 와 동일: 이벤트 크기 = 128 + (data_length - 32) / 2 * 8
+// - 블록 경계에 걸친 이벤트(헤더/파형 일부)는 다음 블록으로 이어서 처리
+// - 헤더만 읽고 파형은 건너뛰므로 USB 전송 속도보다 훨씬 빠름 (온라인 이벤트 처리를 붙일 자리)
+// =========================================================================
+class EventFramer {
+public:
+    static const size_t kHeaderBytes = 128;
+
+    // 이벤트마다 호출: (보드 스트림 기준 헤더 시작 오프셋, 128 바이트 헤더)
+    typedef std::function<void(uint64_t, const unsigned char*)> EventFn;
+
+    EventFramer();
+
+    void SetEventCallback(const EventFn& fn) { fOnEvent = fn; }
+
+    void Reset();
+
+    // 블록 하나를 처리하고 이 블록에서 헤더가 완성된 이벤트 수를 반환
+    // offsets 가 주어지면 이 블록 안에서 시작하고 끝나는 헤더의 블록 내 오프셋을 기록
+    // (헤더 자체가 블록 경계에 걸친 이벤트는 개수에만 포함)
+    size_t Feed(const unsigned char* data, size_t len, std::vector<uint32_t>* offsets = nullptr);
+
+    // 헤더로부터 이벤트 전체 크기(헤더 포함) 계산. 손상된 헤더면 0
+    static uint64_t EventBytes(const unsigned char* header);
+    static uint32_t RecordLength(const unsigned char* header);
+    static uint64_t TriggerTime(const unsigned char* header);
+
+    uint64_t GetEvents() const        { return fEvents; }
+    uint64_t GetFramingErrors() const { return fErrors; }
+    uint64_t GetSkippedBytes() const  { return fSkipped; }
+    uint64_t GetEventBytes() const    { return fLastEventBytes; }
+    uint64_t GetStreamBytes() const   { return fStreamPos; }
+    bool     InSync() const           { return !fSearching; }
+
+    // 스트림이 이벤트 중간에서 끝났을 때 그 이벤트를 채우는 데 모자란 바이트 (경계면 0)
+    uint64_t GetMissingBytes() const;
+
+    // 런 종료 시 끝이 잘린 이벤트를 버림: 스트림에 들어온 그 이벤트의 바이트 수 반환 (경계면 0)
+    // 헤더까지 받은 이벤트는 이미 센 것이므로 계수에서 빼고 counted = true (이벤트 콜백도 이미 불렸음)
+    uint64_t DropPartial(bool& counted);
+
+private:
+    uint64_t      fRemain;            // 현재 이벤트에서 아직 지나가지 않은 파형 바이트
+    unsigned char fHdr[kHeaderBytes]; // 블록 경계에 걸린 헤더 조립용
+    size_t        fHdrHave;
+    uint64_t      fHdrPos;            // 조립 중인 헤더의 스트림 오프셋
+    uint64_t      fEventPos;          // 파형을 지나가는 중인 이벤트의 헤더 스트림 오프셋
+    uint64_t      fStreamPos;         // 지금까지 Feed 된 바이트 (= 다음 블록의 스트림 오프셋)
+    EventFn       fOnEvent;
+
+    uint64_t fEvents;
+    uint64_t fErrors;                 // 동기 상실 횟수
+    uint64_t fSkipped;                // 재동기화 중 버린 바이트
+    uint64_t fLastEventBytes;         // 마지막 정상 이벤트 크기 (재동기화 시 후보 헤더 검증에 사용)
+    bool     fSearching;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef EVENTINDEX_HH
+#define EVENTINDEX_HH
+
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+#include "DataFormat.hh"
+
+// =========================================================================
+// 💡 [이벤트 인덱스] .dat 옆에 기록되는 .idx 사이드카 (포맷은 DataFormat.hh 참조)
+// - EventIndexWriter : Consumer 가 이벤트마다 32 바이트 엔트리를 추가 (stdio 버퍼링)
+// - EventIndex       : 오프라인 도구가 mmap 으로 읽어 이벤트 N 위치를 O(1), 시간 구간을 O(log n) 으로 조회
+// =========================================================================
+class EventIndexWriter {
+public:
+    EventIndexWriter();
+    ~EventIndexWriter();
+
+    bool Open(const std::string& path, int mid, bool blockAddressed);
+    void Add(const DataFormat::IndexEntry& entry);
+    void DropLast();   // 마지막 엔트리 제거 (런 종료 시 끝이 잘린 이벤트)
+    void Close();
+
+    uint64_t GetEntries() const { return fEntries; }
+
+private:
+    FILE*    fFp;
+    uint64_t fEntries;
+};
+
+class EventIndex {
+public:
+    EventIndex();
+    ~EventIndex();
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool   IsOpen() const   { return fMap != nullptr; }
+    size_t Size() const     { return fCount; }
+    int    GetMID() const   { return fHeader ? fHeader->mid : -1; }
+    bool   IsBlockAddressed() const { return fHeader && (fHeader->flags & DataFormat::kIndexBlockAddressed); }
+
+    const DataFormat::IndexEntry& At(size_t i) const { return fEntries[i]; }
+
+    // 이벤트 번호 n 의 엔트리 (없으면 nullptr). 번호가 연속이므로 보통 O(1)
+    const DataFormat::IndexEntry* FindEvent(uint64_t n) const;
+
+    // triggerTime >= t 인 첫 엔트리의 위치 (없으면 Size()). 트리거 시각이 단조 증가한다고 가정
+    size_t LowerBoundTime(uint64_t t) const;
+
+    // run.dat -> run.idx, mid >= 0 이면 run_b<mid>.idx
+    static std::string PathFor(const std::string& datPath, int mid = -1);
+
+private:
+    void*  fMap;
+    size_t fMapBytes;
+    const DataFormat::IndexHeader* fHeader;
+    const DataFormat::IndexEntry*  fEntries;
+    size_t fCount;
+};
+
+#endif
@@ -1,25 +1,88 @@
 #ifndef FADC500DEVICE_HH
 #define FADC500DEVICE_HH
 
-#include "FadcBD.hh"
+#include <string>
+#include <cstddef>
+#include <cstdint>
 
-class Fadc500Device {
+#include "DaqDevice.hh"
+#include "RegisterShadow.hh"
+
+class UsbTransport;
+class AsyncUsbReader;
+
+class Fadc500Device : public DaqDevice {
 private:
     int fSid;
 
+    UsbTransport*   fTransport;
+    AsyncUsbReader* fAsyncReader;
+    size_t          fDirectChunkBytes;   // 0 이면 Direct 모드 비활성
+
+    // 💡 [레지스터 섀도] 설정 레지스터는 Stage 로 모았다가 FlushRegisters 에서 바뀐 것만 전송 (REG_BATCH 개씩 묶음)
+    RegisterShadow fShadow;
+    int  fRegBatch;
+    bool fBatchVerified;       // REG_BATCH > 1: 첫 묶음 전송을 읽어 펌웨어가 여러 명령을 처리하는지 확인했음
+    bool fInitialized;         // ADC/DRAM 정렬을 마친 세션 (같은 DSR 로 재설정 시 정렬 생략)
+
+    // 💡 [정렬 캐시] 벤더 정렬 함수와 같은 스윕을 직접 수행해 결과를 기록하고, 다음 시작 때 값만 써 넣은 뒤 읽어서 확인
+    struct Alignment {
+        unsigned int adcDly[4];    // 채널 1~4 ADCDLY
+        unsigned int dramDly[8];   // DRAM 레인 0~7 DRAMDLY
+        unsigned int bitslip[8];   // iodelay 리셋 후 적용한 BITSLIP 횟수
+    };
+    int         fAlignCache;       // DaqOptions::alignCache
+    std::string fAlignCacheDir;
+    int    fDacSettleMs;       // DaqOptions::dacCalSettleMs
+    size_t fRegWrites;         // 이번 Initialize 에서 보낸 레지스터 / USB 전송 수
+    size_t fRegTransfers;
+    double fRegMs;             // 그 전송에 걸린 시간
+
+    bool AttachTransport();
+    int  ReadDirect(unsigned char* dest, size_t bytes);
+    void StageChannel(uint32_t reg, int ch, uint32_t value);
+    size_t FlushRegisters();
+
+    void Align(int sampling);
+    bool SweepAdc(Alignment& result);
+    bool SweepDram(Alignment& result);
+    bool ApplyAlignment(const Alignment& result);
+    std::string AlignCachePath(int sampling) const;
+    bool LoadAlignment(const std::string& path, Alignment& result) const;
+    void SaveAlignment(const std::string& path, const Alignment& result) const;
+
 public:
-    Fadc500Device(int sid);
-    ~Fadc500Device();
+    Fadc500Device(int sid, const DaqOptions& options);
+    ~Fadc500Device() override;
 
-    void Initialize(FadcBD* bdConfig);
-    void StartDAQ();
-    void StopDAQ();
+    const char* GetName() const override { return "FADC500 Mini (USB3)"; }
+
+    void Initialize(FadcBD* bdConfig) override;
+    void StartDAQ() override;
+    void StopDAQ() override;
     
     // 💡 [신규 추가] 좀비 상태 해제 및 하드웨어 완전 세척
     void ClearAndFlushUSB(); 
 
-    unsigned int ReadBCOUNT();
-    void ReadDATA(unsigned int bcount_kb, unsigned char* dest);
+    unsigned int ReadBCOUNT() override;
+    void ReadDATA(unsigned int bcount_kb, unsigned char* dest) override;
+
+    // 💡 [Live time] LIVETIME (64-bit) + 채널별 EVENT_NUMBER 레지스터
+    bool ReadCounters(DeviceCounters& counters) override;
+
+    // 💡 [라이브 재설정] THR/DLY/PSW/TRIG_ENABLE 레지스터만 섀도를 거쳐 씀 (reset 없이, DRAM 데이터 유지)
+    bool ApplyLiveChange(FadcBD* bdConfig, int param, int ch) override;
+
+    // 💡 [USB 파이프라이닝] libusb 비동기 API 로 depth 개의 bulk 전송을 동시에 유지하는 리드아웃 모드
+    void EnableAsyncReadout(int depth, int chunkKB) override;
+    const AsyncUsbReader* GetAsyncReader() const override { return fAsyncReader; }
+
+    // 💡 [Zero-Copy] 16KB 바운스 버퍼/memcpy/malloc 없이 libusb 가 dest 로 직접 수신하는 동기 리드아웃 모드
+    void EnableDirectReadout(int chunkKB) override;
+
+protected:
+    // 💡 [DACOFF 보정] DACOFF 4채널을 섀도로 쓰고 (바뀐 채널만) 안정화 후 measure_PED / read_PED
+    bool MeasurePedestals(FadcBD* bdConfig, int pedestal[4]) override;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef LATENCYHISTOGRAM_HH
+#define LATENCYHISTOGRAM_HH
+
+#include <cstdint>
+#include <cstring>
+
+// 💡 [성능 계측] 지연 시간(ns) 분포를 고정 메모리로 누적하는 경량 히스토그램
+// 옥타브(2^k ns)마다 8개의 서브 버킷을 두어 상대 오차 ~12% 이내로 백분위수를 추정합니다.
+// 단일 스레드 기록 전용 (핫패스에서 락 없이 사용, 집계는 스레드 종료 후 또는 Merge 로 수행)
+class LatencyHistogram {
+public:
+    static const int kSubBits    = 3;
+    static const int kSubBuckets = 1 << kSubBits;
+    static const int kOctaves    = 40;          // 최대 ~2^40 ns (약 18분)
+    static const int kNBuckets   = kOctaves * kSubBuckets;
+
+    LatencyHistogram() { Reset(); }
+
+    void Reset() {
+        std::memset(fBuckets, 0, sizeof(fBuckets));
+        fCount = 0; fSum = 0; fMax = 0;
+    }
+
+    void Record(uint64_t ns) {
+        fBuckets[BucketOf(ns)]++;
+        fCount++;
+        fSum += ns;
+        if (ns > fMax) fMax = ns;
+    }
+
+    void Merge(const LatencyHistogram& other) {
+        for (int i = 0; i < kNBuckets; i++) fBuckets[i] += other.fBuckets[i];
+        fCount += other.fCount;
+        fSum   += other.fSum;
+        if (other.fMax > fMax) fMax = other.fMax;
+    }
+
+    uint64_t Count() const { return fCount; }
+    uint64_t MaxNs() const { return fMax; }
+    double   MeanNs() const { return fCount ? (double)fSum / fCount : 0.0; }
+
+    // p: 0.0 ~ 1.0 (예: 0.99 -> p99). 버킷 상한값을 반환
+    uint64_t PercentileNs(double p) const {
+        if (fCount == 0) return 0;
+        uint64_t target = (uint64_t)(p * fCount);
+        if (target >= fCount) target = fCount - 1;
+        uint64_t seen = 0;
+        for (int i = 0; i < kNBuckets; i++) {
+            seen += fBuckets[i];
+            if (seen > target) {
+                uint64_t upper = UpperBoundOf(i);
+                return (upper < fMax) ? upper : fMax;
+            }
+        }
+        return fMax;
+    }
+
+private:
+    static int BucketOf(uint64_t ns) {
+        if (ns < (uint64_t)kSubBuckets) return (int)ns;
+        int msb = 63 - __builtin_clzll(ns);
+        int octave = msb - kSubBits + 1;
+        int sub = (int)((ns >> (msb - kSubBits)) & (kSubBuckets - 1));
+        int idx = octave * kSubBuckets + sub;
+        return (idx < kNBuckets) ? idx : kNBuckets - 1;
+    }
+
+    static uint64_t UpperBoundOf(int idx) {
+        int octave = idx / kSubBuckets;
+        int sub = idx % kSubBuckets;
+        if (octave == 0) return (uint64_t)sub;
+        int shift = octave - 1;
+        return ((uint64_t)(kSubBuckets + sub + 1) << shift) - 1;
+    }
+
+    uint64_t fBuckets[kNBuckets];
+    uint64_t fCount;
+    uint64_t fSum;
+    uint64_t fMax;
+};
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef LIVERING_HH
+#define LIVERING_HH
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <sys/types.h>
+
+// =========================================================================
+// 💡 [라이브 이벤트 링] 온라인 모니터용 POSIX 공유 메모리 링 (/dev/shm/nkfadc500_live)
+// - DAQ 의 Consumer 가 블록마다 "완결된 이벤트 묶음" 1개를 슬롯에 복사 (블록당 최대 슬롯 크기, 디스크 I/O 없음)
+// - 슬롯은 seqlock 방식: 기록 중 seq = 2n+1, 완료 후 2n+2. 리더는 복사 전후 seq 를 비교하여 덮어쓰기를 감지
+// - Writer 는 리더를 절대 기다리지 않음. 느린 리더는 덮어쓰인 구간을 건너뛰고 최신 슬롯으로 이동
+// - 리더는 언제든 붙거나 떨어질 수 있음 (DAQ 종료 후에도 세그먼트는 남아 마지막 이벤트를 보여줌)
+// - 새 런이 같은 세그먼트를 다시 열면 epoch 가 바뀌어 리더가 새 런 시작을 알 수 있음
+// =========================================================================
+static const char* const kLiveRingDefaultName = "/nkfadc500_live";
+
+static const uint32_t kLiveRingMagic   = 0x524C4B4E;   // "NKLR" (little-endian)
+static const uint16_t kLiveRingVersion = 1;
+
+struct LiveRingHeader {
+    uint32_t magic;                    //  0 : kLiveRingMagic
+    uint16_t version;                  //  4 : kLiveRingVersion
+    uint16_t headerBytes;              //  6 : sizeof(LiveRingHeader)
+    uint32_t slotCount;                //  8
+    uint32_t slotBytes;                // 12 : 슬롯 본문 용량 (슬롯 헤더 제외)
+    std::atomic<uint64_t> epoch;       // 16 : Writer 가 세그먼트를 연 시각 (ns, 런마다 다름)
+    std::atomic<uint64_t> writeSeq;    // 24 : 지금까지 예약된 슬롯 수 (다중 보드 Consumer 가 fetch_add)
+    std::atomic<uint32_t> live;        // 32 : 1: DAQ 진행 중, 0: 종료
+    int32_t  writerPid;                // 36
+    uint8_t  reserved[24];             // 40
+};
+
+struct LiveRingSlot {
+    std::atomic<uint64_t> seq;         //  0 : 2n+1 기록 중, 2n+2 슬롯 n 완료
+    uint64_t firstEvent;               //  8 : 첫 이벤트의 보드별 이벤트 번호
+    uint64_t stampNs;                  // 16 : 블록 수신 시각 (steady clock)
+    uint32_t bytes;                    // 24 : 본문 크기 (128 바이트 헤더로 시작하는 완결된 이벤트들)
+    uint32_t nEvents;                  // 28
+    int32_t  mid;                      // 32 : 보드 MID
+    uint8_t  reserved[28];             // 36
+};
+
+static_assert(sizeof(LiveRingHeader) == 64, "LiveRingHeader must be 64 bytes");
+static_assert(sizeof(LiveRingSlot) == 64, "LiveRingSlot must be 64 bytes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "LiveRing needs lock-free 64-bit atomics in shared memory");
+
+// 리더가 꺼낸 슬롯 1개의 사본
+struct LiveBlock {
+    int      mid = -1;
+    uint64_t firstEvent = 0;
+    uint64_t stampNs = 0;
+    uint32_t nEvents = 0;
+    std::vector<unsigned char> data;
+};
+
+class LiveRingWriter {
+public:
+    LiveRingWriter();
+    ~LiveRingWriter();
+
+    // 같은 이름/크기의 세그먼트가 있으면 재사용 (붙어 있는 리더 유지), 크기가 다르면 새로 만듦
+    bool Open(const std::string& name, size_t ringBytes, size_t slotBytes);
+    void Close();   // live = 0 표시 후 매핑 해제 (세그먼트는 남겨 둠)
+
+    bool IsOpen() const { return fHeader != nullptr; }
+
+    // 블록의 offsets[0] 에서 시작하는 완결된 이벤트들을 슬롯 크기까지 1개 슬롯으로 게시 (여러 Consumer 에서 동시 호출 가능)
+    // firstEvent = offsets[0] 이벤트의 번호. 게시한 이벤트 수 반환 (0 이면 게시 안 함)
+    uint32_t Publish(int mid, const unsigned char* data, size_t len, const std::vector<uint32_t>& offsets,
+                     uint64_t firstEvent, uint64_t stampNs);
+
+    uint64_t GetPublished() const { return fPublished; }
+    const std::string& GetName() const { return fName; }
+
+private:
+    LiveRingSlot* SlotAt(uint64_t n) const;
+
+    std::string     fName;
+    void*           fMap;
+    size_t          fMapBytes;
+    LiveRingHeader* fHeader;
+    size_t          fStride;
+    std::atomic<uint64_t> fPublished;
+};
+
+class LiveRingReader {
+public:
+    enum Status {
+        kEmpty,    // 새 슬롯 없음 (또는 Writer 가 아직 기록 중)
+        kBlock,    // block 에 슬롯 1개 복사됨
+        kNewRun    // 새 런이 세그먼트를 다시 열었거나 교체함 (누적 히스토그램 초기화 시점)
+    };
+
+    LiveRingReader();
+    ~LiveRingReader();
+
+    // 세그먼트가 없으면 즉시 false (DAQ 시작 전이면 나중에 다시 시도)
+    bool Attach(const std::string& name = kLiveRingDefaultName);
+    void Detach();
+    bool IsAttached() const { return fHeader != nullptr; }
+
+    // 다음 슬롯을 복사. mid >= 0 이면 해당 보드의 슬롯만 (다른 보드 슬롯은 건너뜀)
+    Status Next(LiveBlock& block, int mid = -1);
+
+    // 밀린 슬롯을 건너뛰고 가장 최근 슬롯을 복사 (화면 갱신 주기로 솎아 읽는 용도, GetSkipped 에는 포함 안 함)
+    Status Latest(LiveBlock& block, int mid = -1);
+
+    bool     IsWriterLive() const { return fHeader && fHeader->live.load(std::memory_order_relaxed) != 0; }
+    uint64_t GetSkipped() const   { return fSkipped; }   // 덮어쓰기로 놓친 슬롯 수
+    uint64_t GetRead() const      { return fRead; }
+
+private:
+    bool Replaced();
+    const LiveRingSlot* SlotAt(uint64_t n) const;
+
+    std::string fName;
+    void*       fMap;
+    size_t      fMapBytes;
+    const LiveRingHeader* fHeader;
+    size_t      fStride;
+    ino_t       fIno;
+    uint64_t    fEpoch;
+    uint64_t    fNext;
+    uint64_t    fSkipped;
+    uint64_t    fRead;
+    uint64_t    fLastCheckNs;
+};
+
+#endif
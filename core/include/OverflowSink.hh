@@ -0,0 +1,62 @@
+#ifndef OVERFLOWSINK_HH
+#define OVERFLOWSINK_HH
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+// =========================================================================
+// 💡 [백프레셔] 버퍼 풀이 고갈된 동안 Producer 가 보드 DRAM 에서 읽어 낸 이벤트의 행선지 (BACKPRESSURE 1~3)
+// - Producer 가 이벤트 경계에 맞춰 넘기므로 전환 구간 전체는 항상 완결된 이벤트의 연속
+//   (Write 호출 사이에서 이벤트 하나가 나뉠 수는 있음)
+// - Drop     : 기록 없음 (Producer 가 이벤트/바이트만 집계)
+// - Spill    : 보드별 .dat 와 같은 형식의 이벤트 스트림 (production_main 으로 그대로 분석 가능)
+// - Features : 이벤트를 조립해 FeatureRecord 1개로 줄여 .feat 에 기록 (DataFormat.hh)
+// - 파일은 첫 Write 때 열고, 열 수 없으면 Drop 으로 강등 (Producer 스레드 전용)
+// =========================================================================
+class OverflowSink {
+public:
+    OverflowSink(int policy, int pedSamples);
+    ~OverflowSink();
+
+    // 기록할 파일 경로 (실제로 여는 것은 첫 Write)
+    void SetPath(const std::string& path, int mid);
+    void Write(const unsigned char* data, size_t len);
+    void Close();
+
+    int GetPolicy() const                { return fPolicy; }
+    const std::string& GetPath() const   { return fPath; }
+    uint64_t GetBytes() const            { return fBytes; }        // 받은 이벤트 스트림 바이트
+    uint64_t GetStoredBytes() const      { return fStoredBytes; }  // 파일에 기록한 바이트
+    uint64_t GetRecords() const          { return fRecords; }      // Features: 기록한 FeatureRecord
+    uint64_t GetWriteErrors() const      { return fWriteErrors; }
+    bool     IsDegraded() const          { return fDegraded; }     // 파일을 열지 못해 Drop 으로 동작 중
+
+    static const char* PolicyName(int policy);
+
+private:
+    bool OpenFile();
+    void FeedFeatures(const unsigned char* data, size_t len);
+    void WriteFeature(const unsigned char* event, uint64_t eventBytes);
+    void Put(const void* data, size_t len);
+
+    int         fPolicy;
+    int         fPedSamples;
+    int         fMid;
+    std::string fPath;
+    FILE*       fFp;
+    bool        fDegraded;
+
+    // Features: Write 경계에 걸린 이벤트 조립
+    std::vector<unsigned char> fEvent;
+    uint64_t fEventBytes;                // 조립 중인 이벤트 크기 (헤더를 받기 전에는 0)
+
+    uint64_t fBytes;
+    uint64_t fStoredBytes;
+    uint64_t fRecords;
+    uint64_t fWriteErrors;
+};
+
+#endif
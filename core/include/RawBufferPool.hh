@@ -5,34 +5,79 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
 
 // 순수 바이너리 데이터를 담을 구조체
+// 💡 O_DIRECT 기록을 위해 data 는 4KB 페이지 경계에 정렬하여 할당
+// 💡 BufferArena 조각을 가리키는 비소유(owned == false) 버퍼는 해제/재할당하지 않음
 struct RawBuffer {
+    static const size_t kAlign = 4096;
+
     unsigned char* data;
     size_t size;
     size_t capacity;
+    uint64_t stampNs;   // 큐 진입 시각 (steady_clock ns, 큐 체류 시간 계측용)
+    bool owned;
+
+    // EventFramer 결과: 이 블록에서 헤더가 완성된 이벤트 수와 블록 안에서 시작하는 헤더 오프셋
+    uint32_t nEvents = 0;
+    std::vector<uint32_t> eventOffsets;
+
+    RawBuffer(size_t cap) : data(nullptr), size(0), capacity(0), stampNs(0), owned(true) {
+        Reserve(cap);
+    }
+    RawBuffer(unsigned char* mem, size_t cap) : data(mem), size(0), capacity(cap), stampNs(0), owned(false) {}
+    ~RawBuffer() { if (owned) free(data); }
 
-    RawBuffer(size_t cap) : size(0), capacity(cap) {
-        data = new unsigned char[capacity];
+    // 용량이 부족할 때만 재할당 (기존 내용은 보존하지 않음). 비소유 버퍼는 확장 불가 -> false
+    bool Reserve(size_t cap) {
+        if (data && cap <= capacity) return true;
+        if (!owned) return false;
+        void* p = nullptr;
+        if (posix_memalign(&p, kAlign, (cap + kAlign - 1) / kAlign * kAlign) != 0) throw std::bad_alloc();
+        free(data);
+        data = static_cast<unsigned char*>(p);
+        capacity = cap;
+        return true;
     }
-    ~RawBuffer() { delete[] data; }
 };
 
-class RawBufferPool {
+// 💡 Producer/Consumer 사이 RawBuffer 전달 큐 인터페이스 (구현체를 BinaryDaqManager 에서 선택)
+class BufferQueue {
+public:
+    virtual ~BufferQueue() {}
+
+    virtual void   Push(RawBuffer* item) = 0;
+    virtual bool   WaitAndPop(RawBuffer*& popped_item) = 0;
+    // 최대 timeoutMs 동안 대기. 타임아웃 또는 Stop 후 비어 있으면 false
+    virtual bool   WaitAndPopFor(RawBuffer*& popped_item, int timeoutMs) = 0;
+    virtual bool   TryPop(RawBuffer*& popped_item) = 0;
+    virtual void   Stop() = 0;
+    virtual void   Restart() = 0;   // Stop 해제 (같은 큐로 다음 런을 시작할 때)
+    virtual size_t Size() const = 0;
+};
+
+// 기본 구현: std::queue + mutex/condvar (다중 생산자/소비자 안전)
+class RawBufferPool : public BufferQueue {
 public:
     RawBufferPool() : _stop(false) {}
-    ~RawBufferPool() {
+    ~RawBufferPool() override {
         RawBuffer* buf;
         while (TryPop(buf)) delete buf;
     }
 
-    void Push(RawBuffer* item) {
+    void Push(RawBuffer* item) override {
         std::lock_guard<std::mutex> lock(_mutex);
         _queue.push(item);
         _cv.notify_one();
     }
 
-    bool WaitAndPop(RawBuffer*& popped_item) {
+    bool WaitAndPop(RawBuffer*& popped_item) override {
         std::unique_lock<std::mutex> lock(_mutex);
         _cv.wait(lock, [this]() { return !_queue.empty() || _stop.load(); });
         if (_queue.empty() && _stop.load()) return false;
@@ -41,7 +86,16 @@ public:
         return true;
     }
 
-    bool TryPop(RawBuffer*& popped_item) {
+    bool WaitAndPopFor(RawBuffer*& popped_item, int timeoutMs) override {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return !_queue.empty() || _stop.load(); })) return false;
+        if (_queue.empty()) return false;
+        popped_item = _queue.front();
+        _queue.pop();
+        return true;
+    }
+
+    bool TryPop(RawBuffer*& popped_item) override {
         std::lock_guard<std::mutex> lock(_mutex);
         if (_queue.empty()) return false;
         popped_item = _queue.front();
@@ -49,8 +103,9 @@ public:
         return true;
     }
 
-    void Stop() { _stop.store(true); _cv.notify_all(); }
-    size_t Size() const { std::lock_guard<std::mutex> lock(_mutex); return _queue.size(); }
+    void Stop() override { _stop.store(true); _cv.notify_all(); }
+    void Restart() override { _stop.store(false); }
+    size_t Size() const override { std::lock_guard<std::mutex> lock(_mutex); return _queue.size(); }
 
 private:
     std::queue<RawBuffer*> _queue;
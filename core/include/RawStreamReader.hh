@@ -0,0 +1,86 @@
+#ifndef RAWSTREAMREADER_HH
+#define RAWSTREAMREADER_HH
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <set>
+#include <utility>
+
+#include "DataFormat.hh"
+
+// =========================================================================
+// 💡 [스트림 리더] .dat 파일에서 한 보드의 순수 이벤트 바이트 스트림만 꺼내주는 리더
+// - 단일 보드(태그 없는) 파일: 그대로 통과
+// - 다중 보드 병합 파일: Block Tag 레코드를 해석하여 선택한 MID 의 블록만 이어 붙이고,
+//   다른 보드 블록과 기타 Aux 레코드는 건너뜀
+// - 압축 파일 (kAuxZBlock): 블록 단위로 읽어 압축 해제 후 같은 방식으로 이어 붙임
+// - 라이브 tail 용도: Read() 가 데이터 부족으로 false 를 반환하면 읽은 부분은 내부에 보관되므로,
+//   파일이 자란 뒤 같은 크기로 다시 호출하면 이어서 채워집니다.
+// =========================================================================
+class RawStreamReader {
+public:
+    // mid < 0 : 병합 파일에서 처음 만나는 보드를 자동 선택
+    RawStreamReader(FILE* fp, int mid = -1);
+
+    bool Read(void* dest, size_t bytes);
+    bool Skip(size_t bytes);
+    void Rewind();
+
+    // .idx 엔트리 위치로 이동 (offset = 파일 오프셋, blockSkip = 병합 블록 본문 안의 위치)
+    bool Seek(uint64_t offset, uint32_t blockSkip = 0);
+
+    bool IsMerged() const      { return fMode == kMerged; }
+    bool IsCompressed() const  { return fCompressed; }
+    int  GetSelectedMID() const { return fMid; }
+    const std::set<int>& GetSeenMIDs() const { return fSeenMids; }
+
+    // 💡 [Live time] 지금까지 읽은 kAuxLiveTime 샘플 (선택한 보드, 기록 순)
+    // 블록 레코드 파일은 블록 사이에서 자동으로 모이고, 보드별 파일은 마지막 이벤트 뒤에 있으므로
+    // 이벤트 헤더 자리에서 Aux 레코드를 만나면 ReadTrailer(이미 읽은 128 바이트) 로 나머지를 읽음
+    std::vector<DataFormat::LiveTimeSample> GetLiveTime() const;
+    // 💡 [라이브 재설정] kAuxConfigChange 기록 (선택한 보드, 기록 순). 모이는 방식은 live time 과 같음
+    std::vector<DataFormat::ConfigChange> GetConfigChanges() const;
+    void ReadTrailer(const unsigned char* rec128);
+
+    // 파일 끝의 블록 위치 테이블 로드 (블록 레코드 파일이 정상 종료된 경우에만 존재). 파일 위치는 보존
+    static bool ReadBlockTable(FILE* fp, std::vector<DataFormat::BlockTableEntry>& table);
+
+private:
+    enum Mode { kUnknown, kPlain, kMerged };
+
+    size_t Fill(unsigned char* dest, size_t bytes);
+    bool   DetectMode();
+    bool   NextRecord();
+    bool   Discard();
+    bool   LoadZBlock();
+    void   NoteAux(const DataFormat::AuxRecord& rec);
+
+    FILE* fFp;
+    int   fRequestedMid;
+    int   fMid;
+    Mode  fMode;
+
+    uint64_t fBlockRemain;     // 현재 선택 보드 블록의 남은 바이트
+    uint64_t fPadRemain;       // 현재 블록 뒤에 남은 0 패딩
+    uint64_t fDiscardRemain;   // 건너뛰는 중인 (다른 보드/Aux) 바이트
+    std::vector<unsigned char> fPending;   // 이전 실패한 Read 에서 이미 확보한 바이트
+    std::vector<unsigned char> fScratch;
+    std::set<int> fSeenMids;
+    std::vector<std::pair<int, DataFormat::LiveTimeSample>> fLiveTime;   // (MID, 샘플)
+    std::vector<std::pair<int, DataFormat::ConfigChange>> fConfigChanges;
+
+    // 압축 블록 상태
+    bool     fCompressed;
+    bool     fZLoad;             // 압축 본문을 읽는 중
+    size_t   fZHave;
+    size_t   fZPos;
+    size_t   fZAvail;            // fZRaw 에 남은 복원 바이트
+    uint64_t fZErrors;
+    DataFormat::AuxRecord fZRec;
+    std::vector<unsigned char> fZComp;
+    std::vector<unsigned char> fZRaw;
+};
+
+#endif
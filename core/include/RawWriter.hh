@@ -0,0 +1,153 @@
+#ifndef RAWWRITER_HH
+#define RAWWRITER_HH
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+#include "RawBufferPool.hh"
+#include "LatencyHistogram.hh"
+#include "DaqOptions.hh"
+
+// =========================================================================
+// 💡 [Writer 백엔드] ConsumerWorker 가 RawBuffer 블록을 디스크로 내보내는 경로
+// - Stdio  : 기존 fwrite + 16MB setvbuf (블록마다 stdio 버퍼/페이지 캐시로 2회 복사)
+// - Direct : O_DIRECT pwrite. 페이지 캐시를 거치지 않고 RawBuffer 에서 곧바로 디스크로 DMA
+// - Uring  : O_DIRECT + io_uring. 여러 블록을 동시에 걸어두고, 커널이 완료를 알려준 버퍼만 반납
+//
+// O_DIRECT 는 파일 오프셋/길이/메모리 주소가 모두 4KB 정렬일 때만 사용하고,
+// 정렬이 맞지 않는 조각(런 마지막 블록 등)은 같은 파일의 일반 fd 로 pwrite 합니다.
+// =========================================================================
+class RawWriter {
+public:
+    typedef std::function<void(RawBuffer*)> ReleaseFn;
+
+    virtual ~RawWriter() {}
+
+    virtual bool Open(const std::string& path) = 0;
+
+    // buf->data[0 .. buf->size) 를 파일 끝에 추가. 커널이 버퍼 사용을 끝내면 release(buf) 호출
+    virtual bool Append(RawBuffer* buf, const ReleaseFn& release) = 0;
+
+    // Aux 레코드/패딩 등 작은 데이터를 복사하여 동기 기록
+    virtual bool AppendCopy(const void* data, size_t len) = 0;
+
+    // 완료된 비동기 기록을 대기 없이 회수 (Consumer idle 시 호출)
+    virtual void Poll() {}
+
+    // 남은 기록을 모두 완료시킨 뒤 파일을 size 바이트로 자르고 다음 기록을 그 끝에서 이어감
+    virtual bool Truncate(uint64_t size) = 0;
+
+    // 남은 기록을 모두 완료시키고 파일을 닫음
+    virtual void Close() = 0;
+
+    // 이 백엔드가 효율적으로 기록하기 위한 정렬 단위 (Stdio = 1)
+    virtual size_t GetAlignment() const { return 1; }
+    virtual const char* GetName() const = 0;
+
+    uint64_t GetBytesWritten() const { return fBytesWritten; }
+    uint64_t GetErrorCount() const   { return fErrors; }
+    uint64_t GetUnalignedWrites() const { return fUnaligned; }
+    const LatencyHistogram& GetLatency() const { return fLatency; }
+
+    // 서브런 롤오버: 닫은 이전 파일 Writer 의 누적 통계를 이어받아 런 전체 요약을 유지
+    void InheritStats(const RawWriter& prev) {
+        fBytesWritten += prev.fBytesWritten;
+        fErrors       += prev.fErrors;
+        fUnaligned    += prev.fUnaligned;
+        fLatency.Merge(prev.fLatency);
+    }
+
+    // DaqOptions::writerBackend 에 따라 생성 (io_uring 초기화 실패 시 Direct 로 자동 강등)
+    static RawWriter* Create(const DaqOptions& options);
+
+protected:
+    RawWriter() : fBytesWritten(0), fErrors(0), fUnaligned(0) {}
+
+    uint64_t fBytesWritten;
+    uint64_t fErrors;
+    uint64_t fUnaligned;
+    LatencyHistogram fLatency;   // 블록 1개당 제출~완료 지연
+};
+
+// 기존 동작: fwrite + 16MB stdio 버퍼
+class StdioRawWriter : public RawWriter {
+public:
+    StdioRawWriter() : fFp(nullptr) {}
+    ~StdioRawWriter() override { Close(); }
+
+    bool Open(const std::string& path) override;
+    bool Append(RawBuffer* buf, const ReleaseFn& release) override;
+    bool AppendCopy(const void* data, size_t len) override;
+    bool Truncate(uint64_t size) override;
+    void Close() override;
+    const char* GetName() const override { return "stdio"; }
+
+private:
+    FILE* fFp;
+};
+
+// O_DIRECT 동기 pwrite
+class DirectRawWriter : public RawWriter {
+public:
+    static const size_t kAlign = 4096;
+
+    DirectRawWriter();
+    ~DirectRawWriter() override;
+
+    bool Open(const std::string& path) override;
+    bool Append(RawBuffer* buf, const ReleaseFn& release) override;
+    bool AppendCopy(const void* data, size_t len) override;
+    bool Truncate(uint64_t size) override;
+    void Close() override;
+    size_t GetAlignment() const override { return fDirectFd >= 0 ? kAlign : 1; }
+    const char* GetName() const override { return "direct"; }
+
+protected:
+    bool IsAligned(const void* ptr, size_t len) const;
+    bool WriteAll(int fd, const unsigned char* data, size_t len, uint64_t offset);
+
+    int fDirectFd;     // O_DIRECT (정렬된 블록)
+    int fBufferedFd;   // 일반 fd (정렬되지 않은 조각)
+    uint64_t fOffset;  // 다음 기록 위치
+    unsigned char* fScratch;   // AppendCopy 용 정렬 버퍼
+    size_t fScratchCap;
+};
+
+// O_DIRECT + io_uring 비동기 기록 (liburing 없이 커널 인터페이스를 직접 사용)
+class UringRawWriter : public DirectRawWriter {
+public:
+    explicit UringRawWriter(int depth);
+    ~UringRawWriter() override;
+
+    bool Init();   // io_uring_setup 실패 시 false (호출자가 Direct 로 강등)
+
+    bool Append(RawBuffer* buf, const ReleaseFn& release) override;
+    void Poll() override;
+    bool Truncate(uint64_t size) override;
+    void Close() override;
+    const char* GetName() const override { return "io_uring"; }
+
+private:
+    struct Slot {
+        RawBuffer* buffer;
+        ReleaseFn  release;
+        uint64_t   offset;
+        uint64_t   submitNs;
+        bool       busy;
+    };
+    struct Ring;
+
+    int  Reap(int minComplete);
+    void Complete(Slot& slot, int res);
+
+    Ring* fRing;
+    std::vector<Slot> fSlots;
+    std::vector<int>  fFreeSlots;
+    int fInFlight;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef REGISTERSHADOW_HH
+#define REGISTERSHADOW_HH
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// =========================================================================
+// 💡 [레지스터 섀도] 보드 레지스터에 마지막으로 쓴 값을 기억해 재설정 시 바뀐 것만 보냄
+// - Stage: 알려진 값과 같으면 건너뛰고, 다르거나 처음이면 전송 목록에 추가 (같은 주소는 마지막 값만,
+//          전송 전에 알려진 값으로 되돌리면 목록에서 빠짐)
+// - 전송 후 Commit 으로 목록을 '알려진 값' 에 반영. 전송 실패한 주소는 Forget 으로 다음에 다시 보냄
+// - 명령 레지스터 (reset/start/measure_PED 등) 는 값이 같아도 동작이 있으므로 여기서 다루지 않음
+// =========================================================================
+class RegisterShadow {
+public:
+    struct Write {
+        uint32_t addr;
+        uint32_t value;
+    };
+
+    RegisterShadow() : fSkipped(0) {}
+
+    void Stage(uint32_t addr, uint32_t value) {
+        // 대기 중인 같은 주소부터 확인: 알려진 값으로 되돌리면 대기 값을 빼고, 아니면 제자리에서 바꿈 (전송 순서 유지)
+        auto known = fKnown.find(addr);
+        const bool same = known != fKnown.end() && known->second == value;
+        for (auto it = fPending.begin(); it != fPending.end(); ++it) {
+            if (it->addr != addr) continue;
+            if (same) { fPending.erase(it); fSkipped++; }
+            else it->value = value;
+            return;
+        }
+        if (same) {
+            fSkipped++;
+            return;
+        }
+        fPending.push_back({addr, value});
+    }
+
+    bool Matches(uint32_t addr, uint32_t value) const {
+        auto known = fKnown.find(addr);
+        return known != fKnown.end() && known->second == value;
+    }
+
+    const std::vector<Write>& GetPending() const { return fPending; }
+    size_t GetSkipped() const                   { return fSkipped; }
+
+    void Commit() {
+        for (const Write& w : fPending) fKnown[w.addr] = w.value;
+        fPending.clear();
+    }
+    void Forget(uint32_t addr) { fKnown.erase(addr); }
+    void Invalidate()          { fKnown.clear(); fPending.clear(); }   // 보드 상태를 알 수 없게 된 경우 (재부팅 등)
+    void ResetCounters()       { fSkipped = 0; }
+
+private:
+    std::map<uint32_t, uint32_t> fKnown;
+    std::vector<Write> fPending;
+    size_t fSkipped;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef RUNCONTROL_HH
+#define RUNCONTROL_HH
+
+#include <string>
+
+// =========================================================================
+// 💡 [데몬] frontend 데몬 모드 (-D) 의 명령 채널: 로컬 Unix 도메인 소켓 + 줄 단위 텍스트 프로토콜
+// - 명령 1줄 ("start run_0001.dat 0 60\n") 마다 응답 1줄 ("OK ..." / "ERR ...")
+// - 클라이언트는 한 번에 하나 (새 연결이 오면 이전 연결을 닫고 교체, GUI 재시작 대응)
+// - 메인 스레드가 WaitCommand 로 폴링하므로 수집 스레드와 락을 공유하지 않음
+// =========================================================================
+class RunControlServer {
+public:
+    RunControlServer();
+    ~RunControlServer();
+
+    // 남아 있는 소켓 파일은 지우고 새로 bind (권한 0660: 같은 그룹의 GUI/스크립트만 접근)
+    bool Open(const std::string& path);
+    void Close();
+
+    // 최대 timeoutMs 동안 명령 1줄을 기다림. 받으면 true (개행 제외, 앞뒤 공백 제거)
+    bool WaitCommand(std::string& line, int timeoutMs);
+    // 마지막 명령을 보낸 클라이언트에게 응답 1줄 (끊긴 클라이언트는 조용히 정리)
+    void Reply(const std::string& text);
+
+    const std::string& GetPath() const { return fPath; }
+
+private:
+    void DropClient();
+    bool TakeLine(std::string& line);
+
+    std::string fPath;
+    int         fListenFd;
+    int         fClientFd;
+    std::string fInput;        // 아직 개행이 오지 않은 수신 데이터
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef SIMFADC500DEVICE_HH
+#define SIMFADC500DEVICE_HH
+
+#include <deque>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdint>
+
+#include "DaqDevice.hh"
+
+// =========================================================================
+// 💡 [시뮬레이터] 하드웨어 없이 FADC500 Mini 와 같은 BCOUNT / ReadDATA 스트림을 만드는 장치 (DEVICE 1)
+// - 트리거: 벽시계 기준 Poisson 과정 (SIM_TRIGGER_HZ). 펄스 높이가 모든 채널 THR 미만이면 트리거되지 않음
+// - 이벤트: 128 바이트 헤더 (필드 32개, 채널별 바이트 인터리브) + 4채널 12-bit 파형 (샘플당 8 바이트)
+// - 파형: 베이스라인 (DACOFF + 채널 오프셋) + 이중 지수 펄스 (DLY 위치, POL 극성) + 가우시안 잡음
+//   시작 시 16MB 분량의 파형 템플릿을 만들어 두고 이벤트마다 골라 복사 (Producer 스레드 부하 최소화)
+// - 보드 DRAM: 리드아웃이 못 따라가 SIM_DRAM_MB 를 넘으면 그동안의 트리거는 손실로 집계
+// - USB: 전송마다 고정 지연 + 지수 분포 지터 + 대역폭 (SIM_USB_*)
+// - 데드타임: 저장된 트리거마다 레코드 윈도우 길이, DRAM 이 가득 찬 동안은 전부 (live time 카운터에 반영)
+// =========================================================================
+class SimFadc500Device : public DaqDevice {
+public:
+    SimFadc500Device(int mid, const DaqOptions& options);
+    ~SimFadc500Device() override;
+
+    const char* GetName() const override { return "FADC500 simulator"; }
+
+    void Initialize(FadcBD* bdConfig) override;
+    void StartDAQ() override;
+    void StopDAQ() override;
+
+    unsigned int ReadBCOUNT() override;
+    void ReadDATA(unsigned int bcount_kb, unsigned char* dest) override;
+    bool ReadCounters(DeviceCounters& counters) override;
+
+    // THR: 템플릿별 트리거 패턴만 다시 계산, DLY: 템플릿 재생성, PSW/TRIG_ENABLE: 파형에 영향 없음 (레지스터 쓰기 지연만)
+    bool ApplyLiveChange(FadcBD* bdConfig, int param, int ch) override;
+
+    uint64_t GetTriggers() const     { return fTriggers; }
+    uint64_t GetLostTriggers() const { return fLost; }
+
+protected:
+    // 템플릿과 같은 베이스라인 모델 (DACOFF + 채널 오프셋) 의 평균 + 측정 잡음. 템플릿은 다시 만들지 않음 (Initialize 에서)
+    bool MeasurePedestals(FadcBD* bdConfig, int pedestal[4]) override;
+
+private:
+    struct PendingEvent {
+        uint64_t timeNs;      // StartDAQ 기준 트리거 시각
+        uint32_t templ;       // 파형 템플릿 번호
+        uint32_t number;      // 로컬 트리거 번호 (DRAM 에 들어간 순서, 1부터)
+    };
+
+    void BuildTemplates(FadcBD* bdConfig);
+    double Baseline(const FadcBD* bdConfig, int ch) const;
+    uint32_t UpdatePatterns(FadcBD* bdConfig);
+    void AdvanceTo(uint64_t nowNs);
+    void BuildHeader(const PendingEvent& ev);
+    void SleepUs(double us);
+    uint64_t NowNs() const;
+
+    int        fMid;
+    DaqOptions fOptions;
+
+    // 파형 템플릿 (이벤트 본문 그대로의 인터리브 바이트)
+    size_t   fSamples;
+    size_t   fEventBytes;
+    uint64_t fWindowNs;                  // 레코드 윈도우 길이 (트리거 1개당 데드타임)
+    uint32_t fNTemplates;
+    std::vector<unsigned char> fTemplates;
+    std::vector<uint32_t> fPatterns;     // 템플릿별 THR 이상인 채널 비트 (0: 트리거되지 않음)
+    std::vector<float> fAmplitudes;      // 템플릿 x 채널 펄스 높이 (THR 변경 시 패턴 재계산용)
+
+    // 보드 DRAM 에 쌓인 이벤트 (트리거 시각 순)
+    std::deque<PendingEvent> fPending;
+    uint64_t fDramBytes;                 // fPending 전체 크기 - 이미 읽은 앞부분
+    uint64_t fDramLimit;
+    size_t   fHeadPos;                   // fPending.front() 중 이미 읽은 바이트
+    unsigned char fHeader[128];
+
+    bool     fRunning;
+    std::chrono::steady_clock::time_point fStart;
+    uint64_t fNextTriggerNs;
+    uint64_t fTriggers;                  // 헤더를 만든 (DRAM 에 들어간) 이벤트
+    uint64_t fChannelTriggers[4];        // 그중 채널별 THR 을 넘은 이벤트 (보드 EVENT_NUMBER 카운터)
+    uint64_t fLost;                      // DRAM 이 가득 차 버린 트리거
+    uint64_t fBelowThreshold;            // THR 미만이라 트리거되지 않은 펄스
+    uint64_t fDeadNs;                    // 누적 데드타임
+    uint64_t fDeadUntilNs;               // 마지막 트리거의 윈도우가 끝나는 시각
+    uint64_t fVetoed;                    // 이전 트리거의 윈도우 안에 들어와 받지 않은 트리거
+
+    std::mt19937_64 fRng;
+    std::exponential_distribution<double> fInterval;
+    std::exponential_distribution<double> fJitter;
+};
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef SPSCRING_HH
+#define SPSCRING_HH
+
+#include <atomic>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+
+#include "RawBufferPool.hh"
+
+// =========================================================================
+// 💡 [Lock-Free] 단일 생산자/단일 소비자 고정 크기 링 버퍼
+// head(소비자)와 tail(생산자) 인덱스를 서로 다른 캐시 라인에 두어 false sharing 을 제거하고,
+// 상대편 인덱스는 로컬 캐시 값으로 먼저 판정하여 공유 라인 접근을 최소화합니다.
+// =========================================================================
+template <typename T>
+class SpscRing {
+public:
+    static const size_t kCacheLine = 64;
+
+    explicit SpscRing(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;   // 2의 거듭제곱으로 올림 (mask 인덱싱)
+        fMask = cap - 1;
+        fSlots.resize(cap);
+    }
+
+    size_t Capacity() const { return fMask + 1; }
+
+    // 생산자 스레드 전용
+    bool TryPush(const T& item) {
+        const size_t tail = fTail.value.load(std::memory_order_relaxed);
+        if (tail - fHeadCache.value >= Capacity()) {
+            fHeadCache.value = fHead.value.load(std::memory_order_acquire);
+            if (tail - fHeadCache.value >= Capacity()) return false;
+        }
+        fSlots[tail & fMask] = item;
+        fTail.value.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 소비자 스레드 전용
+    bool TryPop(T& item) {
+        const size_t head = fHead.value.load(std::memory_order_relaxed);
+        if (head == fTailCache.value) {
+            fTailCache.value = fTail.value.load(std::memory_order_acquire);
+            if (head == fTailCache.value) return false;
+        }
+        item = fSlots[head & fMask];
+        fHead.value.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 임의 스레드에서 호출 가능한 근사 크기 (락 없음)
+    size_t Size() const {
+        const size_t head = fHead.value.load(std::memory_order_acquire);
+        const size_t tail = fTail.value.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+private:
+    template <typename V>
+    struct alignas(kCacheLine) Padded { V value{}; };
+
+    Padded<std::atomic<size_t>> fHead;       // 소비자 소유
+    Padded<size_t>              fTailCache;  // 소비자가 마지막으로 본 tail
+    Padded<std::atomic<size_t>> fTail;       // 생산자 소유
+    Padded<size_t>              fHeadCache;  // 생산자가 마지막으로 본 head
+    size_t fMask;
+    std::vector<T> fSlots;
+};
+
+// =========================================================================
+// SpscRing 기반 BufferQueue 구현 (RawBufferPool 의 drop-in 대체)
+// useWakeup = true  : 소비자가 잠든 경우에만 eventfd 로 깨움 (idle 시 CPU 0)
+// useWakeup = false : WaitAndPop 이 spin/yield 로 대기 (최저 지연, 코어 1개 점유)
+// =========================================================================
+class SpscBufferQueue : public BufferQueue {
+public:
+    SpscBufferQueue(size_t capacity = 1024, bool useWakeup = true)
+        : fRing(capacity), fUseWakeup(useWakeup), fEventFd(-1), fWaiting(false), fStop(false)
+    {
+        if (fUseWakeup) {
+            fEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (fEventFd < 0) fUseWakeup = false;
+        }
+    }
+
+    ~SpscBufferQueue() override {
+        RawBuffer* buf;
+        while (fRing.TryPop(buf)) delete buf;
+        if (fEventFd >= 0) close(fEventFd);
+    }
+
+    void Push(RawBuffer* item) override {
+        // 풀 전체 버퍼 수 <= 용량이면 가득 찰 일이 없음. 방어적으로 양보하며 재시도
+        while (!fRing.TryPush(item)) std::this_thread::yield();
+        if (fUseWakeup) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (fWaiting.load(std::memory_order_relaxed)) Signal();
+        }
+    }
+
+    bool TryPop(RawBuffer*& popped_item) override { return fRing.TryPop(popped_item); }
+
+    bool WaitAndPop(RawBuffer*& popped_item) override {
+        while (true) {
+            if (fRing.TryPop(popped_item)) return true;
+            if (fStop.load(std::memory_order_acquire)) return fRing.TryPop(popped_item);
+            BlockUntilSignal(-1);
+        }
+    }
+
+    bool WaitAndPopFor(RawBuffer*& popped_item, int timeoutMs) override {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true) {
+            if (fRing.TryPop(popped_item)) return true;
+            if (fStop.load(std::memory_order_acquire)) return fRing.TryPop(popped_item);
+            auto remain = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (remain <= 0) return false;
+            BlockUntilSignal((int)remain);
+        }
+    }
+
+    void Stop() override {
+        fStop.store(true, std::memory_order_release);
+        if (fUseWakeup) Signal();
+    }
+
+    void Restart() override { fStop.store(false, std::memory_order_release); }
+
+    size_t Size() const override { return fRing.Size(); }
+    size_t Capacity() const { return fRing.Capacity(); }
+
+protected:
+    // 소비자 대기: 대기 플래그 게시 -> 재확인 -> eventfd poll (lost wake-up 방지)
+    void BlockUntilSignal(int timeoutMs) {
+        if (!fUseWakeup) {
+            std::this_thread::yield();
+            return;
+        }
+        fWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (fRing.Size() == 0 && !fStop.load(std::memory_order_acquire)) {
+            struct pollfd pfd = { fEventFd, POLLIN, 0 };
+            poll(&pfd, 1, timeoutMs);
+        }
+        fWaiting.store(false, std::memory_order_relaxed);
+        uint64_t drained;
+        if (read(fEventFd, &drained, sizeof(drained)) < 0) { /* EAGAIN: 신호 없음 */ }
+    }
+
+    void Signal() {
+        uint64_t one = 1;
+        if (write(fEventFd, &one, sizeof(one)) < 0) { /* 카운터 포화 시 이미 깨어날 상태 */ }
+    }
+
+    SpscRing<RawBuffer*> fRing;
+    bool fUseWakeup;
+    int  fEventFd;
+    std::atomic<bool> fWaiting;
+    std::atomic<bool> fStop;
+};
+
+#endif
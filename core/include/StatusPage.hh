@@ -0,0 +1,108 @@
+#ifndef STATUSPAGE_HH
+#define STATUSPAGE_HH
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// =========================================================================
+// 💡 [상태 페이지] 실행 파일마다 하나씩 만드는 공유 메모리 상태 구조체 (/dev/shm/nkfadc500_status_<pid>)
+// - GUI/스크립트는 stdout 의 컬러 로그를 정규식으로 긁는 대신 이 페이지를 mmap 하여 원하는 주기로 읽음
+// - 카운터는 Producer/Consumer 가 블록마다 relaxed store 로 직접 갱신 (잠금 없음, 출력 포맷팅 없음)
+// - 지연 백분위 같은 파생 값은 상태 스레드가 0.5 초마다 갱신
+// - 프로세스 종료 시 state = kFinished 로 표시 후 unlink (이미 mmap 한 리더는 마지막 값을 그대로 읽을 수 있음)
+// - 레이아웃은 고정 오프셋 (gui/core/StatusReader.py 와 동일하게 유지), 모든 값은 little-endian
+// =========================================================================
+static const uint32_t kStatusMagic   = 0x54534B4E;   // "NKST" (little-endian)
+static const uint16_t kStatusVersion = 1;
+static const uint32_t kStatusMaxBoards = 8;
+static const uint32_t kStatusLiveUnknown = 0xFFFFFFFF;   // live 비율 필드: 보드 카운터 샘플 없음
+
+struct StatusPageHeader {
+    uint32_t magic;                        //   0 : kStatusMagic
+    uint16_t version;                      //   4 : kStatusVersion
+    uint16_t kind;                         //   6 : StatusPage::Kind
+    uint32_t headerBytes;                  //   8 : sizeof(StatusPageHeader)
+    uint32_t boardBytes;                   //  12 : sizeof(StatusPageBoard)
+    uint32_t maxBoards;                    //  16
+    std::atomic<uint32_t> nBoards;         //  20
+    std::atomic<uint32_t> state;           //  24 : StatusPage::State
+    int32_t  pid;                          //  28
+    uint64_t startUnixNs;                  //  32
+    std::atomic<uint64_t> heartbeatNs;     //  40 : 마지막 갱신 시각 (unix ns, 상태 스레드)
+    std::atomic<uint64_t> events;          //  48 : 전체 이벤트 (수집/처리)
+    std::atomic<uint64_t> bytes;           //  56 : 전체 원본 바이트 (수집: USB 수신, production: 읽은 파일 위치)
+    std::atomic<uint64_t> storedBytes;     //  64 : 디스크에 기록된 바이트 (압축 후)
+    std::atomic<uint64_t> progressDone;    //  72 : production: 진행량 (progressTotal 과 같은 단위)
+    std::atomic<uint64_t> progressTotal;   //  80 : 0 이면 진행률 없음
+    std::atomic<uint32_t> subrun;          //  88 : 현재 서브런 (롤오버 미사용 시 0)
+    std::atomic<uint32_t> errors;          //  92 : 프레이밍 + USB + 디스크 기록 오류 합계
+    std::atomic<uint64_t> daqCpuMask;      //  96 : frontend: Producer/Consumer 전용 코어 (다른 프로세스는 피함)
+    uint8_t  reserved[24];                 // 104
+};
+
+struct StatusPageBoard {
+    int32_t  mid;                          //   0
+    std::atomic<uint32_t> dataQueue;       //   4 : Producer -> Consumer 대기 블록 수
+    std::atomic<uint32_t> freeQueue;       //   8 : 남은 빈 버퍼 수
+    uint32_t poolBuffers;                  //  12 : 버퍼 풀 전체 개수
+    std::atomic<uint64_t> bytes;           //  16 : USB 로 받은 바이트
+    std::atomic<uint64_t> storedBytes;     //  24
+    std::atomic<uint64_t> events;          //  32
+    std::atomic<uint64_t> framingErrors;   //  40
+    std::atomic<uint64_t> poolExhausted;   //  48
+    std::atomic<uint64_t> poolWaitNs;      //  56
+    std::atomic<uint64_t> usbTransfers;    //  64
+    std::atomic<uint64_t> usbErrors;       //  72
+    std::atomic<uint64_t> writeErrors;     //  80
+    std::atomic<uint32_t> usbP50Us;        //  88
+    std::atomic<uint32_t> usbP99Us;        //  92
+    std::atomic<uint32_t> writeP50Us;      //  96
+    std::atomic<uint32_t> writeP99Us;      // 100
+    std::atomic<uint32_t> liveInstPpm;     // 104 : 직전 live time 샘플 구간의 live 비율 (ppm, kStatusLiveUnknown: 없음)
+    std::atomic<uint32_t> liveCumPpm;      // 108 : 런 시작부터 누적 live 비율 (ppm)
+    std::atomic<uint64_t> hwTriggers;      // 112 : 보드 트리거 카운터 (채널 최대값)
+    std::atomic<uint64_t> divertedEvents;  // 120 : 백프레셔로 .dat 대신 버림/spill/특징량 처리한 이벤트
+};
+
+static_assert(sizeof(StatusPageHeader) == 128, "StatusPageHeader must be 128 bytes");
+static_assert(sizeof(StatusPageBoard) == 128, "StatusPageBoard must be 128 bytes");
+
+class StatusPage {
+public:
+    enum Kind  { kFrontend = 1, kProduction = 2, kMonitor = 3 };
+    enum State { kStarting = 0, kRunning = 1, kFinished = 2, kFailed = 3 };
+
+    StatusPage();
+    ~StatusPage();
+
+    // 공유 메모리를 만들 수 없으면 프로세스 내부 메모리로 대체 (Create 이후 항상 유효한 포인터)
+    bool Create(Kind kind);
+    void Close(State finalState = kFinished);
+
+    bool IsShared() const { return fShared; }
+
+    StatusPageHeader* Header() { return fHeader; }
+    // 범위를 벗어난 보드는 공유되지 않는 scratch 항목 (호출 측 null 검사 불필요)
+    StatusPageBoard*  Board(int i) { return (i >= 0 && (uint32_t)i < kStatusMaxBoards) ? &fBoards[i] : &fScratch; }
+
+    void SetState(State s) { fHeader->state.store(s, std::memory_order_release); }
+    void Heartbeat();
+
+    static std::string NameFor(int pid);   // "/nkfadc500_status_<pid>"
+
+    // 실행 중인 frontend 들이 전용으로 잡은 코어 (모든 페이지의 daqCpuMask 합집합)
+    static uint64_t ActiveDaqCpuMask();
+
+private:
+    std::string       fName;
+    void*             fMap;
+    size_t            fMapBytes;
+    bool              fShared;
+    StatusPageHeader* fHeader;
+    StatusPageBoard*  fBoards;
+    StatusPageBoard   fScratch;
+};
+
+#endif
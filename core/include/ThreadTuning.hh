@@ -0,0 +1,36 @@
+#ifndef THREADTUNING_HH
+#define THREADTUNING_HH
+
+#include <string>
+#include <cstdint>
+
+// 스레드 종료 직전의 스케줄링 상태 (런 요약 출력용)
+struct ThreadSchedInfo {
+    bool        valid = false;
+    std::string cpus;              // 실제 affinity ("2", "0-1,4-7")
+    int         policy = 0;        // SCHED_OTHER / SCHED_FIFO ...
+    int         priority = 0;
+    long        voluntarySwitches = 0;     // 대기(I/O, 큐)로 스스로 양보한 횟수
+    long        involuntarySwitches = 0;   // 다른 스레드/프로세스에 선점된 횟수
+
+    const char* PolicyName() const;
+};
+
+// =========================================================================
+// 💡 [스레드 배치] 호출한 스레드 자신의 CPU affinity / 실시간 스케줄링 설정
+// - Producer/Consumer 는 전용 코어에 고정, 그 외 스레드(압축 풀, 상태, 퍼블리셔)와
+//   같은 머신의 GUI/모니터/production 은 그 코어들을 피함 (mask 는 CPU 0..63)
+// - SCHED_FIFO 는 CAP_SYS_NICE 또는 RLIMIT_RTPRIO 가 있어야 적용됨 (실패 시 false, 일반 스케줄링 유지)
+// =========================================================================
+class ThreadTuning {
+public:
+    static bool PinToCpu(int cpu);
+    static bool AvoidCpus(uint64_t mask);     // 현재 허용 집합에서 mask 코어 제외 (남는 코어가 없으면 그대로)
+    static bool SetRealtime(int priority);    // SCHED_FIFO, priority 1..99
+    static void SetName(const std::string& name);
+
+    static ThreadSchedInfo Sample();
+    static int  GetCpuCount();
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef THRESHOLDSCAN_HH
+#define THRESHOLDSCAN_HH
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+#include "DaqDevice.hh"
+#include "FadcBD.hh"
+#include "DaqOptions.hh"
+
+// 보드 1대의 THR 대 트리거율 표
+struct ThresholdScanResult {
+    int mid;
+    std::vector<int> thresholds;
+    std::vector<double>   rateHz[4];   // thresholds 와 같은 순서
+    std::vector<uint64_t> counts[4];   // 측정 창 안의 트리거 수
+    bool fromCounters;                 // false: 카운터 미지원 장치 (읽어 낸 데이터 / 이벤트 크기, 벽시계 기준)
+    double seconds;                    // 스캔 전체 소요 시간
+
+    ThresholdScanResult() : mid(0), fromCounters(true), seconds(0) {}
+
+    // 그 위의 모든 점까지 트리거율이 targetHz 이하인 가장 낮은 THR (스캔 범위 안에서 없으면 -1)
+    int Pick(int ch, double targetHz) const;
+};
+
+// =========================================================================
+// 💡 [문턱값 스캔] 장치를 한 번 켜 둔 채 채널별 THR 을 단계마다 바꾸며 보드 카운터로 트리거율 측정
+// - 단계마다 THR 레지스터 1개만 씀 (DaqDevice::ApplyLiveChange). 스캔 중이 아닌 채널은 THR 4095 로 막아
+//   다른 채널의 트리거가 데드타임을 만들지 않게 함
+// - 측정: SCAN_WINDOW_MS 창 앞뒤의 채널 트리거 카운터 / live time 차이. 보드 DRAM 은 차지 않을 만큼만 읽어서 버림 (파일 기록 없음)
+// - 카운터를 지원하지 않는 장치는 읽어 낸 바이트를 이벤트 크기로 나눈 값 (벽시계 기준, 채널 구분 없음)
+// - 끝나면 (중단 포함) 원래 THR 로 되돌리고 장치 정지
+// =========================================================================
+class ThresholdScan {
+public:
+    ThresholdScan(DaqDevice* device, FadcBD* bdConfig, const DaqOptions& options);
+    ~ThresholdScan();
+
+    // first ~ last (step 간격) 를 채널 0~3 차례로 스캔. abort 가 켜지면 현재 단계에서 멈추고 false
+    bool Run(int first, int last, int step, ThresholdScanResult& result, const std::atomic<bool>& abort);
+
+    // 표 출력 / 파일 저장. targetHz > 0 이면 채널별 제안 THR 을 설정 파일 형식 (THR 줄) 으로 덧붙임
+    static void Print(const std::vector<ThresholdScanResult>& results, double targetHz);
+    static bool Save(const std::string& path, const std::vector<ThresholdScanResult>& results, double targetHz);
+
+private:
+    void SetThreshold(int ch, int value);
+    bool Measure(int ch, double& rateHz, uint64_t& count, bool& fromCounters);
+    uint64_t Drain(unsigned int minKB);
+
+    DaqDevice* fDevice;
+    FadcBD*    fConfig;
+    DaqOptions fOptions;
+    size_t     fEventBytes;
+    std::vector<unsigned char> fScratch;   // 읽어서 버리는 보드 DRAM 데이터
+};
+
+#endif
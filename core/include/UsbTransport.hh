@@ -0,0 +1,110 @@
+#ifndef USBTRANSPORT_HH
+#define USBTRANSPORT_HH
+
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+
+struct libusb_device_handle;
+struct libusb_transfer;
+
+// 비동기 bulk IN 전송 1건의 상태 (AsyncUsbReader 가 슬롯 단위로 재사용)
+struct UsbTransfer {
+    unsigned char* buffer = nullptr;
+    int  length = 0;
+    int  actual = 0;
+    int  status = 0;          // 0: 정상 완료, 그 외: libusb_transfer_status 값
+    bool done   = false;
+    std::chrono::steady_clock::time_point submitTime;
+    std::chrono::steady_clock::time_point doneTime;
+    void* backend = nullptr;  // 전송 계층 전용 핸들 (libusb_transfer* 등)
+};
+
+// 💡 FX3 bulk 파이프라인 추상화: 실제 libusb 백엔드와 보드 없는 시뮬레이션 백엔드를 교체 가능
+class UsbTransport {
+public:
+    virtual ~UsbTransport() {}
+
+    // FADC DRAM 에서 countWords(4바이트 word) 만큼 읽겠다는 8바이트 요청 명령 (동기)
+    virtual int  SendReadCommand(uint32_t countWords, uint32_t addr) = 0;
+
+    // 비동기 bulk IN 전송 제출. 완료 시 xfer->done 이 true 가 됨
+    virtual int  Submit(UsbTransfer* xfer) = 0;
+
+    // 완료 이벤트 처리 (최대 timeoutMs 블록). 호출 스레드에서 done 플래그가 갱신됨
+    virtual int  HandleEvents(int timeoutMs) = 0;
+
+    virtual void Cancel(UsbTransfer* xfer) = 0;
+
+    // 슬롯 해제 시 백엔드 자원 정리
+    virtual void Release(UsbTransfer* xfer) {}
+
+    // 동기 bulk IN 전송: dest 로 바로 수신 (기본 구현은 Submit + HandleEvents 대기)
+    virtual int  ReadBulk(unsigned char* dest, int length, int* actual);
+
+    // 레지스터 쓰기 명령 count 개 (각 8바이트, USB3Write 포맷) 를 bulk OUT 전송 1번으로 보냄. 미지원 백엔드는 -1
+    virtual int  WriteCommands(const unsigned char* cmds, int count) { (void)cmds; (void)count; return -1; }
+
+    // USB3Write 와 같은 8바이트 쓰기 명령 (data, addr 순 little-endian, addr 최상위 비트 0 = write)
+    static void EncodeWrite(unsigned char* cmd, uint32_t addr, uint32_t data);
+};
+
+// libusb 비동기 API 백엔드 (nkusb 가 연 device handle 을 공유)
+class LibusbTransport : public UsbTransport {
+public:
+    LibusbTransport(libusb_device_handle* devh, unsigned int timeoutMs = 1000);
+    ~LibusbTransport() override;
+
+    int  SendReadCommand(uint32_t countWords, uint32_t addr) override;
+    int  Submit(UsbTransfer* xfer) override;
+    int  HandleEvents(int timeoutMs) override;
+    void Cancel(UsbTransfer* xfer) override;
+    void Release(UsbTransfer* xfer) override;
+    int  ReadBulk(unsigned char* dest, int length, int* actual) override;
+    int  WriteCommands(const unsigned char* cmds, int count) override;
+
+private:
+    static void OnTransferDone(libusb_transfer* transfer);
+
+    libusb_device_handle* fDevh;
+    unsigned int fTimeoutMs;
+};
+
+// 💡 보드 없이 엔진을 검증/벤치마크하기 위한 가상 FX3 파이프
+// 전송은 제출 순서대로 직렬 처리되며, 파이프가 비어 있다가 새 전송이 도착하면
+// turnaround 지연이 추가됩니다 (동기 전송 시 매 청크마다 엔드포인트가 노는 상황 재현).
+// 데이터는 요청 명령 기준 word 인덱스(uint32)로 채워져 조립 순서를 검증할 수 있습니다.
+class SimUsbTransport : public UsbTransport {
+public:
+    SimUsbTransport(double bandwidthMBps = 400.0, int turnaroundUs = 50, bool fillPattern = true);
+    ~SimUsbTransport() override;
+
+    int  SendReadCommand(uint32_t countWords, uint32_t addr) override;
+    int  Submit(UsbTransfer* xfer) override;
+    int  HandleEvents(int timeoutMs) override;
+    void Cancel(UsbTransfer* xfer) override;
+
+private:
+    void PipeWorker();
+
+    double fBytesPerUs;
+    int    fTurnaroundUs;
+    bool   fFillPattern;
+
+    uint32_t fWordCursor;   // 현재 요청 명령 내 다음 word 인덱스
+    uint32_t fWordsLeft;
+
+    std::thread fThread;
+    std::mutex fMutex;
+    std::condition_variable fPipeCv;
+    std::condition_variable fDoneCv;
+    std::deque<UsbTransfer*> fPending;
+    std::deque<UsbTransfer*> fCompleted;
+    std::atomic<bool> fStop;
+};
+
+#endif
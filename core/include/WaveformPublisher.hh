@@ -0,0 +1,52 @@
+#ifndef WAVEFORMPUBLISHER_HH
+#define WAVEFORMPUBLISHER_HH
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+#include "LiveRing.hh"
+
+// =========================================================================
+// 💡 [파형 퍼블리셔] GUI 의 ZmqWorker (gui/core/ZmqWorker.py) 가 구독하는 ZeroMQ PUB 소켓
+// - 메시지 1개 = [uint32 ch_id][uint16 samples...] (little-endian, 12-bit ADC 값), 채널마다 1개씩
+// - 라이브 이벤트 링에서 가장 최근 이벤트만 꺼내 maxHz 이하로 솎아 전송 (Acquisition 스레드는 관여하지 않음)
+// - 구독자가 느려 송신 큐(SNDHWM)가 차면 기다리지 않고 버림
+// - libzmq 가 빌드에 포함된 경우만 동작 (NKFADC_HAVE_ZMQ)
+// =========================================================================
+class WaveformPublisher {
+public:
+    // port: tcp://127.0.0.1:<port> 에 bind, mid: 다중 보드에서 보낼 보드 (-1: 링의 최신 블록)
+    WaveformPublisher(int port, int maxHz, int mid = -1, const std::string& ringName = kLiveRingDefaultName);
+    ~WaveformPublisher();
+
+    bool Start();
+    void Stop();
+
+    static bool Available();
+
+    uint64_t GetSent() const    { return fSent; }      // 보낸 파형 프레임 (채널 4개 = 1 프레임)
+    uint64_t GetDropped() const { return fDropped; }   // 송신 큐가 차서 버린 메시지
+
+private:
+    void Worker();
+    bool PublishEvent(const unsigned char* event, uint64_t eventBytes);
+
+    int         fPort;
+    int         fMaxHz;
+    int         fMid;
+    std::string fRingName;
+
+    void* fContext;
+    void* fSocket;
+
+    std::thread       fThread;
+    std::atomic<bool> fRunning;
+    std::atomic<uint64_t> fSent;
+    std::atomic<uint64_t> fDropped;
+    std::vector<unsigned char> fMsg;
+};
+
+#endif
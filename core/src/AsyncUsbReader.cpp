@@ -0,0 +1,100 @@
+#include "AsyncUsbReader.hh"
+#include "ELog.hh"
+
+#include <algorithm>
+
+AsyncUsbReader::AsyncUsbReader(UsbTransport* transport, int depth, size_t chunkBytes)
+    : fTransport(transport), fChunkBytes(chunkBytes), fTotalBytes(0), fTotalTransfers(0), fErrors(0)
+{
+    if (depth < 1) depth = 1;
+    // FX3 bulk 최대 패킷(1KB) 경계 유지
+    if (fChunkBytes < 1024) fChunkBytes = 1024;
+    fChunkBytes -= fChunkBytes % 1024;
+    fSlots.resize(depth);
+}
+
+AsyncUsbReader::~AsyncUsbReader() {
+    for (auto& slot : fSlots) fTransport->Release(&slot);
+}
+
+void AsyncUsbReader::ResetStats() {
+    fLatency.Reset();
+    fTotalBytes = 0;
+    fTotalTransfers = 0;
+    fErrors = 0;
+}
+
+int AsyncUsbReader::Read(unsigned char* dest, size_t bytes, uint32_t addr) {
+    if (bytes == 0) return 0;
+
+    int rc = fTransport->SendReadCommand((uint32_t)(bytes / 4), addr);
+    if (rc < 0) {
+        fErrors++;
+        ELog::Print(ELog::ERROR, Form("[USB ASYNC] Read request failed (error = %d)", rc));
+        return rc;
+    }
+
+    const int nSlots = (int)fSlots.size();
+    size_t submitted = 0;
+    size_t completed = 0;
+    int head = 0, tail = 0, inFlight = 0;
+
+    auto submitNext = [&]() -> int {
+        UsbTransfer& x = fSlots[tail];
+        x.buffer = dest + submitted;
+        x.length = (int)std::min(fChunkBytes, bytes - submitted);
+        int st = fTransport->Submit(&x);
+        if (st < 0) return st;
+        submitted += x.length;
+        tail = (tail + 1) % nSlots;
+        inFlight++;
+        return 0;
+    };
+
+    // 1. 파이프라인 채우기: depth 개의 전송을 한꺼번에 걸어둠
+    while (inFlight < nSlots && submitted < bytes) {
+        if ((rc = submitNext()) < 0) break;
+    }
+
+    // 2. 완료 순서(FIFO)대로 회수하면서 빈 슬롯에 다음 청크를 즉시 재제출
+    while (rc >= 0 && inFlight > 0) {
+        UsbTransfer& x = fSlots[head];
+        while (!x.done) fTransport->HandleEvents(100);
+
+        head = (head + 1) % nSlots;
+        inFlight--;
+
+        fLatency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(x.doneTime - x.submitTime).count());
+
+        if (x.status != 0 || x.actual != x.length) {
+            ELog::Print(ELog::ERROR, Form("[USB ASYNC] Transfer failed (status = %d, %d/%d bytes)", x.status, x.actual, x.length));
+            rc = -1;
+            break;
+        }
+
+        completed += x.actual;
+        fTotalTransfers++;
+
+        if (submitted < bytes) rc = submitNext();
+    }
+
+    if (rc < 0) {
+        fErrors++;
+        DrainInFlight(head, inFlight);
+        return rc;
+    }
+
+    fTotalBytes += completed;
+    return 0;
+}
+
+void AsyncUsbReader::DrainInFlight(int head, int inFlight) {
+    // 오류 발생 시 남은 전송을 모두 취소하고 콜백이 돌아올 때까지 회수 (버퍼 재사용 안전 보장)
+    const int nSlots = (int)fSlots.size();
+    for (int i = 0; i < inFlight; i++) fTransport->Cancel(&fSlots[(head + i) % nSlots]);
+
+    for (int i = 0; i < inFlight; i++) {
+        UsbTransfer& x = fSlots[(head + i) % nSlots];
+        for (int retry = 0; retry < 50 && !x.done; retry++) fTransport->HandleEvents(100);
+    }
+}
@@ -1,5 +1,13 @@
 #include "BinaryDaqManager.hh" // 💡 누락되었던 클래스 정의 헤더 추가
-#include "Fadc500Device.hh"
+#include "DaqDevice.hh"
+#include "AsyncUsbReader.hh"
+#include "SpscRing.hh"
+#include "AdaptivePoller.hh"
+#include "DataFormat.hh"
+#include "RawWriter.hh"
+#include "EventFramer.hh"
+#include "EventIndex.hh"
+#include "BlockCodec.hh"
 #include "ELog.hh"
 
 #include <iostream>
@@ -11,202 +19,1645 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <cerrno>
+#include <vector>
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <memory>
 
-BinaryDaqManager::BinaryDaqManager(RunInfo* runInfo) 
-    : fRunInfo(runInfo), fDevice(nullptr), fIsRunning(false) 
+// 💡 QUEUE_TYPE 에 따라 Producer/Consumer 전달 큐 구현체 선택
+static BufferQueue* CreateBufferQueue(const DaqOptions& options) {
+    if (options.queueType == DaqOptions::kQueueSpsc) {
+        return new SpscBufferQueue(1024, options.queueWakeup != 0);
+    }
+    return new RawBufferPool();
+}
+
+// 확장자 앞에 접미사 삽입: run.dat + "_b1" -> run_b1.dat
+static std::string AppendToStem(const std::string& base, const std::string& suffix) {
+    size_t dotPos = base.find_last_of('.');
+    size_t slashPos = base.find_last_of('/');
+    if (dotPos == std::string::npos || (slashPos != std::string::npos && dotPos < slashPos)) {
+        return base + suffix;
+    }
+    return base.substr(0, dotPos) + suffix + base.substr(dotPos);
+}
+
+// 다중 보드 + 보드별 파일 모드: run.dat -> run_b1.dat, run_b2.dat ...
+static std::string BoardFileName(const std::string& base, int mid) {
+    return AppendToStem(base, "_b" + std::to_string(mid));
+}
+
+// 서브런 롤오버: run.dat -> run_001.dat, run_002.dat ... (GUI Long-Term 런의 파일명 규칙과 동일)
+static std::string SubrunFileName(const std::string& base, int subrun) {
+    return AppendToStem(base, Form("_%03d", subrun));
+}
+
+// 💡 [서브런 롤오버] 다음 서브런 파일을 백그라운드 스레드에서 미리 열어 둠 (open/io_uring 초기화를 핫패스에서 제거)
+struct SubrunOutput {
+    std::string path;
+    std::string indexPath;
+    RawWriter* writer = nullptr;          // 열기 실패 시 nullptr
+    EventIndexWriter* index = nullptr;
+};
+
+static SubrunOutput* OpenSubrunOutput(DaqOptions options, std::string path, std::string indexPath, int mid, bool blockRecords) {
+    SubrunOutput* out = new SubrunOutput();
+    out->path = path;
+    out->indexPath = indexPath;
+    out->writer = RawWriter::Create(options);
+    if (!out->writer->Open(path)) {
+        delete out->writer;
+        out->writer = nullptr;
+        return out;
+    }
+    if (!indexPath.empty()) {
+        out->index = new EventIndexWriter();
+        if (!out->index->Open(indexPath, mid, blockRecords)) {
+            delete out->index;
+            out->index = nullptr;
+        }
+    }
+    return out;
+}
+
+// 런 종료로 쓰이지 않은 미리 연 파일은 닫고 삭제
+static void DiscardSubrunOutput(SubrunOutput* out) {
+    if (!out) return;
+    if (out->writer) {
+        out->writer->Close();
+        delete out->writer;
+        std::remove(out->path.c_str());
+    }
+    if (out->index) {
+        out->index->Close();
+        delete out->index;
+        std::remove(out->indexPath.c_str());
+    }
+    delete out;
+}
+
+// 보드 FIFO 에서 한 번에 읽는 최대 블록 (BCOUNT 4096 KB)
+static const size_t kBlockBytes = 4 * 1024 * 1024;
+
+static uint64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 💡 [라이브 재설정] DataFormat::ConfigParam <-> FadcBD 설정 값
+static int GetConfigValue(const FadcBD* cfg, int param, int ch) {
+    switch (param) {
+        case DataFormat::kCfgTHR:    return cfg->GetTHR(ch);
+        case DataFormat::kCfgDLY:    return cfg->GetDLY(ch);
+        case DataFormat::kCfgPSW:    return cfg->GetPSW(ch);
+        case DataFormat::kCfgTRIGEN: return cfg->GetTRIGEN();
+        default:                     return 0;
+    }
+}
+
+static void SetConfigValue(FadcBD* cfg, int param, int ch, int value) {
+    switch (param) {
+        case DataFormat::kCfgTHR:    cfg->SetTHR(ch, value); break;
+        case DataFormat::kCfgDLY:    cfg->SetDLY(ch, value); break;
+        case DataFormat::kCfgPSW:    cfg->SetPSW(ch, value); break;
+        case DataFormat::kCfgTRIGEN: cfg->SetTRIGEN(value); break;
+        default: break;
+    }
+}
+
+BinaryDaqManager::BinaryDaqManager(RunInfo* runInfo, const DaqOptions& options)
+    : fRunInfo(runInfo), fOptions(options), fIsRunning(false), fActiveConsumers(0),
+      fMergedWriter(nullptr), fMergedOffset(0), fRollover(false), fMaxTime(0), fCompressPool(nullptr), fCodec(BlockCodec::kNone),
+      fDaqCpuMask(0), fRtWarned(false), fScanAbort(false), fSummaryPending(false)
 {
-    FadcBD* bdConfig = fRunInfo->GetFadcBD(0);
-    if (!bdConfig) return;
+    // 💡 [스레드 배치] 전용 코어를 먼저 정하고 이 스레드(main)에서 빼 둠
+    // 이후 생성되는 스레드(압축 풀, 상태, 파형 퍼블리셔)는 affinity 를 물려받아 Producer/Consumer 코어를 피함
+    const int nCpus = ThreadTuning::GetCpuCount();
+    for (int i = 0; i < fRunInfo->GetNFadcBD(); i++) {
+        for (int base : {fOptions.producerCpu, fOptions.consumerCpu}) {
+            if (base < 0) continue;
+            int cpu = base + i;
+            if (cpu >= nCpus || cpu >= 64) {
+                ELog::Print(ELog::WARNING, Form("CPU %d for board %d does not exist (%d CPUs). Thread will not be pinned.", cpu, i, nCpus));
+                continue;
+            }
+            fDaqCpuMask |= 1ull << cpu;
+        }
+    }
+    if (fDaqCpuMask != 0) {
+        if (!ThreadTuning::AvoidCpus(fDaqCpuMask)) {
+            ELog::Print(ELog::WARNING, "No CPU left for helper threads outside PRODUCER_CPU/CONSUMER_CPU. They share the DAQ cores.");
+        }
+        std::string placement = "Thread placement:";
+        if (fOptions.producerCpu >= 0) placement += " Producer CPU " + std::to_string(fOptions.producerCpu) + "+,";
+        if (fOptions.consumerCpu >= 0) placement += " Consumer CPU " + std::to_string(fOptions.consumerCpu) + "+,";
+        ELog::Print(ELog::INFO, placement + " helpers on CPU " + ThreadTuning::Sample().cpus);
+    }
 
-    fDevice = new Fadc500Device(bdConfig->GetMID());
-    fDevice->Initialize(bdConfig);
+    // 병합 모드에서는 다른 보드의 Consumer 가 완료된 기록을 회수하며 버퍼를 반납할 수 있으므로
+    // Free 큐는 다중 생산자 안전한 RawBufferPool 을 사용
+    const bool sharedWriter = fOptions.outputMerge != 0 && fRunInfo->GetNFadcBD() > 1;
 
-    // 💡 [병목 픽스 1] 큐(Pool) 사이즈 10개(40MB) -> 64개(256MB)로 대폭 확장하여 버퍼링 Jitter 흡수
-    for (int i = 0; i < 64; i++) { 
-        fFreeQueue.Push(new RawBuffer(4 * 1024 * 1024));
+    // 💡 [블록 압축] 빌드에 포함되지 않은 코덱이면 무압축으로 기록
+    if (fOptions.compression != BlockCodec::kNone) {
+        if (BlockCodec::Available(fOptions.compression)) {
+            fCodec = fOptions.compression;
+            fCompressPool = new CompressionPool(fOptions.compressionThreads);
+            ELog::Print(ELog::INFO, Form("Block compression: %s (level %d, %d threads%s)", BlockCodec::Name(fCodec),
+                                         fOptions.compressionLevel, fCompressPool->GetThreads(),
+                                         fOptions.compressionFilter == BlockCodec::kFilterDelta8 ? ", delta8 filter" : ""));
+        } else {
+            ELog::Print(ELog::WARNING, Form("COMPRESSION %d (%s) is not built into this binary. Writing uncompressed.",
+                                            fOptions.compression, BlockCodec::Name(fOptions.compression)));
+        }
+    }
+
+    // 💡 [상태 페이지] GUI 가 stdout 대신 읽는 공유 메모리 카운터 (실패 시 프로세스 내부 메모리로 대체)
+    if (!fStatus.Create(StatusPage::kFrontend)) {
+        ELog::Print(ELog::WARNING, "Cannot create status page in /dev/shm. GUI falls back to log parsing.");
     }
+    fStatus.Header()->daqCpuMask.store(fDaqCpuMask, std::memory_order_relaxed);
+
+    // 💡 [다중 보드] settings.cfg 의 BOARD 블록마다 장치를 열고 독립된 버퍼 풀을 할당
+    for (int i = 0; i < fRunInfo->GetNFadcBD(); i++) {
+        FadcBD* bdConfig = fRunInfo->GetFadcBD(i);
+        if (!bdConfig) continue;
+
+        BoardContext* bd = new BoardContext();
+        bd->mid = bdConfig->GetMID();
+        bd->dataQueue = CreateBufferQueue(fOptions);
+        bd->freeQueue = sharedWriter ? new RawBufferPool() : CreateBufferQueue(fOptions);
+
+        bd->device = DaqDevice::Create(bd->mid, fOptions);
+        bd->device->Initialize(bdConfig);
+
+        if (fOptions.usbReadMode == DaqOptions::kUsbAsync) {
+            bd->device->EnableAsyncReadout(fOptions.usbAsyncDepth, fOptions.usbChunkKB);
+        } else if (fOptions.usbReadMode == DaqOptions::kUsbDirect) {
+            bd->device->EnableDirectReadout(fOptions.usbChunkKB);
+        }
+
+        // 💡 [병목 픽스 1] 고정 예산(기본 256MB = 4MB x 64)의 Arena 를 Huge Page + mlock + pre-fault 로 미리 확보
+        // 런 초반 첫 접근 page fault / TLB miss 로 인한 백로그 스파이크 제거
+        size_t poolBytes = (size_t)std::max(fOptions.bufferPoolMB, 4) * 1024 * 1024;
+        bd->arena = new BufferArena(poolBytes, fOptions.bufferHugePages != 0, fOptions.bufferMlock != 0);
+        if (bd->arena->IsValid()) {
+            bd->poolBuffers = bd->arena->Populate(bd->freeQueue, kBlockBytes);
+            ELog::Print(ELog::INFO, Form("Board MID %d buffer pool: %d x 4 MB (%s pages%s, pre-faulted in %.1f ms)",
+                                         bd->mid, bd->poolBuffers, bd->arena->GetPageModeName(),
+                                         bd->arena->IsLocked() ? ", mlocked" : "", bd->arena->GetPrefaultMs()));
+        } else {
+            // Arena 확보 실패: 동일 예산의 일반 힙 버퍼로 대체
+            for (size_t off = 0; off + kBlockBytes <= poolBytes; off += kBlockBytes) {
+                bd->freeQueue->Push(new RawBuffer(kBlockBytes));
+                bd->poolBuffers++;
+            }
+        }
+        // 압축 결과 버퍼: 압축 중인 블록 + Writer 가 기록 중인 블록만큼 (O_DIRECT 패딩 여유 포함)
+        if (fCompressPool) {
+            bd->zFreeQueue = new RawBufferPool();
+            size_t zBytes = BlockCodec::Bound(fCodec, kBlockBytes) + RawBuffer::kAlign;
+            int nZ = 2 * fCompressPool->GetThreads() + fOptions.writerQueueDepth;
+            for (int k = 0; k < nZ; k++) bd->zFreeQueue->Push(new RawBuffer(zBytes));
+        }
+        const int slot = (int)fBoards.size();
+        if (fOptions.producerCpu >= 0 && (fDaqCpuMask >> (fOptions.producerCpu + slot) & 1)) bd->producerCpu = fOptions.producerCpu + slot;
+        if (fOptions.consumerCpu >= 0 && (fDaqCpuMask >> (fOptions.consumerCpu + slot) & 1)) bd->consumerCpu = fOptions.consumerCpu + slot;
+
+        bd->status = fStatus.Board(slot);
+        bd->status->mid = bd->mid;
+        bd->status->poolBuffers = (uint32_t)bd->poolBuffers;
+        bd->status->freeQueue.store((uint32_t)bd->poolBuffers, std::memory_order_relaxed);
+        bd->status->liveInstPpm.store(kStatusLiveUnknown, std::memory_order_relaxed);
+        bd->status->liveCumPpm.store(kStatusLiveUnknown, std::memory_order_relaxed);
+        fBoards.push_back(bd);
+    }
+    fStatus.Header()->nBoards.store((uint32_t)std::min<size_t>(fBoards.size(), kStatusMaxBoards), std::memory_order_release);
 }
 
 BinaryDaqManager::~BinaryDaqManager() {
     Stop();
-    if (fDevice) delete fDevice;
+    for (BoardContext* bd : fBoards) {
+        delete bd->writer;
+        delete bd->device;
+        delete bd->dataQueue;
+        delete bd->freeQueue;
+        delete bd->zFreeQueue;
+        delete bd->overflow;
+        delete bd->arena;   // 버퍼(RawBuffer) 객체를 모두 지운 뒤 메모리 해제
+        delete bd;
+    }
+    delete fMergedWriter;
+    delete fCompressPool;
+    fStatus.Close();
 }
 
-void BinaryDaqManager::Start(const std::string& outFileName, int maxEvents, int maxTime) {
-    if (fIsRunning) return;
+bool BinaryDaqManager::Start(const std::string& outFileName, int maxEvents, int maxTime) {
+    if (fIsRunning || fBoards.empty()) return false;
+    if (fSummaryPending) Stop();   // 스스로 끝난 이전 런의 스레드 정리 + 요약
+    ResetRunState();
     fIsRunning = true;
-    
+    fOutFileName = outFileName;
+
+    // 단일 보드는 항상 기존과 동일한 태그 없는 스트림으로 기록 (기존 분석 도구 호환)
+    const bool merged = fOptions.outputMerge != 0 && fBoards.size() > 1;
+    if (merged) {
+        fMergedWriter = RawWriter::Create(fOptions);
+        if (!fMergedWriter->Open(outFileName)) {
+            ELog::Print(ELog::ERROR, "Cannot open file " + outFileName);
+            delete fMergedWriter;
+            fMergedWriter = nullptr;
+            fIsRunning = false;
+            return false;
+        }
+    }
+    fMergedOffset = 0;
+    fMaxTime = maxTime;
+
+    // 병합 파일은 모든 보드가 각자의 이벤트 경계에서 동시에 넘어가야 하므로 롤오버 미지원
+    fRollover = (fOptions.rolloverMB > 0 || fOptions.rolloverSec > 0);
+    if (fRollover && merged) {
+        ELog::Print(ELog::WARNING, "ROLLOVER_MB / ROLLOVER_SEC is not supported with OUTPUT_MERGE. Writing a single merged file.");
+        fRollover = false;
+    }
+
+    // 💡 [백프레셔] 잘못된 값이나 SPILL_DIR 없는 spill 은 명시적으로 다른 정책으로 바꿔 알림
+    int policy = fOptions.backpressure;
+    if (policy < DaqOptions::kBackpressureBlock || policy > DaqOptions::kBackpressureFeatures) {
+        ELog::Print(ELog::WARNING, Form("Unknown BACKPRESSURE %d. Using 0 (block).", policy));
+        policy = DaqOptions::kBackpressureBlock;
+    }
+    if (policy == DaqOptions::kBackpressureSpill && fOptions.spillDir.empty()) {
+        ELog::Print(ELog::WARNING, "BACKPRESSURE 2 (spill) needs SPILL_DIR. Using 1 (drop).");
+        policy = DaqOptions::kBackpressureDrop;
+    }
+
+    for (BoardContext* bd : fBoards) {
+        bd->producerDone = false;
+        bd->subrun = fRollover ? 1 : 0;
+        bd->outFileName = BoardOutputPath(bd, bd->subrun);
+        bd->indexFileName.clear();
+        if (fOptions.eventIndex) {
+            bd->indexFileName = merged ? EventIndex::PathFor(outFileName, bd->mid) : EventIndex::PathFor(bd->outFileName);
+        }
+
+        // 보드별 파일은 스레드를 띄우기 전에 열어 실패를 반환값으로 알림 (데몬은 다음 start 를 계속 받음)
+        if (!merged) {
+            bd->writer = RawWriter::Create(fOptions);
+            if (!bd->writer->Open(bd->outFileName)) {
+                ELog::Print(ELog::ERROR, "Cannot open file " + bd->outFileName);
+                // 앞 보드들이 이미 만든 (비어 있는) 파일도 지움
+                for (BoardContext* b : fBoards) {
+                    if (b->writer && b != bd) {
+                        b->writer->Close();
+                        std::remove(b->outFileName.c_str());
+                    }
+                    delete b->writer;
+                    b->writer = nullptr;
+                }
+                fIsRunning = false;
+                return false;
+            }
+        }
+
+        // 💡 [백프레셔] 전환 구간 출력은 서브런과 무관하게 런 전체에 하나 (run.dat -> <SPILL_DIR>/run_spill.dat, run.feat)
+        delete bd->overflow;
+        bd->overflow = nullptr;
+        bd->divertEpisodes = bd->divertedEvents = bd->divertedNs = 0;
+        bd->peakDramKB = 0;
+        if (policy != DaqOptions::kBackpressureBlock) {
+            bd->overflow = new OverflowSink(policy, fOptions.featurePedSamples);
+            const std::string runPath = BoardOutputPath(bd, 0);
+            if (policy == DaqOptions::kBackpressureSpill) {
+                size_t slashPos = runPath.find_last_of('/');
+                std::string name = AppendToStem(slashPos == std::string::npos ? runPath : runPath.substr(slashPos + 1), "_spill");
+                bd->overflow->SetPath(fOptions.spillDir + "/" + name, bd->mid);
+            } else if (policy == DaqOptions::kBackpressureFeatures) {
+                size_t dotPos = runPath.find_last_of('.');
+                size_t slashPos = runPath.find_last_of('/');
+                bool hasExt = dotPos != std::string::npos && (slashPos == std::string::npos || dotPos > slashPos);
+                bd->overflow->SetPath((hasExt ? runPath.substr(0, dotPos) : runPath) + ".feat", bd->mid);
+            }
+        }
+    }
+
+    // 💡 [라이브 이벤트 링] 모니터는 .dat 를 다시 읽지 않고 이 링에서 최신 이벤트를 받음 (실패해도 DAQ 는 계속)
+    if (fOptions.liveRingMB > 0) {
+        if (!fLiveRing.Open(kLiveRingDefaultName, (size_t)fOptions.liveRingMB * 1024 * 1024,
+                            (size_t)std::max(fOptions.liveRingSlotKB, 4) * 1024)) {
+            ELog::Print(ELog::WARNING, Form("Cannot create live event ring /dev/shm%s. Online monitor must tail the file.",
+                                            kLiveRingDefaultName));
+        }
+    }
+
     auto now = std::chrono::system_clock::now();
     std::time_t start_time_t = std::chrono::system_clock::to_time_t(now);
-    
+
     FadcBD* bd = fRunInfo->GetFadcBD(0);
-    
+
     std::cout << "\n\033[1;36m========================================================\033[0m\n";
     std::cout << "\033[1;32m       NKFADC500 Mini Binary DAQ is RUNNING\033[0m\n";
     std::cout << "       [Start Time]  " << std::put_time(std::localtime(&start_time_t), "%Y-%m-%d %H:%M:%S") << "\n";
-    std::cout << "       [Target File] " << outFileName << "\n";
+    if (fBoards.size() == 1 || merged) {
+        std::cout << "       [Target File] " << outFileName << (merged ? " (merged, MID-tagged blocks)" : "") << "\n";
+    } else {
+        for (BoardContext* b : fBoards) std::cout << "       [Target File] " << b->outFileName << " (MID " << b->mid << ")\n";
+    }
+    if (fBoards.size() > 1) std::cout << "       [Boards]      " << fBoards.size() << " x FADC500 Mini (" << fBoards.size() * 4 << " channels)\n";
+    if (fOptions.device == DaqOptions::kDeviceSim) {
+        std::cout << "       [Device]      \033[1;33m" << fBoards[0]->device->GetName() << "\033[0m (" << fOptions.simTriggerHz << " Hz, USB "
+                  << fOptions.simUsbLatencyUs << " us + " << fOptions.simUsbMBps << " MB/s)\n";
+    }
     std::cout << "       [Config (1)]  RL: " << bd->GetRL() << " | TLT: 0x" << std::hex << bd->GetTLT() << std::dec << " | CW: " << bd->GetCW(0) << "\n";
     std::cout << "       [Config (2)]  POL: " << bd->GetPOL(0) << " | DLY: " << bd->GetDLY(0) << " | DACOFF: " << bd->GetDACOFF(0) << "\n";
     std::cout << "       [Config (3)]  THR: " << bd->GetTHR(0) << "\n";
-    
+
+    if (fRollover) {
+        std::cout << "       [Rollover]    ";
+        if (fOptions.rolloverMB > 0) std::cout << fOptions.rolloverMB << " MB";
+        if (fOptions.rolloverMB > 0 && fOptions.rolloverSec > 0) std::cout << " or ";
+        if (fOptions.rolloverSec > 0) std::cout << fOptions.rolloverSec << " sec";
+        std::cout << " per subrun file\n";
+    }
+    if (policy != DaqOptions::kBackpressureBlock) {
+        std::cout << "       [Overflow]    " << OverflowSink::PolicyName(policy);
+        if (!fBoards[0]->overflow->GetPath().empty()) std::cout << " -> " << fBoards[0]->overflow->GetPath() << (fBoards.size() > 1 ? " ..." : "");
+        std::cout << " (resume at " << fOptions.backpressureResumePct << "% free)\n";
+    }
+    if (fLiveRing.IsOpen()) std::cout << "       [Live Ring]   /dev/shm" << kLiveRingDefaultName << " (" << fOptions.liveRingMB << " MB)\n";
     if (maxEvents > 0) std::cout << "       [Limit]       " << maxEvents << " Events\n";
     if (maxTime > 0)   std::cout << "       [Limit]       " << maxTime << " Seconds\n";
     std::cout << "\033[1;36m========================================================\033[0m\n\n";
 
-    fConsumerThread = std::thread(&BinaryDaqManager::ConsumerWorker, this, outFileName, maxEvents);
-    fProducerThread = std::thread(&BinaryDaqManager::ProducerWorker, this, maxTime);
+    fSysStartTime = std::chrono::system_clock::now();
+    fPerfStartTime = std::chrono::steady_clock::now();
+    fSummaryPending = true;
+    fStatus.SetState(StatusPage::kRunning);
+
+    fActiveConsumers = (int)fBoards.size();
+    for (BoardContext* b : fBoards) {
+        b->consumer = std::thread(&BinaryDaqManager::ConsumerWorker, this, b, maxEvents);
+        b->producer = std::thread(&BinaryDaqManager::ProducerWorker, this, b, maxTime);
+    }
+    fStatusThread = std::thread(&BinaryDaqManager::StatusWorker, this);
+    return true;
+}
+
+// 💡 [데몬] 이전 런이 남긴 카운터/Writer/큐 상태를 지움 (장치, 버퍼 풀, 압축 풀은 그대로 재사용)
+void BinaryDaqManager::ResetRunState() {
+    delete fMergedWriter;
+    fMergedWriter = nullptr;
+
+    StatusPageHeader* hdr = fStatus.Header();
+    hdr->startUnixNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    hdr->events.store(0, std::memory_order_relaxed);
+    hdr->bytes.store(0, std::memory_order_relaxed);
+    hdr->storedBytes.store(0, std::memory_order_relaxed);
+    hdr->progressDone.store(0, std::memory_order_relaxed);
+    hdr->progressTotal.store(0, std::memory_order_relaxed);
+    hdr->subrun.store(0, std::memory_order_relaxed);
+    hdr->errors.store(0, std::memory_order_relaxed);
+
+    for (BoardContext* bd : fBoards) {
+        delete bd->writer;
+        bd->writer = nullptr;
+        bd->dataQueue->Restart();
+        bd->freeQueue->Restart();
+
+        bd->poolExhausted = 0;
+        bd->poolWaitNs = 0;
+        bd->writtenBytes = 0;
+        bd->storedBytes = 0;
+        bd->events = 0;
+        bd->framingErrors = 0;
+        bd->truncatedBytes = 0;
+        bd->blockSeq = 0;
+        bd->fileOffset = 0;
+        bd->blockTable.clear();
+        bd->compressLatency.Reset();
+        bd->producerSched = ThreadSchedInfo();
+        bd->consumerSched = ThreadSchedInfo();
+        {
+            std::lock_guard<std::mutex> lock(bd->liveMutex);
+            bd->liveQueue.clear();
+            bd->changeQueue.clear();
+            bd->livePending = false;
+        }
+        bd->liveSamples = 0;
+        bd->changeLog.clear();
+
+        StatusPageBoard* s = bd->status;
+        s->dataQueue.store(0, std::memory_order_relaxed);
+        s->freeQueue.store((uint32_t)bd->freeQueue->Size(), std::memory_order_relaxed);
+        for (std::atomic<uint64_t>* c : {&s->bytes, &s->storedBytes, &s->events, &s->framingErrors, &s->poolExhausted,
+                                         &s->poolWaitNs, &s->writeErrors, &s->hwTriggers, &s->divertedEvents}) {
+            c->store(0, std::memory_order_relaxed);
+        }
+        s->liveInstPpm.store(kStatusLiveUnknown, std::memory_order_relaxed);
+        s->liveCumPpm.store(kStatusLiveUnknown, std::memory_order_relaxed);
+    }
+}
+
+bool BinaryDaqManager::Configure(RunInfo* runInfo, const DaqOptions& options) {
+    if (fIsRunning || fSummaryPending) return false;
+    if (runInfo->GetNFadcBD() != (int)fBoards.size()) {
+        ELog::Print(ELog::ERROR, Form("New configuration has %d boards, the open session has %zu. Restart the daemon to change boards.",
+                                      runInfo->GetNFadcBD(), fBoards.size()));
+        return false;
+    }
+    for (int i = 0; i < runInfo->GetNFadcBD(); i++) {
+        if (!runInfo->GetFadcBD(i) || runInfo->GetFadcBD(i)->GetMID() != fBoards[i]->mid) {
+            ELog::Print(ELog::ERROR, Form("Board %d MID differs from the open session. Restart the daemon to change boards.", i));
+            return false;
+        }
+    }
+
+    // 생성 시 자원(장치/USB 리드아웃/버퍼 풀/압축 풀/코어 배치/큐)을 만든 옵션은 현재 값을 유지
+    // (시뮬레이터는 생성 시 옵션 사본을 가지므로 SIM_* 도 마찬가지)
+    DaqOptions next = options;
+    std::string kept;
+    auto keep = [&kept](int& field, int current, const char* key) {
+        if (field == current) return;
+        field = current;
+        kept += std::string(" ") + key;
+    };
+    keep(next.device, fOptions.device, "DEVICE");
+    keep(next.simTriggerHz, fOptions.simTriggerHz, "SIM_TRIGGER_HZ");
+    keep(next.simPulseAdc, fOptions.simPulseAdc, "SIM_PULSE_ADC");
+    keep(next.simNoiseAdc, fOptions.simNoiseAdc, "SIM_NOISE_ADC");
+    keep(next.simDramMB, fOptions.simDramMB, "SIM_DRAM_MB");
+    keep(next.usbReadMode, fOptions.usbReadMode, "USB_READ_MODE");
+    keep(next.usbAsyncDepth, fOptions.usbAsyncDepth, "USB_ASYNC_DEPTH");
+    keep(next.usbChunkKB, fOptions.usbChunkKB, "USB_CHUNK_KB");
+    keep(next.regBatch, fOptions.regBatch, "REG_BATCH");
+    keep(next.alignCache, fOptions.alignCache, "ALIGN_CACHE");
+    if (next.alignCacheDir != fOptions.alignCacheDir) {
+        next.alignCacheDir = fOptions.alignCacheDir;
+        kept += " ALIGN_CACHE_DIR";
+    }
+    keep(next.queueType, fOptions.queueType, "QUEUE_TYPE");
+    keep(next.queueWakeup, fOptions.queueWakeup, "QUEUE_WAKEUP");
+    keep(next.bufferPoolMB, fOptions.bufferPoolMB, "BUFFER_POOL_MB");
+    keep(next.bufferHugePages, fOptions.bufferHugePages, "BUFFER_HUGEPAGES");
+    keep(next.bufferMlock, fOptions.bufferMlock, "BUFFER_MLOCK");
+    keep(next.compression, fOptions.compression, "COMPRESSION");
+    keep(next.compressionThreads, fOptions.compressionThreads, "COMPRESSION_THREADS");
+    keep(next.outputMerge, fOptions.outputMerge, "OUTPUT_MERGE");
+    keep(next.producerCpu, fOptions.producerCpu, "PRODUCER_CPU");
+    keep(next.consumerCpu, fOptions.consumerCpu, "CONSUMER_CPU");
+    if (!kept.empty()) {
+        ELog::Print(ELog::WARNING, "Keeping the session value of:" + kept + " (restart the daemon to change them).");
+    }
+
+    for (size_t i = 0; i < fBoards.size(); i++) fBoards[i]->device->Initialize(runInfo->GetFadcBD((int)i));
+    fRunInfo = runInfo;
+    fOptions = next;
+    return true;
+}
+
+bool BinaryDaqManager::QueueLiveChange(int mid, int param, int ch, int value, std::string& error) {
+    if (param < DataFormat::kCfgTHR || param > DataFormat::kCfgTRIGEN) {
+        error = "unknown parameter (THR, DLY, PSW, TRIG_ENABLE)";
+        return false;
+    }
+    if (param == DataFormat::kCfgTRIGEN) ch = -1;
+    if (ch < -1 || ch > 3) {
+        error = Form("channel %d out of range (0-3, or all)", ch);
+        return false;
+    }
+    if (value < 0) {
+        error = Form("%s %d must not be negative", DataFormat::ConfigParamName(param), value);
+        return false;
+    }
+    // 스스로 끝난 런은 Producer 가 이미 나갔지만 장치 정리 중일 수 있음 (Stop 후 다시 요청)
+    if (!fIsRunning && fSummaryPending) {
+        error = "run is finishing, stop it first";
+        return false;
+    }
+
+    std::vector<BoardContext*> targets;
+    for (BoardContext* bd : fBoards) {
+        if (mid < 0 || bd->mid == mid) targets.push_back(bd);
+    }
+    if (targets.empty()) {
+        error = Form("no board with MID %d", mid);
+        return false;
+    }
+
+    const LiveChangeRequest request = {param, ch, value};
+    for (BoardContext* bd : targets) {
+        std::lock_guard<std::mutex> lock(bd->liveMutex);
+        bd->changeRequests.push_back(request);
+        bd->changeRequested.store(true, std::memory_order_release);
+    }
+    // 런 사이: Producer 가 없으므로 이 스레드에서 바로 적용 (다음 Start 부터 새 설정, 스트림 기록 없음)
+    if (!fIsRunning) {
+        for (BoardContext* bd : targets) ApplyLiveChanges(bd, 0, 0, false);
+    }
+    return true;
+}
+
+// 요청을 FadcBD 에 반영하고 장치에 씀. 런 중이면 (inRun, Producer 스레드) 변경 기록을 Consumer 에 넘김
+// 레지스터는 BCOUNT 폴링 사이에만 쓰므로 리드아웃과 겹치지 않음. 보드 DRAM 에 있던 dramKB 는 이전 설정의 데이터
+void BinaryDaqManager::ApplyLiveChanges(BoardContext* bd, unsigned int dramKB, uint64_t streamBytes, bool inRun) {
+    std::vector<LiveChangeRequest> requests;
+    {
+        std::lock_guard<std::mutex> lock(bd->liveMutex);
+        requests.swap(bd->changeRequests);
+        bd->changeRequested.store(false, std::memory_order_relaxed);
+    }
+    const size_t index = std::find(fBoards.begin(), fBoards.end(), bd) - fBoards.begin();
+    FadcBD* cfg = fRunInfo->GetFadcBD((int)index);
+    if (!cfg) return;
+
+    std::vector<DataFormat::ConfigChange> changes;
+    for (const LiveChangeRequest& req : requests) {
+        // 채널 전체 요청은 한 번에 쓰고 채널마다 기록 (채널별 이전 값이 다를 수 있음)
+        const int first = req.ch < 0 && req.param != DataFormat::kCfgTRIGEN ? 0 : req.ch;
+        const int last = req.ch < 0 && req.param != DataFormat::kCfgTRIGEN ? cfg->NCHANNEL() - 1 : req.ch;
+        const size_t begin = changes.size();
+        for (int ch = first; ch <= last; ch++) {
+            DataFormat::ConfigChange change;
+            std::memset(&change, 0, sizeof(change));
+            change.param = (uint16_t)req.param;
+            change.channel = (int16_t)ch;
+            change.oldValue = GetConfigValue(cfg, req.param, ch);
+            change.newValue = req.value;
+            changes.push_back(change);
+            SetConfigValue(cfg, req.param, ch, req.value);
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        const bool applied = bd->device->ApplyLiveChange(cfg, req.param, req.ch);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        const uint64_t nowNs = SteadyNowNs();
+        for (size_t i = begin; i < changes.size(); i++) {
+            DataFormat::ConfigChange& change = changes[i];
+            change.timeNs = nowNs;
+            change.streamBytes = streamBytes;
+            change.dramKB = dramKB;
+            change.applied = applied ? 1 : 0;
+            if (!applied) SetConfigValue(cfg, change.param, change.channel, change.oldValue);
+        }
+
+        std::string chName = req.ch < 0 ? (req.param == DataFormat::kCfgTRIGEN ? "board" : "all channels") : "ch " + std::to_string(req.ch);
+        if (applied && inRun) {
+            std::cout << "\n";
+            ELog::Print(ELog::INFO, Form("[MID %d] %s %s -> %d (%.2f ms, %u KB in board DRAM taken with the old value)", bd->mid,
+                                         DataFormat::ConfigParamName(req.param), chName.c_str(), req.value, ms, dramKB));
+        } else if (applied) {
+            ELog::Print(ELog::INFO, Form("[MID %d] %s %s -> %d (%.2f ms)", bd->mid, DataFormat::ConfigParamName(req.param),
+                                         chName.c_str(), req.value, ms));
+        } else {
+            ELog::Print(ELog::WARNING, Form("[MID %d] %s does not support changing %s. Request ignored.", bd->mid,
+                                            bd->device->GetName(), DataFormat::ConfigParamName(req.param)));
+        }
+    }
+    if (!inRun || changes.empty()) return;
+
+    bd->changeLog.insert(bd->changeLog.end(), changes.begin(), changes.end());
+    std::lock_guard<std::mutex> lock(bd->liveMutex);
+    bd->changeQueue.insert(bd->changeQueue.end(), changes.begin(), changes.end());
+    bd->livePending.store(true, std::memory_order_release);
+}
+
+bool BinaryDaqManager::ScanThresholds(int first, int last, int step, std::vector<ThresholdScanResult>& results) {
+    results.clear();
+    if (fIsRunning || fSummaryPending || fBoards.empty()) return false;
+
+    fScanAbort = false;
+    ELog::Print(ELog::INFO, Form("Threshold scan: THR %d-%d step %d, %d ms per point, %zu board(s)", std::min(first, last),
+                                 std::max(first, last), std::max(step, 1), fOptions.scanWindowMs, fBoards.size()));
+
+    // 보드마다 장치가 독립이므로 동시에 스캔 (채널은 보드 안에서 차례로)
+    results.resize(fBoards.size());
+    std::vector<char> complete(fBoards.size(), 0);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < fBoards.size(); i++) {
+        workers.emplace_back([this, i, first, last, step, &results, &complete]() {
+            ThresholdScan scan(fBoards[i]->device, fRunInfo->GetFadcBD((int)i), fOptions);
+            complete[i] = scan.Run(first, last, step, results[i], fScanAbort) ? 1 : 0;
+        });
+    }
+    for (std::thread& t : workers) t.join();
+
+    if (fScanAbort) ELog::Print(ELog::WARNING, "Threshold scan aborted. Partial table follows.");
+    return std::find(complete.begin(), complete.end(), 0) == complete.end();
+}
+
+bool BinaryDaqManager::CalibrateDacOffsets(int targetAdc, std::vector<DacCalibration>& results) {
+    results.clear();
+    if (fIsRunning || fSummaryPending || fBoards.empty()) return false;
+    ELog::Print(ELog::INFO, Form("DACOFF calibration: pedestal target %d +- %d ADC, %d ms settle, %zu board(s)", targetAdc,
+                                 fOptions.dacCalTolerance, fOptions.dacCalSettleMs, fBoards.size()));
+
+    results.resize(fBoards.size());
+    std::vector<char> ok(fBoards.size(), 0);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < fBoards.size(); i++) {
+        workers.emplace_back([this, i, targetAdc, &results, &ok]() {
+            FadcBD* cfg = fRunInfo->GetFadcBD((int)i);
+            ok[i] = fBoards[i]->device->CalibrateDacOffset(cfg, targetAdc, std::max(fOptions.dacCalTolerance, 0), results[i]) ? 1 : 0;
+            if (!ok[i]) {
+                ELog::Print(ELog::ERROR, Form("[MID %d] %s cannot measure pedestals. DACOFF unchanged.", fBoards[i]->mid,
+                                              fBoards[i]->device->GetName()));
+            }
+            // 장치 상태를 새 DACOFF 에 맞춤 (실제 보드는 바뀐 레지스터가 없어 몇 ms, 시뮬레이터는 파형 템플릿 재생성)
+            fBoards[i]->device->Initialize(cfg);
+        });
+    }
+    for (std::thread& t : workers) t.join();
+    return std::find(ok.begin(), ok.end(), 0) == ok.end();
+}
+
+uint64_t BinaryDaqManager::GetEvents() const {
+    uint64_t events = 0;
+    for (const BoardContext* bd : fBoards) events += bd->events;
+    return events;
+}
+
+uint64_t BinaryDaqManager::GetBytes() const {
+    uint64_t bytes = 0;
+    for (const BoardContext* bd : fBoards) bytes += bd->status->bytes.load(std::memory_order_relaxed);
+    return bytes;
 }
 
 void BinaryDaqManager::Stop() {
-    fIsRunning = false; 
-    fDataQueue.Stop();
-    fFreeQueue.Stop();
-    if (fProducerThread.joinable()) fProducerThread.join();
-    if (fConsumerThread.joinable()) fConsumerThread.join();
+    fIsRunning = false;
+    for (BoardContext* bd : fBoards) {
+        bd->dataQueue->Stop();
+        bd->freeQueue->Stop();
+    }
+    for (BoardContext* bd : fBoards) {
+        if (bd->producer.joinable()) bd->producer.join();
+        if (bd->consumer.joinable()) bd->consumer.join();
+    }
+    fStatusCv.notify_all();
+    if (fStatusThread.joinable()) fStatusThread.join();
+    fLiveRing.Close();
+
+    if (fMergedWriter) {
+        // 병합 파일 끝에 모든 보드의 블록 위치 테이블을 파일 순서대로 추가
+        std::vector<DataFormat::BlockTableEntry> table;
+        for (BoardContext* bd : fBoards) {
+            table.insert(table.end(), bd->blockTable.begin(), bd->blockTable.end());
+            bd->blockTable.clear();
+        }
+        if (!table.empty()) {
+            std::sort(table.begin(), table.end(), [](const DataFormat::BlockTableEntry& a, const DataFormat::BlockTableEntry& b) {
+                return a.fileOffset < b.fileOffset;
+            });
+            WriteBlockTable(fMergedWriter, fMergedOffset, table);
+        }
+        fMergedWriter->Close();
+    }
+    if (fSummaryPending) {
+        fSummaryPending = false;
+        PublishStatus();
+        fStatus.SetState(StatusPage::kFinished);
+        fStatus.Heartbeat();
+        PrintRunSummary();
+    }
 }
 
-void BinaryDaqManager::ProducerWorker(int maxTime) {
-    fDevice->StartDAQ();
+// 현재 스레드에 이름/전용 코어/SCHED_FIFO 적용 (실시간 권한이 없으면 한 번만 경고하고 일반 스케줄링으로 계속)
+void BinaryDaqManager::PlaceThread(const std::string& name, int cpu, int priority) {
+    ThreadTuning::SetName(name);
+    if (cpu >= 0 && !ThreadTuning::PinToCpu(cpu)) {
+        ELog::Print(ELog::WARNING, Form("%s: cannot pin to CPU %d.", name.c_str(), cpu));
+    }
+    if (priority > 0 && !ThreadTuning::SetRealtime(priority) && !fRtWarned.exchange(true)) {
+        ELog::Print(ELog::WARNING, Form("SCHED_FIFO priority %d not permitted (needs CAP_SYS_NICE or 'ulimit -r'). Using normal scheduling.", priority));
+    }
+}
+
+void BinaryDaqManager::ProducerWorker(BoardContext* bd, int maxTime) {
+    PlaceThread("nk-prod-" + std::to_string(bd->mid), bd->producerCpu, fOptions.rtPriority);
+
+    DaqDevice* device = bd->device;
+    device->StartDAQ();
     auto start_time = std::chrono::steady_clock::now();
 
+    // 💡 [Live time] 보드 카운터는 BCOUNT 폴링 사이에 읽음 (레지스터 몇 개). DRAM 에 블록 하나 이상 밀려 있으면
+    // 리드아웃을 먼저 하고 최대 한 주기까지 미룸. 시작/종료 시점 샘플로 런 전체 live 비율을 계산
+    // LIVETIME_SAMPLE_MS -1: 하드웨어는 끔 (벤더 read_LIVETIME 이 읽는 레지스터가 카운터인지 보드에서 확인되지 않음)
+    int liveSampleMs = fOptions.liveTimeSampleMs;
+    if (liveSampleMs < 0) liveSampleMs = (fOptions.device == DaqOptions::kDeviceSim) ? 1000 : 0;
+    bool liveTime = liveSampleMs > 0;
+    const uint64_t liveIntervalNs = (uint64_t)std::max(liveSampleMs, 1) * 1000000ull;
+    uint64_t nextLiveNs = 0;
+    unsigned int lastDramKB = 0;
+    DataFormat::LiveTimeSample livePrev;
+    auto sampleLiveTime = [&](unsigned int dramKB) {
+        DeviceCounters counters;
+        if (!device->ReadCounters(counters)) {
+            liveTime = false;
+            return;
+        }
+        DataFormat::LiveTimeSample sample;
+        std::memset(&sample, 0, sizeof(sample));
+        sample.timeNs = SteadyNowNs();
+        sample.liveTicks = counters.liveTicks;
+        std::memcpy(sample.triggers, counters.triggers, sizeof(sample.triggers));
+        sample.dramKB = dramKB;
+        sample.tickNs = (uint32_t)std::max(fOptions.liveTimeTickNs, 1);
+        nextLiveNs = sample.timeNs + liveIntervalNs;
+
+        if (bd->liveSamples == 0) bd->liveFirst = sample;
+        else {
+            double inst = DataFormat::LiveFraction(livePrev, sample);
+            double cum = DataFormat::LiveFraction(bd->liveFirst, sample);
+            // 카운터가 멈춰 있으면 (-1) 0 % 가 아니라 알 수 없음으로 표시
+            bd->status->liveInstPpm.store(inst >= 0 ? (uint32_t)(inst * 1e6) : kStatusLiveUnknown, std::memory_order_relaxed);
+            bd->status->liveCumPpm.store(cum >= 0 ? (uint32_t)(cum * 1e6) : kStatusLiveUnknown, std::memory_order_relaxed);
+        }
+        bd->status->hwTriggers.store(*std::max_element(sample.triggers, sample.triggers + 4), std::memory_order_relaxed);
+        bd->liveLast = livePrev = sample;
+        bd->liveSamples++;
+
+        std::lock_guard<std::mutex> lock(bd->liveMutex);
+        bd->liveQueue.push_back(sample);
+        bd->livePending.store(true, std::memory_order_release);
+    };
+    if (liveTime) sampleLiveTime(0);
+
+    // 💡 고정 sleep(100us/1ms) 대신 관측된 채움 속도 기반 적응형 BCOUNT 폴링
+    AdaptivePoller poller(fOptions.bcountPollMinUs, fOptions.bcountPollMaxUs);
+
+    // 💡 [O_DIRECT] 블록 크기를 4KB 배수로 맞춰 읽어 Writer 가 페이지 캐시 없이 그대로 기록할 수 있게 함
+    // 보드별 파일 모드는 파일 오프셋 자체가 4KB 경계로 돌아오도록 이전 잔여분(misKB)까지 보정
+    const bool alignedReads = fOptions.writerBackend != DaqOptions::kWriterStdio;
+    const bool perBoardFile = (fMergedWriter == nullptr);
+    unsigned int misKB = 0;
+    bool partialWaiting = false;
+    auto partialSince = start_time;
+
+    // 💡 [백프레셔] BACKPRESSURE 1~3: 풀이 바닥나면 기다리지 않고 보드 DRAM 을 계속 비우며 이벤트를 overflow 로 돌림
+    // .dat 스트림이 이벤트 경계에서 끊기도록 Producer 도 헤더만 따라가는 EventFramer 를 돌림
+    // - 전환 시: 마지막으로 기록한 이벤트의 나머지는 예비 버퍼(reserve)에 담아 DataQ 로 보냄
+    // - 복귀 시: 첫 블록 앞부분 (전환 중 시작된 이벤트의 나머지) 은 overflow 로, 그 뒤만 기록
+    // 메모리는 풀 + 전환 중 리드아웃용 블록 1개로 고정
+    OverflowSink* overflow = bd->overflow;
+    EventFramer bpFramer;
+    std::unique_ptr<RawBuffer> scratch;
+    RawBuffer* reserve = nullptr;
+    bool diverting = false;
+    bool completing = false;           // 전환 직후 마지막 기록 이벤트의 나머지를 reserve 에 채우는 중
+    uint64_t divertSince = 0, nextDivertLogNs = 0;
+    const size_t resumeFree = std::max<size_t>(2, (size_t)bd->poolBuffers * std::max(fOptions.backpressureResumePct, 0) / 100);
+    if (overflow) {
+        scratch.reset(new RawBuffer(kBlockBytes));
+        bd->freeQueue->TryPop(reserve);
+    }
+
+    // 전환 구간 블록: 먼저 마지막 기록 이벤트를 마무리하고, 나머지 (완결된 이벤트의 연속) 는 overflow 로
+    auto divertBlock = [&](const unsigned char* data, size_t len) {
+        size_t pos = 0;
+        if (completing) {
+            uint64_t missing = bpFramer.GetMissingBytes();
+            while (missing > 0 && pos < len && reserve->size < reserve->capacity) {
+                size_t take = (size_t)std::min<uint64_t>(std::min<uint64_t>(missing, len - pos), reserve->capacity - reserve->size);
+                std::memcpy(reserve->data + reserve->size, data + pos, take);
+                bpFramer.Feed(data + pos, take);
+                reserve->size += take;
+                pos += take;
+                missing = bpFramer.GetMissingBytes();
+            }
+            if (missing > 0 && reserve->size < reserve->capacity) return;
+            if (missing > 0) {
+                ELog::Print(ELog::ERROR, Form("[MID %d] Event larger than one block at backpressure switch. Stream cut mid-event.", bd->mid));
+            }
+            reserve->stampNs = SteadyNowNs();
+            bd->dataQueue->Push(reserve);
+            reserve = nullptr;
+            completing = false;
+        }
+        if (pos < len) {
+            bd->divertedEvents += bpFramer.Feed(data + pos, len - pos);
+            overflow->Write(data + pos, len - pos);
+        }
+    };
+
+    // USB 지연 백분위는 히스토그램을 채우는 이 스레드에서만 계산 (0.5초마다)
+    StatusPageBoard* status = bd->status;
+    const AsyncUsbReader* usb = device->GetAsyncReader();
+    uint64_t nextUsbStatusNs = 0;
+    uint64_t queuedBytes = 0;   // DataQ 로 넘긴 보드 스트림 (= Consumer 프레이머 위치, 라이브 재설정 경계 기록용)
+
     while (fIsRunning) {
         if (maxTime > 0) {
             auto current_time = std::chrono::steady_clock::now();
             int elapsed = std::chrono::duration_cast<std::chrono::seconds>(current_time - start_time).count();
             if (elapsed >= maxTime) {
-                std::cout << "\n"; 
-                // 💡 ROOT의 Form 대신 순수 C++ 문자열 합치기 사용
-                ELog::Print(ELog::INFO, "Time limit reached (" + std::to_string(maxTime) + " sec). Stopping DAQ...");
-                fIsRunning = false;
+                // 여러 보드가 동시에 만료되어도 안내는 한 번만 출력
+                if (fIsRunning.exchange(false)) {
+                    std::cout << "\n";
+                    // 💡 ROOT의 Form 대신 순수 C++ 문자열 합치기 사용
+                    ELog::Print(ELog::INFO, "Time limit reached (" + std::to_string(maxTime) + " sec). Stopping DAQ...");
+                }
                 break;
             }
         }
 
-        unsigned int raw_bcount = fDevice->ReadBCOUNT();
+        unsigned int raw_bcount = device->ReadBCOUNT();
 
-        if (raw_bcount == 0xFFFFFFFF) { 
+        if (raw_bcount == 0xFFFFFFFF) {
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
             continue;
         }
 
         unsigned int bcount_kb = raw_bcount & 0x0000FFFF;
+        lastDramKB = bcount_kb;
+        if (bcount_kb > bd->peakDramKB) bd->peakDramKB = bcount_kb;
+
+        // 💡 [라이브 재설정] 요청된 레지스터 쓰기는 여기 (BCOUNT 읽은 직후, 리드아웃 전) 에서만
+        if (bd->changeRequested.load(std::memory_order_acquire)) ApplyLiveChanges(bd, bcount_kb, queuedBytes, true);
+
+        if (liveTime) {
+            uint64_t nowNs = SteadyNowNs();
+            if (nowNs >= nextLiveNs && (bcount_kb < kBlockBytes / 1024 || nowNs >= nextLiveNs + liveIntervalNs)) {
+                sampleLiveTime(bcount_kb);
+            }
+        }
 
         if (bcount_kb == 0) {
-            std::this_thread::sleep_for(std::chrono::microseconds(100)); 
+            std::this_thread::sleep_for(std::chrono::microseconds(poller.NextIdleUs()));
             continue;
         }
-        
-        if (bcount_kb > 4096) bcount_kb = 4096;
-        
-        uint32_t total_bytes_to_read = bcount_kb * 1024; 
 
-        // 💡 [병목 픽스 2] 큐 사이즈 백프레셔(Backpressure) 허용치 대폭 상향 (8 -> 50)
-        if (fDataQueue.Size() > 50) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            continue;
+        if (bcount_kb > kBlockBytes / 1024) bcount_kb = kBlockBytes / 1024;
+
+        if (alignedReads) {
+            int alignedKB = (int)((misKB + bcount_kb) / 4 * 4) - (int)misKB;
+            if (alignedKB > 0) {
+                bcount_kb = alignedKB;
+                partialWaiting = false;
+            } else {
+                // 4KB 미만만 쌓인 상태: 잠시 더 모아보고, 100ms 이상 정체되면 그대로 읽음 (Writer 가 일반 pwrite 로 처리)
+                auto now = std::chrono::steady_clock::now();
+                if (!partialWaiting) { partialWaiting = true; partialSince = now; }
+                if (now - partialSince < std::chrono::milliseconds(100)) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(poller.NextIdleUs()));
+                    continue;
+                }
+                partialWaiting = false;
+            }
+            if (perBoardFile) misKB = (misKB + bcount_kb) % 4;
         }
+        poller.OnData(bcount_kb);
+
+        uint32_t total_bytes_to_read = bcount_kb * 1024;
 
+        // 💡 [병목 픽스 2] 백프레셔: 고정 풀이 모두 DataQ/Consumer 에 잡혀 있으면
+        // 1ms sleep 폴링 대신 Consumer 가 버퍼를 반납하는 순간 바로 깨어남 (보드 FIFO 가 그동안 흡수)
+        // 추가 할당은 하지 않고 고갈 횟수/대기 시간만 집계
         RawBuffer* buffer = nullptr;
-        if (!fFreeQueue.TryPop(buffer)) {
-            buffer = new RawBuffer(4 * 1024 * 1024);
+        if (overflow) {
+            // 전환 중: 풀의 RESUME_PCT 이상이 비었을 때만 복귀 시도 (예비 버퍼 + 이번 블록 버퍼)
+            if (diverting && !completing && bd->freeQueue->Size() >= resumeFree &&
+                (reserve || bd->freeQueue->TryPop(reserve)) && !bd->freeQueue->TryPop(buffer)) {
+                buffer = nullptr;
+            }
+            if (!diverting && !bd->freeQueue->TryPop(buffer)) {
+                diverting = true;
+                completing = bpFramer.GetMissingBytes() > 0 && reserve != nullptr;
+                divertSince = SteadyNowNs();
+                bd->divertEpisodes++;
+                bd->poolExhausted++;
+                if (divertSince >= nextDivertLogNs) {
+                    nextDivertLogNs = divertSince + 1000000000ull;
+                    std::cout << "\n";
+                    ELog::Print(ELog::WARNING, Form("[MID %d] Buffer pool exhausted. Backpressure %s until %zu buffers are free (episode %llu).",
+                                                    bd->mid, OverflowSink::PolicyName(overflow->GetPolicy()), resumeFree,
+                                                    (unsigned long long)bd->divertEpisodes));
+                }
+            }
+            if (!buffer) {
+                device->ReadDATA(bcount_kb, scratch->data);
+                divertBlock(scratch->data, total_bytes_to_read);
+                status->bytes.fetch_add(total_bytes_to_read, std::memory_order_relaxed);
+                status->divertedEvents.store(bd->divertedEvents, std::memory_order_relaxed);
+                status->freeQueue.store((uint32_t)bd->freeQueue->Size(), std::memory_order_relaxed);
+                status->poolExhausted.store(bd->poolExhausted, std::memory_order_relaxed);
+                continue;
+            }
+        } else if (!bd->freeQueue->TryPop(buffer)) {
+            uint64_t waitStart = SteadyNowNs();
+            bool got = bd->freeQueue->WaitAndPopFor(buffer, 100);
+            bd->poolExhausted++;
+            bd->poolWaitNs += SteadyNowNs() - waitStart;
+            if (!got) continue;
+        }
+
+        device->ReadDATA(bcount_kb, buffer->data);
+        buffer->size = total_bytes_to_read;
+        status->bytes.fetch_add(total_bytes_to_read, std::memory_order_relaxed);
+
+        if (overflow) {
+            size_t pos = 0;
+            if (diverting) {
+                // 복귀 블록: 전환 중 시작된 이벤트의 나머지까지는 overflow 로
+                uint64_t missing = bpFramer.GetMissingBytes();
+                while (missing > 0 && pos < buffer->size) {
+                    size_t take = (size_t)std::min<uint64_t>(missing, buffer->size - pos);
+                    bd->divertedEvents += bpFramer.Feed(buffer->data + pos, take);
+                    overflow->Write(buffer->data + pos, take);
+                    pos += take;
+                    missing = bpFramer.GetMissingBytes();
+                }
+                status->divertedEvents.store(bd->divertedEvents, std::memory_order_relaxed);
+                if (missing > 0 || pos == buffer->size) {
+                    buffer->size = 0;
+                    bd->freeQueue->Push(buffer);
+                    diverting = missing > 0;
+                    if (!diverting) bd->divertedNs += SteadyNowNs() - divertSince;
+                    continue;
+                }
+                diverting = false;
+                bd->divertedNs += SteadyNowNs() - divertSince;
+                std::memmove(buffer->data, buffer->data + pos, buffer->size - pos);
+                buffer->size -= pos;
+            }
+            bpFramer.Feed(buffer->data, buffer->size);
         }
 
-        if (total_bytes_to_read > buffer->capacity) {
-            delete[] buffer->data;
-            buffer->capacity = total_bytes_to_read + (1024 * 1024); 
-            buffer->data = new unsigned char[buffer->capacity];
+        buffer->stampNs = SteadyNowNs();
+        queuedBytes += buffer->size;
+        bd->dataQueue->Push(buffer);
+
+        status->dataQueue.store((uint32_t)bd->dataQueue->Size(), std::memory_order_relaxed);
+        status->freeQueue.store((uint32_t)bd->freeQueue->Size(), std::memory_order_relaxed);
+        status->poolExhausted.store(bd->poolExhausted, std::memory_order_relaxed);
+        status->poolWaitNs.store(bd->poolWaitNs, std::memory_order_relaxed);
+        if (usb && buffer->stampNs >= nextUsbStatusNs) {
+            nextUsbStatusNs = buffer->stampNs + 500000000ull;
+            const LatencyHistogram& lat = usb->GetLatency();
+            status->usbTransfers.store(usb->GetTotalTransfers(), std::memory_order_relaxed);
+            status->usbErrors.store(usb->GetErrorCount(), std::memory_order_relaxed);
+            status->usbP50Us.store((uint32_t)(lat.PercentileNs(0.50) / 1000), std::memory_order_relaxed);
+            status->usbP99Us.store((uint32_t)(lat.PercentileNs(0.99) / 1000), std::memory_order_relaxed);
         }
+    }
 
-        fDevice->ReadDATA(bcount_kb, buffer->data);
-        buffer->size = total_bytes_to_read;
-        fDataQueue.Push(buffer);
+    if (overflow) {
+        // 전환 중 종료: 마무리하던 이벤트는 받은 만큼 기록 (정상 종료 시 잘린 마지막 이벤트와 동일)
+        if (diverting) bd->divertedNs += SteadyNowNs() - divertSince;
+        if (reserve && completing) bd->dataQueue->Push(reserve);
+        else if (reserve) bd->freeQueue->Push(reserve);
+        overflow->Close();
+        status->divertedEvents.store(bd->divertedEvents, std::memory_order_relaxed);
     }
-    
-    fDevice->StopDAQ();
-    fDataQueue.Stop(); 
+    // 루프를 나온 직후 들어온 요청도 StopDAQ 전에 적용 (Consumer 는 producerDone 전까지 기록을 받음)
+    if (bd->changeRequested.load(std::memory_order_acquire)) ApplyLiveChanges(bd, lastDramKB, queuedBytes, true);
+    if (liveTime) sampleLiveTime(lastDramKB);
+    device->StopDAQ();
+    bd->producerSched = ThreadTuning::Sample();
+    bd->producerDone = true;
+    bd->dataQueue->Stop();
 }
 
-void BinaryDaqManager::ConsumerWorker(const std::string& outFileName, int maxEvents) {
-    FILE* fp = fopen(outFileName.c_str(), "wb");
-    if (!fp) {
-        std::cout << "\n";
-        ELog::Print(ELog::FATAL, "Cannot open file " + outFileName);
-        fIsRunning = false;
-        return;
+void BinaryDaqManager::ConsumerWorker(BoardContext* bd, int maxEvents) {
+    // Consumer 는 Producer 보다 한 단계 낮은 우선순위 (디스크 대기 중에도 Producer 가 먼저 깨어남)
+    PlaceThread("nk-cons-" + std::to_string(bd->mid), bd->consumerCpu, fOptions.rtPriority > 1 ? fOptions.rtPriority - 1 : fOptions.rtPriority);
+
+    RawWriter* writer = fMergedWriter ? fMergedWriter : bd->writer;   // 보드별 파일은 Start 에서 열어 둠
+
+    // Writer 가 기록을 끝낸 버퍼만 Free 큐로 반납 (io_uring 은 커널 완료 시점)
+    BufferQueue* freeQueue = bd->freeQueue;
+    RawWriter::ReleaseFn release = [freeQueue](RawBuffer* buf) {
+        buf->size = 0;
+        buf->nEvents = 0;
+        freeQueue->Push(buf);
+    };
+    BufferQueue* zFreeQueue = bd->zFreeQueue;
+    RawWriter::ReleaseFn releaseZ = [zFreeQueue](RawBuffer* buf) {
+        buf->size = 0;
+        zFreeQueue->Push(buf);
+    };
+
+    // 병합 파일과 압축 파일은 블록마다 레코드(MID 태그 / 압축 정보)를 앞에 붙여 기록
+    const bool blockRecords = (fMergedWriter != nullptr) || (fCompressPool != nullptr);
+
+    // 💡 [이벤트 프레이밍] 블록 경계에 걸친 이벤트를 이어 붙이며 헤더 단위로 정확히 계수
+    EventFramer framer;
+
+    // 💡 [이벤트 인덱스] 프레이밍 중 모은 엔트리를 블록 기록 후 파일 오프셋으로 변환하여 .idx 에 추가
+    // 블록 레코드 파일은 헤더가 시작된 블록의 레코드 위치 + 블록 안 위치로 기록 (헤더는 최대 직전 블록에서 시작)
+    std::unique_ptr<EventIndexWriter> index(new EventIndexWriter());
+    std::vector<DataFormat::IndexEntry> pendingIdx;
+    uint64_t prevStreamStart = 0, prevRecordOffset = 0;
+    if (!bd->indexFileName.empty()) {
+        if (index->Open(bd->indexFileName, bd->mid, blockRecords)) {
+            framer.SetEventCallback([&pendingIdx, &framer](uint64_t streamPos, const unsigned char* hdr) {
+                DataFormat::IndexEntry e;
+                e.offset = streamPos;
+                e.event = framer.GetEvents();
+                e.triggerTime = EventFramer::TriggerTime(hdr);
+                e.recordLength = EventFramer::RecordLength(hdr);
+                e.blockSkip = 0;
+                pendingIdx.push_back(e);
+            });
+        } else {
+            ELog::Print(ELog::WARNING, "Cannot open event index " + bd->indexFileName + ". Continuing without it.");
+            bd->indexFileName.clear();
+        }
     }
 
-    // 💡 [병목 픽스 4] 디스크 I/O Jitter 방지를 위해 16MB C표준 커널 버퍼링 설정
-    setvbuf(fp, NULL, _IOFBF, 16 * 1024 * 1024);
+    // 블록 레코드 페이지: O_DIRECT Writer 면 레코드 뒤를 0으로 채워 본문이 4KB 경계에서 시작하도록 함
+    size_t align = writer->GetAlignment();
+    size_t tagBytes = (align > 1) ? align : sizeof(DataFormat::AuxRecord);
+    std::vector<unsigned char> tagPage(tagBytes, 0);
+    std::vector<unsigned char> zeroPad(align, 0);
 
-    size_t total_written_bytes = 0;
-    int current_events = 0;
-    
-    auto sys_start_time = std::chrono::system_clock::now();
-    auto ui_timer = std::chrono::steady_clock::now();
-    auto perf_start_time = std::chrono::steady_clock::now(); 
-    
-    int last_print_events = 0;
-    size_t last_print_bytes = 0;
+    // 현재 파일의 시작 위치 (보드 스트림 바이트 / 이벤트 번호). 롤오버 시 새 파일 기준으로 다시 잡아
+    // 서브런 파일과 .idx 가 각각 독립적으로 읽히도록 함
+    uint64_t streamBase = 0, eventBase = 0;
 
-    while (fIsRunning || fDataQueue.Size() > 0) {
-        RawBuffer* popBuffer = nullptr;
-        
-        if (fDataQueue.TryPop(popBuffer)) {
-            if (popBuffer && popBuffer->size > 0) {
-                size_t written = fwrite(popBuffer->data, 1, popBuffer->size, fp);
-                total_written_bytes += written;
-                
-                current_events = total_written_bytes / 4096;
-
-                if (maxEvents > 0 && current_events >= maxEvents) {
-                    std::cout << "\n\n"; 
-                    ELog::Print(ELog::INFO, "Target reached! (Est. " + std::to_string(current_events) + " events). Stopping DAQ...");
-                    fIsRunning = false; 
+    auto pollWriter = [this, &writer]() {
+        if (fMergedWriter) {
+            std::lock_guard<std::mutex> lock(fMergedMutex);
+            writer->Poll();
+        } else {
+            writer->Poll();
+        }
+    };
+
+    // 💡 [Live time] Producer 샘플을 kAuxLiveTime 레코드로 기록. 블록 레코드 파일은 블록 사이에 바로,
+    // 보드별(태그 없는) 파일은 이벤트 스트림을 끊지 않도록 모아 두었다가 파일을 닫기 직전 마지막 이벤트 뒤에 기록
+    // 💡 [라이브 재설정] kAuxConfigChange 도 같은 방식. 단, 보드 DRAM 에 남아 있던 (이전 설정) 데이터를 모두 받은 뒤에
+    // 기록하며 events = 그 경계 전까지의 이벤트 수 (다음 이벤트부터 새 설정)
+    std::vector<DataFormat::AuxRecord> auxTrailer;
+    std::vector<DataFormat::ConfigChange> heldChanges;
+    uint64_t liveSeq = 0;
+    auto emitAux = [&](const DataFormat::AuxRecord& aux) {
+        if (!blockRecords) {
+            auxTrailer.push_back(aux);
+            return;
+        }
+        DataFormat::AuxRecord rec = aux;
+        rec.prePadBytes = (uint32_t)(tagBytes - sizeof(rec));
+        std::memcpy(tagPage.data(), &rec, sizeof(rec));
+        if (fMergedWriter) {
+            std::lock_guard<std::mutex> lock(fMergedMutex);
+            writer->AppendCopy(tagPage.data(), tagBytes);
+            fMergedOffset += tagBytes;
+        } else {
+            writer->AppendCopy(tagPage.data(), tagBytes);
+            bd->fileOffset += tagBytes;
+        }
+    };
+    // 경계 (streamBytes + dramKB) 를 지난 변경을 기록. block/streamStart 가 주어지면 그 블록의 헤더 위치로 경계 전 이벤트를 셈
+    // final: 런 종료 시 남은 변경 (경계 데이터가 보드에 남았거나 backpressure 로 돌려진 경우) 은 마지막 이벤트 수로 기록
+    auto releaseChanges = [&](const RawBuffer* block, uint64_t streamStart, bool final) {
+        for (auto it = heldChanges.begin(); it != heldChanges.end();) {
+            const uint64_t boundary = it->streamBytes + (uint64_t)it->dramKB * 1024;
+            if (!final && boundary > framer.GetStreamBytes()) {
+                ++it;
+                continue;
+            }
+            it->events = framer.GetEvents();
+            if (block && boundary >= streamStart) {
+                it->events -= block->eventOffsets.size();
+                for (uint32_t off : block->eventOffsets) {
+                    if (streamStart + off < boundary) it->events++;
                 }
-                
-                popBuffer->size = 0;
-                fFreeQueue.Push(popBuffer); 
             }
+            DataFormat::AuxRecord rec;
+            DataFormat::InitConfigChangeRecord(rec, (uint16_t)bd->mid, liveSeq++, *it);
+            emitAux(rec);
+            it = heldChanges.erase(it);
+        }
+    };
+    auto writeLiveTime = [&]() {
+        if (!bd->livePending.load(std::memory_order_acquire)) return;
+        std::vector<DataFormat::LiveTimeSample> samples;
+        std::vector<DataFormat::ConfigChange> changes;
+        {
+            std::lock_guard<std::mutex> lock(bd->liveMutex);
+            samples.swap(bd->liveQueue);
+            changes.swap(bd->changeQueue);
+            bd->livePending.store(false, std::memory_order_relaxed);
+        }
+        for (DataFormat::LiveTimeSample& sample : samples) {
+            sample.events = framer.GetEvents();
+            DataFormat::AuxRecord rec;
+            DataFormat::InitLiveTimeRecord(rec, (uint16_t)bd->mid, liveSeq++, sample);
+            emitAux(rec);
+        }
+        if (!changes.empty()) {
+            heldChanges.insert(heldChanges.end(), changes.begin(), changes.end());
+            releaseChanges(nullptr, 0, false);
+        }
+    };
+    auto writeLiveTrailer = [&]() {
+        for (const DataFormat::AuxRecord& rec : auxTrailer) {
+            writer->AppendCopy(&rec, sizeof(rec));
+            bd->fileOffset += sizeof(rec);
+        }
+        auxTrailer.clear();
+    };
+
+    // 인덱스 엔트리 확정: 헤더가 이번 블록에서 시작했으면 이번 레코드, 아니면 직전 레코드 기준
+    auto addIndex = [&](std::vector<DataFormat::IndexEntry>& idx, uint64_t streamStart, uint64_t recordOffset) {
+        for (DataFormat::IndexEntry& e : idx) {
+            if (blockRecords) {
+                bool inCur = e.offset >= streamStart;
+                e.blockSkip = (uint32_t)(e.offset - (inCur ? streamStart : prevStreamStart));
+                e.offset = inCur ? recordOffset : prevRecordOffset;
+            } else {
+                e.offset -= streamBase;
+            }
+            e.event -= eventBase;
+            index->Add(e);
+        }
+        idx.clear();
+    };
+
+    // 블록 1개 기록 + 인덱스 엔트리 확정 (압축 여부와 무관하게 보드 스트림 순서대로 호출)
+    auto emitBlock = [&](RawBuffer* payload, const RawWriter::ReleaseFn& rel, int codec, int filter,
+                         uint32_t rawBytes, uint64_t stampNs, uint64_t streamStart, std::vector<DataFormat::IndexEntry>& idx) {
+        const size_t storedBytes = payload->size;
+        uint64_t recordOffset = bd->fileOffset;
+
+        if (blockRecords) {
+            DataFormat::AuxRecord tag;
+            DataFormat::InitAuxRecord(tag, fCompressPool ? DataFormat::kAuxZBlock : DataFormat::kAuxBlockTag,
+                                      (uint16_t)bd->mid, (uint32_t)storedBytes);
+            tag.seq = bd->blockSeq++;
+            tag.timeNs = stampNs;
+            tag.prePadBytes = (uint32_t)(tagBytes - sizeof(tag));
+            tag.padBytes = (uint32_t)((align - storedBytes % align) % align);
+            tag.rawBytes = rawBytes;
+            tag.codec = (uint8_t)codec;
+            tag.filter = (uint8_t)filter;
+            std::memcpy(tagPage.data(), &tag, sizeof(tag));
+
+            // 버퍼에 여유가 있으면 패딩을 본문 뒤에 붙여 한 번의 정렬된 기록으로 처리
+            bool inlinePad = tag.padBytes > 0 && payload->capacity >= storedBytes + tag.padBytes;
+            if (inlinePad) {
+                std::memset(payload->data + storedBytes, 0, tag.padBytes);
+                payload->size += tag.padBytes;
+            }
+            const uint64_t recordBytes = tagBytes + storedBytes + tag.padBytes;
+
+            if (fMergedWriter) {
+                // 병합 모드: [레코드 + 블록]을 하나의 단위로 기록하여 보드 간 블록이 섞이지 않도록 함
+                std::lock_guard<std::mutex> lock(fMergedMutex);
+                recordOffset = fMergedOffset;
+                writer->AppendCopy(tagPage.data(), tagBytes);
+                writer->Append(payload, rel);
+                if (tag.padBytes > 0 && !inlinePad) writer->AppendCopy(zeroPad.data(), tag.padBytes);
+                fMergedOffset += recordBytes;
+            } else {
+                writer->AppendCopy(tagPage.data(), tagBytes);
+                writer->Append(payload, rel);
+                if (tag.padBytes > 0 && !inlinePad) writer->AppendCopy(zeroPad.data(), tag.padBytes);
+                bd->fileOffset += recordBytes;
+            }
+
+            DataFormat::BlockTableEntry te;
+            std::memset(&te, 0, sizeof(te));
+            te.fileOffset = recordOffset;
+            te.rawOffset = streamStart - streamBase;
+            te.rawBytes = rawBytes;
+            te.storedBytes = (uint32_t)storedBytes;
+            te.mid = (uint16_t)bd->mid;
+            te.codec = (uint8_t)codec;
+            bd->blockTable.push_back(te);
+        } else {
+            writer->Append(payload, rel);
+            bd->fileOffset += storedBytes;
+        }
+        bd->storedBytes += storedBytes;
+
+        addIndex(idx, streamStart, recordOffset);
+        prevStreamStart = streamStart;
+        prevRecordOffset = recordOffset;
+    };
+
+    // 💡 [블록 압축] 워커 풀에 제출한 블록을 제출 순서대로 회수하여 기록
+    struct InFlight {
+        CompressionJob job;
+        uint64_t streamStart;
+        uint64_t stampNs;
+        std::vector<DataFormat::IndexEntry> idx;
+    };
+    std::deque<InFlight*> inflight;
+    std::vector<InFlight*> spare;
+    const size_t maxInFlight = fCompressPool ? (size_t)(2 * fCompressPool->GetThreads()) : 0;
+
+    // 완료된 앞쪽 작업을 기록. 진행 중인 작업이 maxKeep 개를 넘으면 가장 오래된 작업의 완료를 기다림
+    auto retire = [&](size_t maxKeep) {
+        while (!inflight.empty()) {
+            InFlight* f = inflight.front();
+            if (inflight.size() > maxKeep) fCompressPool->Wait(&f->job);
+            else if (!fCompressPool->IsDone(&f->job)) break;
+            inflight.pop_front();
+
+            CompressionJob& job = f->job;
+            bd->compressLatency.Record(job.latencyNs);
+            if (job.usedCodec != BlockCodec::kNone) {
+                release(job.raw);
+                emitBlock(job.out, releaseZ, job.usedCodec, job.filter, job.rawBytes, f->stampNs, f->streamStart, f->idx);
+            } else {
+                releaseZ(job.out);
+                emitBlock(job.raw, release, BlockCodec::kNone, job.filter, job.rawBytes, f->stampNs, f->streamStart, f->idx);
+            }
+            spare.push_back(f);
+        }
+    };
+
+    // 💡 [서브런 롤오버] 한도에 도달하면 다음 블록의 첫 이벤트 헤더에서 파일을 나눔
+    // 장치와 Producer 는 그대로 돌고, 다음 파일은 백그라운드에서 미리 열어 둔 것을 넘겨받기만 함
+    bool rolloverActive = fRollover && !fMergedWriter;
+    const uint64_t rolloverBytes = (uint64_t)fOptions.rolloverMB * 1024 * 1024;
+    const uint64_t rolloverNs = (uint64_t)fOptions.rolloverSec * 1000000000ULL;
+    const uint64_t runStartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(fPerfStartTime.time_since_epoch()).count();
+    std::future<SubrunOutput*> nextOutput;
+
+    auto preopenNext = [&]() {
+        std::string path = BoardOutputPath(bd, bd->subrun + 1);
+        std::string idxPath = bd->indexFileName.empty() ? std::string() : EventIndex::PathFor(path);
+        nextOutput = std::async(std::launch::async, OpenSubrunOutput, fOptions, path, idxPath, bd->mid, blockRecords);
+    };
+
+    auto rolloverDue = [&]() {
+        if (rolloverBytes > 0 && bd->fileOffset >= rolloverBytes) return true;
+        // 시간 한도는 런 시작 기준 ROLLOVER_SEC 배수 (런 시간 제한과 겹치는 마지막 경계에서는 넘어가지 않음)
+        if (rolloverNs > 0) {
+            uint64_t boundary = (uint64_t)bd->subrun * rolloverNs;
+            bool lastBoundary = fMaxTime > 0 && boundary >= (uint64_t)fMaxTime * 1000000000ULL;
+            if (!lastBoundary && SteadyNowNs() - runStartNs >= boundary) return true;
+        }
+        return false;
+    };
+
+    // buf 의 첫 이벤트 헤더(split) 앞부분은 이전 파일 끝에, 나머지는 새 파일 처음에 기록되도록 전환
+    auto rollOver = [&](RawBuffer* buf, uint64_t& streamStart) {
+        SubrunOutput* next = nextOutput.get();
+        if (!next->writer) {
+            ELog::Print(ELog::ERROR, "Cannot open next subrun file " + next->path + ". Continuing in " + bd->outFileName);
+            DiscardSubrunOutput(next);
+            rolloverActive = false;
+            return;
+        }
+
+        // 1. 압축 중인 블록을 모두 이전 파일에 기록
+        if (fCompressPool) retire(0);
+
+        // 2. 경계에 걸친 이벤트의 나머지 (split 이전) 를 이전 파일에 기록
+        const uint32_t split = buf->eventOffsets[0];
+        const uint64_t splitPos = streamStart + split;
+        std::vector<DataFormat::IndexEntry> headIdx;
+        auto firstTail = std::find_if(pendingIdx.begin(), pendingIdx.end(),
+                                      [splitPos](const DataFormat::IndexEntry& e) { return e.offset >= splitPos; });
+        headIdx.assign(pendingIdx.begin(), firstTail);
+        pendingIdx.erase(pendingIdx.begin(), firstTail);
+        if (split > 0) {
+            RawBuffer* head = new RawBuffer(split);
+            std::memcpy(head->data, buf->data, split);
+            head->size = split;
+            emitBlock(head, [](RawBuffer* b) { delete b; }, BlockCodec::kNone, BlockCodec::kFilterNone, split,
+                      buf->stampNs, streamStart, headIdx);
         } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            addIndex(headIdx, streamStart, prevRecordOffset);
+        }
+
+        // 3. 이전 파일 마무리 (live time 샘플, 블록 테이블, 남은 비동기 기록 완료) 후 미리 연 파일로 교체
+        writeLiveTrailer();
+        if (blockRecords && !bd->blockTable.empty()) WriteBlockTable(writer, bd->fileOffset, bd->blockTable);
+        bd->blockTable.clear();
+        writer->Close();
+        index->Close();
+
+        const uint64_t fileEvents = framer.GetEvents() - buf->eventOffsets.size() - eventBase;
+        std::cout << "\n";
+        ELog::Print(ELog::INFO, Form("Subrun %d closed: %s (%llu events, %.2f MB). Rollover -> %s",
+                                     bd->subrun.load(), bd->outFileName.c_str(), (unsigned long long)fileEvents,
+                                     bd->fileOffset / 1048576.0, next->path.c_str()));
+
+        next->writer->InheritStats(*writer);
+        delete writer;
+        writer = bd->writer = next->writer;
+        index.reset(next->index ? next->index : new EventIndexWriter());
+        bd->outFileName = next->path;
+        if (!bd->indexFileName.empty()) bd->indexFileName = next->indexPath;
+        bd->fileOffset = 0;
+        bd->subrun++;
+        delete next;
+
+        align = writer->GetAlignment();
+        tagBytes = (align > 1) ? align : sizeof(DataFormat::AuxRecord);
+        tagPage.assign(tagBytes, 0);
+        zeroPad.assign(align, 0);
+
+        // 4. 남은 블록은 새 파일의 첫 블록 (이벤트 헤더로 시작)
+        std::memmove(buf->data, buf->data + split, buf->size - split);
+        buf->size -= split;
+        for (uint32_t& off : buf->eventOffsets) off -= split;
+        streamStart = splitPos;
+        streamBase = splitPos;
+        eventBase = framer.GetEvents() - buf->eventOffsets.size();
+        prevStreamStart = splitPos;
+        prevRecordOffset = 0;
+
+        preopenNext();
+    };
+
+    if (rolloverActive) preopenNext();
+
+    // 디스크 기록 지연 백분위는 Writer 를 다루는 스레드에서만 계산 (병합 모드는 fMergedMutex 안에서, 0.5초마다)
+    StatusPageBoard* status = bd->status;
+    uint64_t nextWriteStatusNs = 0;
+    auto publishWriterStatus = [&]() {
+        auto store = [status](const RawWriter* w) {
+            const LatencyHistogram& lat = w->GetLatency();
+            status->writeErrors.store(w->GetErrorCount(), std::memory_order_relaxed);
+            status->writeP50Us.store((uint32_t)(lat.PercentileNs(0.50) / 1000), std::memory_order_relaxed);
+            status->writeP99Us.store((uint32_t)(lat.PercentileNs(0.99) / 1000), std::memory_order_relaxed);
+        };
+        if (fMergedWriter) {
+            std::lock_guard<std::mutex> lock(fMergedMutex);
+            store(writer);
+        } else {
+            store(writer);
+        }
+    };
+
+    // 정지 요청 후에도 Producer 가 읽고 있던 마지막 블록까지 받아서 기록
+    while (!bd->producerDone || bd->dataQueue->Size() > 0) {
+        RawBuffer* popBuffer = nullptr;
+
+        // 💡 2ms sleep 폴링 제거: 데이터 도착 즉시 깨어나고, 100ms 타임아웃은 종료 확인/완료 회수용
+        if (!bd->dataQueue->WaitAndPopFor(popBuffer, 100)) {
+            if (fCompressPool) retire(maxInFlight);
+            pollWriter();
+            writeLiveTime();
+            continue;
+        }
+        writeLiveTime();
+
+        if (popBuffer && popBuffer->size > 0) {
+            size_t blockBytes = popBuffer->size;
+
+            // Writer/압축에 넘기기 전에 프레이밍 (io_uring 은 Append 직후 버퍼가 반납되고, Delta8 필터는 제자리 변환)
+            uint64_t streamStart = framer.GetStreamBytes();
+            popBuffer->nEvents = (uint32_t)framer.Feed(popBuffer->data, blockBytes, &popBuffer->eventOffsets);
+            if (!heldChanges.empty()) releaseChanges(popBuffer, streamStart, false);
+
+            // 파일 전환은 이 블록 안에서 시작하는 이벤트 헤더가 있고, 다음 파일이 이미 열려 있을 때만
+            if (rolloverActive && !popBuffer->eventOffsets.empty() && rolloverDue() &&
+                nextOutput.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                rollOver(popBuffer, streamStart);
+            }
+
+            // 모니터용 사본은 압축(Delta8 제자리 변환)/기록 전에, 블록의 완결된 이벤트만 슬롯 크기까지
+            if (fLiveRing.IsOpen() && !popBuffer->eventOffsets.empty()) {
+                fLiveRing.Publish(bd->mid, popBuffer->data, popBuffer->size, popBuffer->eventOffsets,
+                                  framer.GetEvents() - popBuffer->eventOffsets.size(), popBuffer->stampNs);
+            }
+
+            if (fCompressPool) {
+                retire(maxInFlight - 1);
+
+                RawBuffer* out = nullptr;
+                while (!zFreeQueue->TryPop(out)) {
+                    // 압축 결과 버퍼는 Writer 완료 시 반납되므로 기다리는 동안 완료를 회수
+                    pollWriter();
+                    if (zFreeQueue->WaitAndPopFor(out, 10)) break;
+                }
+
+                InFlight* f = nullptr;
+                if (spare.empty()) {
+                    f = new InFlight();
+                } else {
+                    f = spare.back();
+                    spare.pop_back();
+                }
+                f->job.raw = popBuffer;
+                f->job.out = out;
+                f->job.codec = fCodec;
+                f->job.level = fOptions.compressionLevel;
+                f->job.filter = fOptions.compressionFilter;
+                f->streamStart = streamStart;
+                f->stampNs = popBuffer->stampNs;
+                f->idx.swap(pendingIdx);
+                inflight.push_back(f);
+                fCompressPool->Submit(&f->job);
+                retire(maxInFlight);
+            } else {
+                emitBlock(popBuffer, release, BlockCodec::kNone, BlockCodec::kFilterNone, (uint32_t)popBuffer->size,
+                          popBuffer->stampNs, streamStart, pendingIdx);
+            }
+
+            bd->writtenBytes += blockBytes;
+            bd->events = framer.GetEvents();
+            bd->framingErrors = framer.GetFramingErrors();
+
+            status->events.store(bd->events, std::memory_order_relaxed);
+            status->framingErrors.store(bd->framingErrors, std::memory_order_relaxed);
+            status->storedBytes.store(bd->storedBytes, std::memory_order_relaxed);
+            status->dataQueue.store((uint32_t)bd->dataQueue->Size(), std::memory_order_relaxed);
+            uint64_t nowNs = SteadyNowNs();
+            if (nowNs >= nextWriteStatusNs) {
+                nextWriteStatusNs = nowNs + 500000000ull;
+                publishWriterStatus();
+            }
+
+            if (maxEvents > 0 && bd->events >= (uint64_t)maxEvents && fIsRunning.exchange(false)) {
+                std::cout << "\n\n";
+                ELog::Print(ELog::INFO, "Target reached! (" + std::to_string(bd->events.load()) + " events). Stopping DAQ...");
+            }
+        }
+    }
+
+    if (fCompressPool) retire(0);
+    for (InFlight* f : spare) delete f;
+    if (nextOutput.valid()) DiscardSubrunOutput(nextOutput.get());
+
+    // 마지막 이벤트가 StopDAQ 시점에 잘렸으면 (BCOUNT 는 KB 단위) 스트림을 직전의 완결된 이벤트에서 끝냄:
+    // 이벤트 수/인덱스에서 빼고, 보드별 파일은 잘린 바이트를 파일에서 잘라 내 trailer 가 이벤트 경계에 오도록 함.
+    // 블록 레코드 파일은 그 바이트가 마지막 블록 안에 남지만 인덱스/이벤트 수에는 들어가지 않음
+    bool partialCounted = false;
+    const uint64_t partial = framer.DropPartial(partialCounted);
+    if (partial > 0) {
+        if (partialCounted) index->DropLast();
+        bd->events = framer.GetEvents();
+        status->events.store(bd->events, std::memory_order_relaxed);
+        bd->truncatedBytes = partial;
+        // 이미 모아 둔 trailer 레코드의 이벤트 수도 버린 이벤트를 빼고 기록
+        for (DataFormat::AuxRecord& rec : auxTrailer) {
+            if (rec.type == DataFormat::kAuxLiveTime) {
+                DataFormat::LiveTimeSample sample = DataFormat::GetLiveTimeSample(rec);
+                sample.events = std::min<uint64_t>(sample.events, bd->events);
+                DataFormat::InitLiveTimeRecord(rec, rec.mid, rec.seq, sample);
+            } else if (rec.type == DataFormat::kAuxConfigChange) {
+                DataFormat::ConfigChange change = DataFormat::GetConfigChange(rec);
+                change.events = std::min<uint64_t>(change.events, bd->events);
+                DataFormat::InitConfigChangeRecord(rec, rec.mid, rec.seq, change);
+            }
+        }
+        if (!fMergedWriter && !blockRecords) {
+            if (writer->Truncate(bd->fileOffset - partial)) {
+                bd->fileOffset -= partial;
+            } else {
+                ELog::Print(ELog::WARNING, Form("[MID %d] Cannot cut the partial last event from %s (%s).",
+                                                bd->mid, bd->outFileName.c_str(), strerror(errno)));
+            }
+        }
+        ELog::Print(ELog::INFO, Form("[MID %d] Last event cut off at stop: dropped %llu bytes after event %llu.",
+                                     bd->mid, (unsigned long long)partial, (unsigned long long)bd->events.load()));
+    }
+    writeLiveTime();
+    releaseChanges(nullptr, 0, true);
+
+    if (!fMergedWriter) {
+        writeLiveTrailer();
+        if (blockRecords && !bd->blockTable.empty()) {
+            WriteBlockTable(writer, bd->fileOffset, bd->blockTable);
+            bd->blockTable.clear();
         }
+        writer->Close();
+    }
+    index->Close();
+    status->storedBytes.store(bd->storedBytes, std::memory_order_relaxed);
+    publishWriterStatus();
+    bd->consumerSched = ThreadTuning::Sample();
+
+    if (--fActiveConsumers == 0) fStatusCv.notify_all();
+}
+
+// 보드별 출력 파일 경로 (subrun > 0 이면 서브런 번호 포함)
+std::string BinaryDaqManager::BoardOutputPath(const BoardContext* bd, int subrun) const {
+    std::string base = (subrun > 0) ? SubrunFileName(fOutFileName, subrun) : fOutFileName;
+    return (fBoards.size() > 1) ? BoardFileName(base, bd->mid) : base;
+}
+
+// 블록 레코드 파일 끝: [kAuxBlockTable 레코드 + BlockTableEntry 배열] + kAuxTableFooter 레코드 (seq = 테이블 위치)
+void BinaryDaqManager::WriteBlockTable(RawWriter* writer, uint64_t offset, const std::vector<DataFormat::BlockTableEntry>& table) {
+    DataFormat::AuxRecord rec;
+    DataFormat::InitAuxRecord(rec, DataFormat::kAuxBlockTable, 0, (uint32_t)(table.size() * sizeof(DataFormat::BlockTableEntry)));
+    writer->AppendCopy(&rec, sizeof(rec));
+    writer->AppendCopy(table.data(), rec.payloadBytes);
+
+    DataFormat::AuxRecord footer;
+    DataFormat::InitAuxRecord(footer, DataFormat::kAuxTableFooter, 0, 0);
+    footer.seq = offset;
+    writer->AppendCopy(&footer, sizeof(footer));
+}
+
+// 상태 페이지 헤더: 보드 항목을 합산한 전체 카운터 + heartbeat (보드 항목은 Producer/Consumer 가 직접 갱신)
+void BinaryDaqManager::PublishStatus() {
+    StatusPageHeader* hdr = fStatus.Header();
+    uint64_t events = 0, bytes = 0, stored = 0, errors = 0;
+    for (BoardContext* bd : fBoards) {
+        const StatusPageBoard* s = bd->status;
+        events += s->events.load(std::memory_order_relaxed);
+        bytes += s->bytes.load(std::memory_order_relaxed);
+        stored += s->storedBytes.load(std::memory_order_relaxed);
+        errors += s->framingErrors.load(std::memory_order_relaxed) + s->usbErrors.load(std::memory_order_relaxed) +
+                  s->writeErrors.load(std::memory_order_relaxed);
+    }
+    hdr->events.store(events, std::memory_order_relaxed);
+    hdr->bytes.store(bytes, std::memory_order_relaxed);
+    hdr->storedBytes.store(stored, std::memory_order_relaxed);
+    hdr->errors.store((uint32_t)errors, std::memory_order_relaxed);
+    hdr->subrun.store((uint32_t)fBoards[0]->subrun.load(), std::memory_order_relaxed);
+    fStatus.Heartbeat();
+}
+
+// 💡 [다중 보드] 모든 보드의 누적 카운터를 모아 0.5초마다 LIVE 상태 한 줄 출력
+// 상태 페이지 헤더는 0.1초마다 갱신 (GUI 폴링 주기와 무관하게 Acquisition 스레드는 건드리지 않음)
+void BinaryDaqManager::StatusWorker() {
+    ThreadTuning::SetName("nk-status");
+    auto ui_timer = fPerfStartTime;
+    uint64_t last_print_events = 0;
+    uint64_t last_print_bytes = 0;
+
+    std::unique_lock<std::mutex> lock(fStatusMutex);
+    while (fActiveConsumers > 0) {
+        fStatusCv.wait_for(lock, std::chrono::milliseconds(100));
+        if (fActiveConsumers <= 0) break;
+
+        PublishStatus();
 
         auto current_time = std::chrono::steady_clock::now();
         double ui_elapsed_sec = std::chrono::duration<double>(current_time - ui_timer).count();
-        
-        if (ui_elapsed_sec >= 0.5) {
-            double speed_mbps = (((total_written_bytes - last_print_bytes) / 1048576.0) / ui_elapsed_sec);
-            double evt_rate = (current_events - last_print_events) / ui_elapsed_sec;
-            double total_elapsed = std::chrono::duration<double>(current_time - perf_start_time).count();
-            
-            std::cout << "[LIVE DAQ] "
-                      << "Time: \033[1;32m" << std::fixed << std::setprecision(1) << total_elapsed << "s\033[0m | "
-                      << "Events: " << current_events << " | "
-                      << "Size: " << std::fixed << std::setprecision(2) << (total_written_bytes / 1048576.0) << " MB | "
-                      << "Rate: " << std::fixed << std::setprecision(1) << evt_rate << " Hz | "
-                      << "Speed: " << std::fixed << std::setprecision(2) << speed_mbps << " MB/s | "
-                      << "DataQ: " << fDataQueue.Size() << " | "
-                      << "Pool: " << fFreeQueue.Size() << "\n" << std::flush;
-            
-            ui_timer = current_time;
-            last_print_events = current_events;
-            last_print_bytes = total_written_bytes;
-        }
-    }
-    
-    fclose(fp);
+        if (ui_elapsed_sec < 0.5) continue;
+
+        uint64_t total_written_bytes = 0;
+        uint64_t current_events = 0;
+        for (BoardContext* bd : fBoards) {
+            total_written_bytes += bd->writtenBytes;
+            current_events += bd->events;
+        }
+
+        double speed_mbps = (((total_written_bytes - last_print_bytes) / 1048576.0) / ui_elapsed_sec);
+        double evt_rate = (current_events - last_print_events) / ui_elapsed_sec;
+        double total_elapsed = std::chrono::duration<double>(current_time - fPerfStartTime).count();
+
+        std::cout << "[LIVE DAQ] "
+                  << "Time: \033[1;32m" << std::fixed << std::setprecision(1) << total_elapsed << "s\033[0m | "
+                  << "Events: " << current_events << " | "
+                  << "Size: " << std::fixed << std::setprecision(2) << (total_written_bytes / 1048576.0) << " MB | "
+                  << "Rate: " << std::fixed << std::setprecision(1) << evt_rate << " Hz | "
+                  << "Speed: " << std::fixed << std::setprecision(2) << speed_mbps << " MB/s";
+        if (fCompressPool) {
+            uint64_t stored = 0;
+            for (BoardContext* bd : fBoards) stored += bd->storedBytes;
+            if (stored > 0) std::cout << " | Ratio: " << std::fixed << std::setprecision(2) << (double)total_written_bytes / stored;
+        }
+        // 보드 카운터 기준 live 비율: 최근 샘플 구간 (런 누적). 여러 보드면 가장 낮은 보드
+        uint32_t liveInst = kStatusLiveUnknown, liveCum = kStatusLiveUnknown;
+        for (BoardContext* bd : fBoards) {
+            liveInst = std::min(liveInst, bd->status->liveInstPpm.load(std::memory_order_relaxed));
+            liveCum = std::min(liveCum, bd->status->liveCumPpm.load(std::memory_order_relaxed));
+        }
+        if (liveInst != kStatusLiveUnknown && liveCum != kStatusLiveUnknown) {
+            std::cout << " | Live: " << std::fixed << std::setprecision(1) << liveInst / 1e4 << "% (" << liveCum / 1e4 << "%)";
+        }
+        uint64_t diverted = 0;
+        for (BoardContext* bd : fBoards) diverted += bd->status->divertedEvents.load(std::memory_order_relaxed);
+        if (diverted > 0) std::cout << " | \033[1;33mDiverted: " << diverted << "\033[0m";
+        if (fRollover) std::cout << " | Subrun: " << fBoards[0]->subrun;
+        if (fBoards.size() == 1) {
+            std::cout << " | DataQ: " << fBoards[0]->dataQueue->Size() << " | Pool: " << fBoards[0]->freeQueue->Size();
+        } else {
+            for (BoardContext* bd : fBoards) {
+                std::cout << " | B" << bd->mid << " Q/P: " << bd->dataQueue->Size() << "/" << bd->freeQueue->Size();
+            }
+        }
+        std::cout << "\n" << std::flush;
+
+        ui_timer = current_time;
+        last_print_events = current_events;
+        last_print_bytes = total_written_bytes;
+    }
+}
+
+void BinaryDaqManager::PrintRunSummary() {
     std::cout << "\n\n";
-    
+
     auto sys_end_time = std::chrono::system_clock::now();
     auto perf_end_time = std::chrono::steady_clock::now();
-    
-    std::time_t start_c = std::chrono::system_clock::to_time_t(sys_start_time);
+
+    std::time_t start_c = std::chrono::system_clock::to_time_t(fSysStartTime);
     std::time_t end_c = std::chrono::system_clock::to_time_t(sys_end_time);
-    
-    std::chrono::duration<double> total_elapsed = perf_end_time - perf_start_time;
+
+    std::chrono::duration<double> total_elapsed = perf_end_time - fPerfStartTime;
     double total_sec = total_elapsed.count();
+
+    uint64_t total_written_bytes = 0;
+    uint64_t current_events = 0;
+    uint64_t framing_errors = 0;
+    for (BoardContext* bd : fBoards) {
+        total_written_bytes += bd->writtenBytes;
+        current_events += bd->events;
+        framing_errors += bd->framingErrors;
+    }
     double avg_rate = (total_sec > 0) ? (current_events / total_sec) : 0.0;
-    
+
     std::cout << "\033[1;36m========================================================\033[0m\n";
     std::cout << "\033[1;32m   [ Run Summary ]\033[0m\n";
     std::cout << "   Start Time    : " << std::put_time(std::localtime(&start_c), "%Y-%m-%d %H:%M:%S") << "\n";
@@ -214,7 +1665,182 @@ void BinaryDaqManager::ConsumerWorker(const std::string& outFileName, int maxEve
     std::cout << "   Elapsed Time  : " << std::fixed << std::setprecision(2) << total_sec << " sec\n";
     std::cout << "--------------------------------------------------------\n";
     std::cout << "   Total Events  : " << current_events << "\n";
+    for (BoardContext* bd : fBoards) {
+        if (!bd->indexFileName.empty()) std::cout << "   Event Index   : " << bd->indexFileName << "\n";
+    }
+    if (framing_errors > 0) {
+        std::cout << "\033[1;31m   Framing Errors: " << framing_errors << " (corrupted headers, resynchronized)\033[0m\n";
+    }
+    for (BoardContext* bd : fBoards) {
+        if (bd->truncatedBytes == 0) continue;
+        std::cout << "   Dropped Tail  : ";
+        if (fBoards.size() > 1) std::cout << "[MID " << bd->mid << "] ";
+        std::cout << bd->truncatedBytes << " bytes (last event cut off at stop, not counted)\n";
+    }
     std::cout << "   Total Written : " << std::fixed << std::setprecision(2) << (total_written_bytes / 1048576.0) << " MB\n";
     std::cout << "   Avg Trig Rate : " << std::fixed << std::setprecision(2) << avg_rate << " Hz\n";
+    if (fRollover) {
+        for (BoardContext* bd : fBoards) {
+            std::cout << "   Subruns       : " << bd->subrun << " (last: " << bd->outFileName << ")\n";
+        }
+    }
+
+    if (fBoards.size() > 1) {
+        std::cout << "--------------------------------------------------------\n";
+        for (BoardContext* bd : fBoards) {
+            std::cout << "   Board MID " << std::setw(3) << bd->mid << " : " << bd->events << " events | "
+                      << std::fixed << std::setprecision(2) << (bd->writtenBytes / 1048576.0) << " MB\n";
+        }
+    }
+
+    // 💡 [Live time] 시작/종료 샘플 사이 보드 live time 비율과, 보드가 센 트리거 대비 실제로 읽어 기록한 이벤트
+    for (BoardContext* bd : fBoards) {
+        if (bd->liveSamples < 2) continue;
+        double live = DataFormat::LiveFraction(bd->liveFirst, bd->liveLast);
+        double span = (bd->liveLast.timeNs - bd->liveFirst.timeNs) / 1e9;
+        uint64_t hwTriggers = 0;
+        for (int ch = 0; ch < 4; ch++) hwTriggers = std::max<uint64_t>(hwTriggers, bd->liveLast.triggers[ch] - bd->liveFirst.triggers[ch]);
+
+        std::cout << "--------------------------------------------------------\n";
+        std::cout << "   Live Time     : ";
+        if (fBoards.size() > 1) std::cout << "[MID " << bd->mid << "] ";
+        if (live >= 0) std::cout << std::fixed << std::setprecision(2) << live * 100.0 << "% of " << span << " s";
+        else std::cout << "n/a (counter did not advance)";
+        std::cout << " | Dead: " << std::fixed << std::setprecision(3) << (live >= 0 ? (1.0 - live) * span : 0.0) << " s"
+                  << " | Samples: " << bd->liveSamples << "\n";
+        const uint64_t handled = bd->events + bd->divertedEvents;
+        std::cout << "   HW Triggers   : " << hwTriggers << " | Recorded: " << bd->events;
+        if (bd->divertedEvents > 0) std::cout << " | Diverted: " << bd->divertedEvents;
+        if (hwTriggers > handled) {
+            std::cout << " \033[1;33m(" << hwTriggers - handled << " left in board DRAM at stop)\033[0m";
+        }
+        std::cout << "\n";
+    }
+
+    // 💡 [라이브 재설정] 런 중 적용한 설정 변경 (시각은 런 시작 기준, 이벤트는 변경 전 설정으로 수집된 수)
+    const uint64_t runStartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(fPerfStartTime.time_since_epoch()).count();
+    bool changeHeader = false;
+    for (BoardContext* bd : fBoards) {
+        for (const DataFormat::ConfigChange& change : bd->changeLog) {
+            if (!changeHeader) {
+                std::cout << "--------------------------------------------------------\n";
+                changeHeader = true;
+            }
+            std::cout << "   Config Change : ";
+            if (fBoards.size() > 1) std::cout << "[MID " << bd->mid << "] ";
+            std::cout << DataFormat::ConfigParamName(change.param);
+            if (change.channel >= 0) std::cout << " ch" << change.channel;
+            std::cout << " " << change.oldValue << " -> " << change.newValue << " at "
+                      << std::fixed << std::setprecision(2) << (change.timeNs > runStartNs ? (change.timeNs - runStartNs) / 1e9 : 0.0) << " s";
+            if (!change.applied) std::cout << " \033[1;33m(not supported by device)\033[0m";
+            std::cout << "\n";
+        }
+    }
+
+    // 버퍼 풀 고갈: Producer 가 빈 버퍼를 기다린 횟수 (0 이 아니면 디스크/Consumer 가 입력을 따라가지 못한 구간 존재)
+    std::cout << "--------------------------------------------------------\n";
+    for (BoardContext* bd : fBoards) {
+        std::cout << "   Buffer Pool   : ";
+        if (fBoards.size() > 1) std::cout << "[MID " << bd->mid << "] ";
+        std::cout << bd->poolBuffers << " x 4 MB";
+        if (bd->arena && bd->arena->IsValid()) {
+            std::cout << " (" << bd->arena->GetPageModeName() << (bd->arena->IsLocked() ? ", mlocked" : "") << ")";
+        } else {
+            std::cout << " (heap)";
+        }
+        std::cout << " | Exhausted: " << bd->poolExhausted
+                  << " (" << std::fixed << std::setprecision(1) << bd->poolWaitNs / 1e6 << " ms waited)\n";
+    }
+
+    // 💡 [백프레셔] 정책별 결정 집계: 전환 횟수/시간, .dat 대신 처리된 이벤트와 그 행선지, 보드 DRAM 최대 사용량
+    for (BoardContext* bd : fBoards) {
+        const std::string tag = fBoards.size() > 1 ? "[MID " + std::to_string(bd->mid) + "] " : "";
+        std::cout << "   Board DRAM    : " << tag << "peak " << bd->peakDramKB << " KB (BCOUNT)\n";
+        const OverflowSink* of = bd->overflow;
+        if (!of) continue;
+        std::cout << "   Backpressure  : " << tag << OverflowSink::PolicyName(of->GetPolicy())
+                  << (of->IsDegraded() ? " (output failed, dropped)" : "") << " | Episodes: " << bd->divertEpisodes
+                  << " (" << std::fixed << std::setprecision(2) << bd->divertedNs / 1e9 << " s)\n";
+        if (bd->divertEpisodes == 0) continue;
+        std::cout << "\033[1;33m   Diverted      : " << bd->divertedEvents << " events, "
+                  << std::fixed << std::setprecision(2) << of->GetBytes() / 1048576.0 << " MB";
+        if (of->GetStoredBytes() > 0) {
+            std::cout << " -> " << of->GetPath() << " (" << of->GetStoredBytes() / 1048576.0 << " MB";
+            if (of->GetRecords() > 0) std::cout << ", " << of->GetRecords() << " feature records";
+            std::cout << ")";
+        } else {
+            std::cout << " dropped";
+        }
+        std::cout << "\033[0m\n";
+        if (of->GetWriteErrors() > 0) {
+            std::cout << "\033[1;31m   Overflow Errors: " << of->GetWriteErrors() << " write/format errors\033[0m\n";
+        }
+    }
+
+    // 블록 압축: 원본 대비 저장 크기와 블록당 (필터 + 압축) 소요 시간
+    if (fCompressPool) {
+        std::cout << "--------------------------------------------------------\n";
+        for (BoardContext* bd : fBoards) {
+            const LatencyHistogram& lat = bd->compressLatency;
+            double ratio = bd->storedBytes > 0 ? (double)bd->writtenBytes / bd->storedBytes : 0.0;
+            std::cout << "   Compression   : ";
+            if (fBoards.size() > 1) std::cout << "[MID " << bd->mid << "] ";
+            std::cout << BlockCodec::Name(fCodec) << " x " << fCompressPool->GetThreads() << " threads | "
+                      << std::fixed << std::setprecision(2) << (bd->writtenBytes / 1048576.0) << " -> "
+                      << (bd->storedBytes / 1048576.0) << " MB (ratio " << ratio << ")\n";
+            std::cout << "   Block Latency : p50 " << std::fixed << std::setprecision(1) << lat.PercentileNs(0.50) / 1000.0
+                      << " us | p99 " << lat.PercentileNs(0.99) / 1000.0
+                      << " us | max " << lat.MaxNs() / 1000.0 << " us\n";
+        }
+    }
+
+    for (BoardContext* bd : fBoards) {
+        const AsyncUsbReader* usb = bd->device ? bd->device->GetAsyncReader() : nullptr;
+        if (!usb || usb->GetTotalTransfers() == 0) continue;
+
+        const LatencyHistogram& lat = usb->GetLatency();
+        std::cout << "--------------------------------------------------------\n";
+        if (fBoards.size() > 1) std::cout << "   [Board MID " << bd->mid << "]\n";
+        std::cout << "   USB Async     : Depth " << usb->GetDepth() << " x " << (usb->GetChunkBytes() / 1024) << " KB"
+                  << " | Transfers: " << usb->GetTotalTransfers() << " | Errors: " << usb->GetErrorCount() << "\n";
+        std::cout << "   USB Latency   : p50 " << std::fixed << std::setprecision(1) << lat.PercentileNs(0.50) / 1000.0
+                  << " us | p99 " << lat.PercentileNs(0.99) / 1000.0
+                  << " us | max " << lat.MaxNs() / 1000.0 << " us\n";
+    }
+
+    // 💡 [스레드 배치] 실제 affinity 와 선점(involuntary) 횟수: 선점이 많으면 다른 프로세스와 코어를 나눠 쓰는 중
+    for (BoardContext* bd : fBoards) {
+        if (!bd->producerSched.valid || !bd->consumerSched.valid) continue;
+        std::cout << "--------------------------------------------------------\n";
+        if (fBoards.size() > 1) std::cout << "   [Board MID " << bd->mid << "]\n";
+        for (int k = 0; k < 2; k++) {
+            const ThreadSchedInfo& s = (k == 0) ? bd->producerSched : bd->consumerSched;
+            std::cout << (k == 0 ? "   Producer      : CPU " : "   Consumer      : CPU ") << s.cpus << " | " << s.PolicyName();
+            if (s.priority > 0) std::cout << " " << s.priority;
+            std::cout << " | Ctx Switches: " << s.involuntarySwitches << " invol. / " << s.voluntarySwitches << " vol.\n";
+        }
+    }
+
+    if (fMergedWriter) {
+        PrintWriterSummary(fMergedWriter, -1);
+    } else {
+        for (BoardContext* bd : fBoards) {
+            if (bd->writer) PrintWriterSummary(bd->writer, fBoards.size() > 1 ? bd->mid : -1);
+        }
+    }
     std::cout << "\033[1;36m========================================================\033[0m\n";
-}
\ No newline at end of file
+}
+
+// Writer 백엔드별 블록 기록 지연 (Stdio 는 fwrite 호출 시간, io_uring 은 제출~커널 완료 시간)
+void BinaryDaqManager::PrintWriterSummary(const RawWriter* writer, int mid) {
+    const LatencyHistogram& lat = writer->GetLatency();
+    if (lat.Count() == 0) return;
+
+    std::cout << "--------------------------------------------------------\n";
+    if (mid >= 0) std::cout << "   [Board MID " << mid << "]\n";
+    std::cout << "   Disk Writer   : " << writer->GetName() << " | Blocks: " << lat.Count()
+              << " | Unaligned: " << writer->GetUnalignedWrites() << " | Errors: " << writer->GetErrorCount() << "\n";
+    std::cout << "   Write Latency : p50 " << std::fixed << std::setprecision(1) << lat.PercentileNs(0.50) / 1000.0
+              << " us | p99 " << lat.PercentileNs(0.99) / 1000.0
+              << " us | max " << lat.MaxNs() / 1000.0 << " us\n";
+}
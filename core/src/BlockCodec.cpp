@@ -0,0 +1,117 @@
+#include "BlockCodec.hh"
+
+#include <cstring>
+
+#ifdef NKFADC_HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef NKFADC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace BlockCodec {
+
+#ifdef NKFADC_HAVE_ZSTD
+// 스레드(압축 워커/리더)마다 컨텍스트를 하나씩 재사용하여 블록마다 할당하지 않음
+struct ZstdContext {
+    ZSTD_CCtx* cctx = nullptr;
+    ZSTD_DCtx* dctx = nullptr;
+    ~ZstdContext() {
+        if (cctx) ZSTD_freeCCtx(cctx);
+        if (dctx) ZSTD_freeDCtx(dctx);
+    }
+};
+static thread_local ZstdContext tZstd;
+#endif
+
+bool Available(int codec) {
+    switch (codec) {
+        case kNone: return true;
+#ifdef NKFADC_HAVE_LZ4
+        case kLz4:  return true;
+#endif
+#ifdef NKFADC_HAVE_ZSTD
+        case kZstd: return true;
+#endif
+        default:    return false;
+    }
+}
+
+const char* Name(int codec) {
+    switch (codec) {
+        case kNone: return "none";
+        case kLz4:  return "lz4";
+        case kZstd: return "zstd";
+        default:    return "unknown";
+    }
+}
+
+size_t Bound(int codec, size_t rawBytes) {
+    switch (codec) {
+#ifdef NKFADC_HAVE_LZ4
+        case kLz4:  return (size_t)LZ4_compressBound((int)rawBytes);
+#endif
+#ifdef NKFADC_HAVE_ZSTD
+        case kZstd: return ZSTD_compressBound(rawBytes);
+#endif
+        default:    return rawBytes;
+    }
+}
+
+size_t Compress(int codec, int level, const unsigned char* src, size_t n, unsigned char* dst, size_t cap) {
+    switch (codec) {
+#ifdef NKFADC_HAVE_LZ4
+        case kLz4: {
+            // LZ4 는 level 을 acceleration 으로 사용 (1 = 기본, 클수록 빠르고 압축률 낮음)
+            int r = LZ4_compress_fast(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                      (int)n, (int)cap, level > 1 ? level : 1);
+            return r > 0 ? (size_t)r : 0;
+        }
+#endif
+#ifdef NKFADC_HAVE_ZSTD
+        case kZstd: {
+            if (!tZstd.cctx) tZstd.cctx = ZSTD_createCCtx();
+            if (!tZstd.cctx) return 0;
+            size_t r = ZSTD_compressCCtx(tZstd.cctx, dst, cap, src, n, level);
+            return ZSTD_isError(r) ? 0 : r;
+        }
+#endif
+        default:
+            return 0;
+    }
+}
+
+bool Decompress(int codec, const unsigned char* src, size_t n, unsigned char* dst, size_t rawBytes) {
+    switch (codec) {
+        case kNone:
+            if (n != rawBytes) return false;
+            std::memcpy(dst, src, n);
+            return true;
+#ifdef NKFADC_HAVE_LZ4
+        case kLz4: {
+            int r = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst), (int)n, (int)rawBytes);
+            return r >= 0 && (size_t)r == rawBytes;
+        }
+#endif
+#ifdef NKFADC_HAVE_ZSTD
+        case kZstd: {
+            if (!tZstd.dctx) tZstd.dctx = ZSTD_createDCtx();
+            if (!tZstd.dctx) return false;
+            size_t r = ZSTD_decompressDCtx(tZstd.dctx, dst, rawBytes, src, n);
+            return !ZSTD_isError(r) && r == rawBytes;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+void Delta8Encode(unsigned char* buf, size_t n) {
+    for (size_t i = n; i-- > 8;) buf[i] = (unsigned char)(buf[i] - buf[i - 8]);
+}
+
+void Delta8Decode(unsigned char* buf, size_t n) {
+    for (size_t i = 8; i < n; i++) buf[i] = (unsigned char)(buf[i] + buf[i - 8]);
+}
+
+} // namespace BlockCodec
@@ -0,0 +1,82 @@
+#include "CompressionPool.hh"
+#include "BlockCodec.hh"
+
+#include <chrono>
+
+CompressionPool::CompressionPool(int threads) : fStop(false) {
+    if (threads < 1) threads = 1;
+    for (int i = 0; i < threads; i++) fThreads.emplace_back(&CompressionPool::Worker, this);
+}
+
+CompressionPool::~CompressionPool() {
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+    }
+    fJobCv.notify_all();
+    for (std::thread& t : fThreads) {
+        if (t.joinable()) t.join();
+    }
+}
+
+void CompressionPool::Submit(CompressionJob* job) {
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        job->done = false;
+        fJobs.push_back(job);
+    }
+    fJobCv.notify_one();
+}
+
+bool CompressionPool::IsDone(const CompressionJob* job) {
+    std::lock_guard<std::mutex> lock(fMutex);
+    return job->done;
+}
+
+void CompressionPool::Wait(const CompressionJob* job) {
+    std::unique_lock<std::mutex> lock(fMutex);
+    fDoneCv.wait(lock, [job]() { return job->done; });
+}
+
+void CompressionPool::Worker() {
+    while (true) {
+        CompressionJob* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(fMutex);
+            fJobCv.wait(lock, [this]() { return fStop || !fJobs.empty(); });
+            if (fJobs.empty()) return;
+            job = fJobs.front();
+            fJobs.pop_front();
+        }
+
+        Run(job);
+
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            job->done = true;
+        }
+        fDoneCv.notify_all();
+    }
+}
+
+void CompressionPool::Run(CompressionJob* job) {
+    auto t0 = std::chrono::steady_clock::now();
+
+    job->rawBytes = (uint32_t)job->raw->size;
+    if (job->filter == BlockCodec::kFilterDelta8) BlockCodec::Delta8Encode(job->raw->data, job->raw->size);
+
+    size_t comp = BlockCodec::Compress(job->codec, job->level, job->raw->data, job->raw->size,
+                                       job->out->data, job->out->capacity);
+    if (comp > 0 && comp < job->raw->size) {
+        job->usedCodec = job->codec;
+        job->compBytes = (uint32_t)comp;
+        job->out->size = comp;
+    } else {
+        // 압축 실패 또는 이득 없음: 필터만 적용된 raw 를 그대로 기록
+        job->usedCodec = BlockCodec::kNone;
+        job->compBytes = job->rawBytes;
+        job->out->size = 0;
+    }
+
+    job->latencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+}
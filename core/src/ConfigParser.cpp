@@ -4,10 +4,10 @@
 #include <sstream>
 #include <vector>
 
-bool ConfigParser::Parse(const std::string& filename, RunInfo* runInfo) {
+bool ConfigParser::Parse(const std::string& filename, RunInfo* runInfo, DaqOptions* options) {
     std::ifstream file(filename);
     if (!file.is_open()) {
-        ELog::Print(ELog::FATAL, Form("Cannot open configuration file: %s", filename.c_str()));
+        ELog::Print(ELog::ERROR, Form("Cannot open configuration file: %s", filename.c_str()));
         return false;
     }
 
@@ -54,6 +54,157 @@ bool ConfigParser::Parse(const std::string& filename, RunInfo* runInfo) {
         else if (key == "PTRIG_INT") {
             int val; if (iss >> val && current_bd) current_bd->SetPTRIG(val);
         }
+        // DAQ 파이프라인 설정 (보드와 무관)
+        else if (key == "DEVICE") {
+            int val; if (iss >> val && options) options->device = val;
+        }
+        else if (key == "SIM_TRIGGER_HZ") {
+            int val; if (iss >> val && options) options->simTriggerHz = val;
+        }
+        else if (key == "SIM_PULSE_ADC") {
+            int val; if (iss >> val && options) options->simPulseAdc = val;
+        }
+        else if (key == "SIM_RISE_NS") {
+            int val; if (iss >> val && options) options->simRiseNs = val;
+        }
+        else if (key == "SIM_DECAY_NS") {
+            int val; if (iss >> val && options) options->simDecayNs = val;
+        }
+        else if (key == "SIM_NOISE_ADC") {
+            int val; if (iss >> val && options) options->simNoiseAdc = val;
+        }
+        else if (key == "SIM_USB_LATENCY_US") {
+            int val; if (iss >> val && options) options->simUsbLatencyUs = val;
+        }
+        else if (key == "SIM_USB_JITTER_US") {
+            int val; if (iss >> val && options) options->simUsbJitterUs = val;
+        }
+        else if (key == "SIM_USB_MBPS") {
+            int val; if (iss >> val && options) options->simUsbMBps = val;
+        }
+        else if (key == "SIM_DRAM_MB") {
+            int val; if (iss >> val && options) options->simDramMB = val;
+        }
+        else if (key == "USB_READ_MODE") {
+            int val; if (iss >> val && options) options->usbReadMode = val;
+        }
+        else if (key == "USB_ASYNC_DEPTH") {
+            int val; if (iss >> val && options) options->usbAsyncDepth = val;
+        }
+        else if (key == "USB_CHUNK_KB") {
+            int val; if (iss >> val && options) options->usbChunkKB = val;
+        }
+        else if (key == "REG_BATCH") {
+            int val; if (iss >> val && options) options->regBatch = val;
+        }
+        else if (key == "ALIGN_CACHE") {
+            int val; if (iss >> val && options) options->alignCache = val;
+        }
+        else if (key == "ALIGN_CACHE_DIR") {
+            std::string val; if (iss >> val && options) options->alignCacheDir = val;
+        }
+        else if (key == "QUEUE_TYPE") {
+            int val; if (iss >> val && options) options->queueType = val;
+        }
+        else if (key == "QUEUE_WAKEUP") {
+            int val; if (iss >> val && options) options->queueWakeup = val;
+        }
+        else if (key == "WRITER_BACKEND") {
+            int val; if (iss >> val && options) options->writerBackend = val;
+        }
+        else if (key == "WRITER_QUEUE_DEPTH") {
+            int val; if (iss >> val && options) options->writerQueueDepth = val;
+        }
+        else if (key == "BUFFER_POOL_MB") {
+            int val; if (iss >> val && options) options->bufferPoolMB = val;
+        }
+        else if (key == "BUFFER_HUGEPAGES") {
+            int val; if (iss >> val && options) options->bufferHugePages = val;
+        }
+        else if (key == "BUFFER_MLOCK") {
+            int val; if (iss >> val && options) options->bufferMlock = val;
+        }
+        else if (key == "COMPRESSION") {
+            int val; if (iss >> val && options) options->compression = val;
+        }
+        else if (key == "COMPRESSION_LEVEL") {
+            int val; if (iss >> val && options) options->compressionLevel = val;
+        }
+        else if (key == "COMPRESSION_THREADS") {
+            int val; if (iss >> val && options) options->compressionThreads = val;
+        }
+        else if (key == "COMPRESSION_FILTER") {
+            int val; if (iss >> val && options) options->compressionFilter = val;
+        }
+        else if (key == "EVENT_INDEX") {
+            int val; if (iss >> val && options) options->eventIndex = val;
+        }
+        else if (key == "ROLLOVER_MB") {
+            int val; if (iss >> val && options) options->rolloverMB = val;
+        }
+        else if (key == "ROLLOVER_SEC") {
+            int val; if (iss >> val && options) options->rolloverSec = val;
+        }
+        else if (key == "LIVE_RING_MB") {
+            int val; if (iss >> val && options) options->liveRingMB = val;
+        }
+        else if (key == "LIVE_RING_SLOT_KB") {
+            int val; if (iss >> val && options) options->liveRingSlotKB = val;
+        }
+        else if (key == "ZMQ_PORT") {
+            int val; if (iss >> val && options) options->zmqPort = val;
+        }
+        else if (key == "ZMQ_MAX_HZ") {
+            int val; if (iss >> val && options) options->zmqMaxHz = val;
+        }
+        else if (key == "OUTPUT_MERGE") {
+            int val; if (iss >> val && options) options->outputMerge = val;
+        }
+        else if (key == "PRODUCER_CPU") {
+            int val; if (iss >> val && options) options->producerCpu = val;
+        }
+        else if (key == "CONSUMER_CPU") {
+            int val; if (iss >> val && options) options->consumerCpu = val;
+        }
+        else if (key == "RT_PRIORITY") {
+            int val; if (iss >> val && options) options->rtPriority = val;
+        }
+        else if (key == "LIVETIME_SAMPLE_MS") {
+            int val; if (iss >> val && options) options->liveTimeSampleMs = val;
+        }
+        else if (key == "LIVETIME_TICK_NS") {
+            int val; if (iss >> val && options) options->liveTimeTickNs = val;
+        }
+        else if (key == "SCAN_WINDOW_MS") {
+            int val; if (iss >> val && options) options->scanWindowMs = val;
+        }
+        else if (key == "SCAN_TARGET_HZ") {
+            double val; if (iss >> val && options) options->scanTargetHz = val;
+        }
+        else if (key == "DACOFF_CAL_TOLERANCE") {
+            int val; if (iss >> val && options) options->dacCalTolerance = val;
+        }
+        else if (key == "DACOFF_CAL_SETTLE_MS") {
+            int val; if (iss >> val && options) options->dacCalSettleMs = val;
+        }
+        else if (key == "BACKPRESSURE") {
+            int val; if (iss >> val && options) options->backpressure = val;
+        }
+        else if (key == "BACKPRESSURE_RESUME_PCT") {
+            int val; if (iss >> val && options) options->backpressureResumePct = val;
+        }
+        else if (key == "SPILL_DIR") {
+            std::string val; if (iss >> val && options) options->spillDir = val;
+        }
+        else if (key == "FEATURE_PED_SAMPLES") {
+            int val; if (iss >> val && options) options->featurePedSamples = val;
+        }
+        else if (key == "BCOUNT_POLL_MIN_US") {
+            int val; if (iss >> val && options) options->bcountPollMinUs = val;
+        }
+        else if (key == "BCOUNT_POLL_MAX_US") {
+            int val; if (iss >> val && options) options->bcountPollMaxUs = val;
+        }
         // 채널별 배열 설정
         else {
             if (!current_bd) {
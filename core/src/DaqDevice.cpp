@@ -0,0 +1,96 @@
+#include "DaqDevice.hh"
+#include "Fadc500Device.hh"
+#include "SimFadc500Device.hh"
+
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+
+// DACOFF 레지스터 범위 (12-bit DAC)
+static const int kDacMax = 4095;
+
+DaqDevice* DaqDevice::Create(int mid, const DaqOptions& options) {
+    if (options.device == DaqOptions::kDeviceSim) return new SimFadc500Device(mid, options);
+    return new Fadc500Device(mid, options);
+}
+
+// 채널마다 u (DACOFF 를 pedestal 이 커지는 방향으로 본 값) 구간 [lo, hi] 를 반으로 줄임. 한 번의 측정에 모든 채널의 중간값을 함께 씀
+bool DaqDevice::CalibrateDacOffset(FadcBD* bdConfig, int targetAdc, int tolerance, DacCalibration& result) {
+    const auto t0 = std::chrono::steady_clock::now();
+    const int nch = std::min(bdConfig->NCHANNEL(), 4);
+    result = DacCalibration();
+    result.mid = bdConfig->GetMID();
+
+    int saved[4] = {0, 0, 0, 0};
+    for (int ch = 0; ch < nch; ch++) saved[ch] = bdConfig->GetDACOFF(ch);
+    int ped[4] = {0, 0, 0, 0};
+    // 측정 실패: 원래 DACOFF 로 되돌려 다시 측정 (보드 내부 pedestal 도 원래 값 기준으로)
+    auto fail = [&]() {
+        for (int ch = 0; ch < nch; ch++) bdConfig->SetDACOFF(ch, saved[ch]);
+        MeasurePedestals(bdConfig, ped);
+        return false;
+    };
+
+    // 양 끝값: DACOFF 와 pedestal 의 방향 (보드/아날로그 설정마다 다를 수 있음) 과 도달 가능한 범위
+    int pedLo[4] = {0, 0, 0, 0}, pedHi[4] = {0, 0, 0, 0};
+    for (int ch = 0; ch < nch; ch++) bdConfig->SetDACOFF(ch, 0);
+    bool ok = MeasurePedestals(bdConfig, pedLo);
+    for (int ch = 0; ch < nch && ok; ch++) bdConfig->SetDACOFF(ch, kDacMax);
+    ok = ok && MeasurePedestals(bdConfig, pedHi);
+    if (!ok) return fail();
+    result.rounds = 2;
+
+    bool rising[4], active[4];
+    int lo[4], hi[4], fLo[4], fHi[4], best[4];
+    auto toDac = [&](int ch, int u) { return rising[ch] ? u : kDacMax - u; };
+    for (int ch = 0; ch < nch; ch++) {
+        rising[ch] = pedHi[ch] >= pedLo[ch];
+        lo[ch] = 0;
+        hi[ch] = kDacMax;
+        fLo[ch] = rising[ch] ? pedLo[ch] : pedHi[ch];
+        fHi[ch] = rising[ch] ? pedHi[ch] : pedLo[ch];
+        active[ch] = targetAdc > fLo[ch] && targetAdc < fHi[ch];
+        // 범위 밖 목표는 끝값에서 끝남 (tolerance 안이면 수렴). 범위 안은 탐색을 마친 뒤에 정함
+        result.converged[ch] = !active[ch] && targetAdc >= fLo[ch] - tolerance && targetAdc <= fHi[ch] + tolerance;
+        best[ch] = targetAdc <= fLo[ch] ? 0 : kDacMax;
+    }
+
+    for (int round = 0; round < 16; round++) {
+        bool any = false;
+        for (int ch = 0; ch < nch; ch++) {
+            const int u = active[ch] ? (lo[ch] + hi[ch]) / 2 : best[ch];
+            bdConfig->SetDACOFF(ch, toDac(ch, u));
+            any = any || active[ch];
+        }
+        if (!any) break;
+        if (!MeasurePedestals(bdConfig, ped)) return fail();
+        result.rounds++;
+
+        for (int ch = 0; ch < nch; ch++) {
+            if (!active[ch]) continue;
+            const int u = (lo[ch] + hi[ch]) / 2;
+            if (std::abs(ped[ch] - targetAdc) <= tolerance) {
+                best[ch] = u;
+                active[ch] = false;
+                result.converged[ch] = true;
+                continue;
+            }
+            if (ped[ch] < targetAdc) { lo[ch] = u; fLo[ch] = ped[ch]; }
+            else                     { hi[ch] = u; fHi[ch] = ped[ch]; }
+            if (hi[ch] - lo[ch] <= 1) {
+                // DAC 1 단계보다 tolerance 가 좁음: 양쪽 중 가까운 값
+                best[ch] = (targetAdc - fLo[ch] <= fHi[ch] - targetAdc) ? lo[ch] : hi[ch];
+                active[ch] = false;
+                result.converged[ch] = true;
+            }
+        }
+    }
+
+    // 찾은 값으로 다시 측정 (보고용 + 보드 내부 pedestal 도 이 DACOFF 기준으로 남김)
+    for (int ch = 0; ch < nch; ch++) bdConfig->SetDACOFF(ch, toDac(ch, best[ch]));
+    if (!MeasurePedestals(bdConfig, result.pedestal)) return fail();
+    result.rounds++;
+    for (int ch = 0; ch < nch; ch++) result.dacoff[ch] = bdConfig->GetDACOFF(ch);
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return true;
+}
@@ -0,0 +1,113 @@
+#include "EventFramer.hh"
+
+#include <algorithm>
+#include <cstring>
+
+EventFramer::EventFramer() {
+    Reset();
+}
+
+void EventFramer::Reset() {
+    fRemain = 0;
+    fHdrHave = 0;
+    fHdrPos = 0;
+    fEventPos = 0;
+    fStreamPos = 0;
+    fEvents = 0;
+    fErrors = 0;
+    fSkipped = 0;
+    fLastEventBytes = 0;
+    fSearching = false;
+}
+
+uint64_t EventFramer::EventBytes(const unsigned char* header) {
+    unsigned int data_length = header[0] + (header[4] << 8) + (header[8] << 16) + (header[12] << 24);
+    if (data_length <= 32 || data_length > 100000000) return 0;
+    return kHeaderBytes + (uint64_t)((data_length - 32) / 2) * 8;
+}
+
+uint32_t EventFramer::RecordLength(const unsigned char* header) {
+    uint64_t bytes = EventBytes(header);
+    return bytes > 0 ? (uint32_t)((bytes - kHeaderBytes) / 8) : 0;
+}
+
+uint64_t EventFramer::TriggerTime(const unsigned char* header) {
+    return header[44] * 8ULL + header[48] * 1000ULL + (header[52] << 8) * 1000ULL + (header[56] << 16) * 1000ULL;
+}
+
+uint64_t EventFramer::GetMissingBytes() const {
+    if (fRemain > 0) return fRemain;
+    if (fHdrHave == 0) return 0;
+    // 헤더가 잘린 경우: 길이 필드를 알 수 없으면 직전 이벤트 크기 기준
+    return (fLastEventBytes > kHeaderBytes ? fLastEventBytes : kHeaderBytes) - fHdrHave;
+}
+
+uint64_t EventFramer::DropPartial(bool& counted) {
+    counted = fRemain > 0;
+    uint64_t bytes = counted ? fStreamPos - fEventPos : fHdrHave;
+    if (counted) fEvents--;
+    fRemain = 0;
+    fHdrHave = 0;
+    return bytes;
+}
+
+size_t EventFramer::Feed(const unsigned char* data, size_t len, std::vector<uint32_t>* offsets) {
+    if (offsets) offsets->clear();
+
+    size_t pos = 0;
+    size_t found = 0;
+
+    while (pos < len) {
+        // 1. 이전 이벤트의 파형 구간은 읽지 않고 건너뜀
+        if (fRemain > 0) {
+            size_t take = (size_t)std::min<uint64_t>(fRemain, len - pos);
+            pos += take;
+            fRemain -= take;
+            continue;
+        }
+
+        // 2. 헤더 확보: 블록 안에 통째로 있으면 그 자리에서, 경계에 걸리면 fHdr 에 조립
+        const unsigned char* hdr;
+        const size_t hdrStart = pos;
+        if (fHdrHave == 0 && len - pos >= kHeaderBytes) {
+            hdr = data + pos;
+            pos += kHeaderBytes;
+        } else {
+            if (fHdrHave == 0) fHdrPos = fStreamPos + pos;
+            size_t take = std::min(kHeaderBytes - fHdrHave, len - pos);
+            std::memcpy(fHdr + fHdrHave, data + pos, take);
+            fHdrHave += take;
+            pos += take;
+            if (fHdrHave < kHeaderBytes) break;
+            hdr = fHdr;
+        }
+
+        // 3. 검증. 동기를 잃은 뒤에는 직전과 같은 크기의 헤더가 나올 때까지 4 바이트씩 전진
+        uint64_t evBytes = EventBytes(hdr);
+        bool ok = evBytes > 0 && (!fSearching || fLastEventBytes == 0 || evBytes == fLastEventBytes);
+        if (!ok) {
+            if (!fSearching) { fErrors++; fSearching = true; }
+            fSkipped += 4;
+            if (hdr == fHdr) {
+                std::memmove(fHdr, fHdr + 4, kHeaderBytes - 4);
+                fHdrHave = kHeaderBytes - 4;
+                fHdrPos += 4;
+            } else {
+                pos = hdrStart + 4;
+            }
+            continue;
+        }
+
+        if (offsets && hdr != fHdr) offsets->push_back((uint32_t)hdrStart);
+        fEventPos = (hdr == fHdr) ? fHdrPos : fStreamPos + hdrStart;
+        if (fOnEvent) fOnEvent(fEventPos, hdr);
+        fSearching = false;
+        fLastEventBytes = evBytes;
+        fHdrHave = 0;
+        fRemain = evBytes - kHeaderBytes;
+        fEvents++;
+        found++;
+    }
+    fStreamPos += len;
+    return found;
+}
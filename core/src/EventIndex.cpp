@@ -0,0 +1,134 @@
+#include "EventIndex.hh"
+#include "ELog.hh"
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+EventIndexWriter::EventIndexWriter() : fFp(nullptr), fEntries(0) {}
+
+EventIndexWriter::~EventIndexWriter() {
+    Close();
+}
+
+bool EventIndexWriter::Open(const std::string& path, int mid, bool blockAddressed) {
+    Close();
+    fFp = fopen(path.c_str(), "wb");
+    if (!fFp) return false;
+    setvbuf(fFp, nullptr, _IOFBF, 1024 * 1024);
+
+    DataFormat::IndexHeader hdr;
+    std::memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = DataFormat::kIndexMagic;
+    hdr.version = DataFormat::kIndexVersion;
+    hdr.entryBytes = sizeof(DataFormat::IndexEntry);
+    hdr.mid = mid;
+    hdr.flags = blockAddressed ? DataFormat::kIndexBlockAddressed : 0;
+    fwrite(&hdr, sizeof(hdr), 1, fFp);
+    fEntries = 0;
+    return true;
+}
+
+void EventIndexWriter::Add(const DataFormat::IndexEntry& entry) {
+    if (!fFp) return;
+    fwrite(&entry, sizeof(entry), 1, fFp);
+    fEntries++;
+}
+
+void EventIndexWriter::DropLast() {
+    if (!fFp || fEntries == 0 || fflush(fFp) != 0) return;
+    fEntries--;
+    if (ftruncate(fileno(fFp), (off_t)(sizeof(DataFormat::IndexHeader) + fEntries * sizeof(DataFormat::IndexEntry))) == 0) fseeko(fFp, 0, SEEK_END);
+}
+
+void EventIndexWriter::Close() {
+    if (fFp) {
+        fclose(fFp);
+        fFp = nullptr;
+    }
+}
+
+EventIndex::EventIndex()
+    : fMap(nullptr), fMapBytes(0), fHeader(nullptr), fEntries(nullptr), fCount(0) {}
+
+EventIndex::~EventIndex() {
+    Close();
+}
+
+bool EventIndex::Open(const std::string& path) {
+    Close();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(DataFormat::IndexHeader)) {
+        close(fd);
+        return false;
+    }
+
+    void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+
+    const DataFormat::IndexHeader* hdr = static_cast<const DataFormat::IndexHeader*>(p);
+    if (hdr->magic != DataFormat::kIndexMagic || hdr->entryBytes != sizeof(DataFormat::IndexEntry)) {
+        ELog::Print(ELog::WARNING, "Not a valid event index file: " + path);
+        munmap(p, st.st_size);
+        return false;
+    }
+
+    fMap = p;
+    fMapBytes = st.st_size;
+    fHeader = hdr;
+    fEntries = reinterpret_cast<const DataFormat::IndexEntry*>(static_cast<const unsigned char*>(p) + sizeof(DataFormat::IndexHeader));
+    // 수집 도중(또는 비정상 종료)에 잘린 마지막 엔트리는 무시
+    fCount = (fMapBytes - sizeof(DataFormat::IndexHeader)) / sizeof(DataFormat::IndexEntry);
+    return true;
+}
+
+void EventIndex::Close() {
+    if (fMap) munmap(fMap, fMapBytes);
+    fMap = nullptr;
+    fMapBytes = 0;
+    fHeader = nullptr;
+    fEntries = nullptr;
+    fCount = 0;
+}
+
+const DataFormat::IndexEntry* EventIndex::FindEvent(uint64_t n) const {
+    if (fCount == 0 || n < fEntries[0].event) return nullptr;
+
+    uint64_t i = n - fEntries[0].event;
+    if (i < fCount && fEntries[i].event == n) return &fEntries[i];
+
+    // 번호가 비어 있는 인덱스 (이어 붙인 파일 등): 이진 탐색
+    size_t lo = 0, hi = fCount;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (fEntries[mid].event < n) lo = mid + 1;
+        else hi = mid;
+    }
+    return (lo < fCount && fEntries[lo].event == n) ? &fEntries[lo] : nullptr;
+}
+
+size_t EventIndex::LowerBoundTime(uint64_t t) const {
+    size_t lo = 0, hi = fCount;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (fEntries[mid].triggerTime < t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+std::string EventIndex::PathFor(const std::string& datPath, int mid) {
+    std::string base = datPath;
+    size_t dotPos = base.find_last_of('.');
+    size_t slashPos = base.find_last_of('/');
+    if (dotPos != std::string::npos && (slashPos == std::string::npos || dotPos > slashPos)) base = base.substr(0, dotPos);
+    if (mid >= 0) base += "_b" + std::to_string(mid);
+    return base + ".idx";
+}
@@ -1,13 +1,56 @@
 #include "Fadc500Device.hh"
+#include "UsbTransport.hh"
+#include "AsyncUsbReader.hh"
+#include "DataFormat.hh"
 #include "ELog.hh"
 
 extern "C" {
     #include "usb3com.h"
+    #include "nkusb.h"
     #include "NoticeNKFADC500.h"
 }
 #include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
 
-Fadc500Device::Fadc500Device(int sid) : fSid(sid) {
+// NoticeNKFADC500.c 의 설정 레지스터 주소 (채널 레지스터는 + ((ch - 1) << 16))
+static const uint32_t kRegCW         = 0x20000001;
+static const uint32_t kRegRL         = 0x20000002;
+static const uint32_t kRegDACOFF     = 0x20000004;
+static const uint32_t kRegDLY        = 0x20000007;
+static const uint32_t kRegTHR        = 0x20000008;
+static const uint32_t kRegPOL        = 0x20000009;
+static const uint32_t kRegPSW        = 0x2000000A;
+static const uint32_t kRegAMODE      = 0x2000000B;
+static const uint32_t kRegPCT        = 0x2000000C;
+static const uint32_t kRegPCI        = 0x2000000D;
+static const uint32_t kRegPWT        = 0x2000000E;
+static const uint32_t kRegDT         = 0x2000000F;
+static const uint32_t kRegPTRIG      = 0x20000011;
+static const uint32_t kRegTRIGENABLE = 0x20000013;
+static const uint32_t kRegTM         = 0x20000014;
+static const uint32_t kRegTLT        = 0x20000015;
+static const uint32_t kRegPSCALE     = 0x2000001E;
+static const uint32_t kRegDSR        = 0x2000001F;
+
+// 벤더 USB3Write 1번의 비용 (명령 뒤 usleep(1000) + 핸들 탐색). 시작 로그의 절약 시간 추정에 사용
+static const double kVendorWriteMs = 1.1;
+
+static double ElapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+Fadc500Device::Fadc500Device(int sid, const DaqOptions& options)
+    : fSid(sid), fTransport(nullptr), fAsyncReader(nullptr), fDirectChunkBytes(0),
+      fRegBatch(std::max(options.regBatch, 0)), fBatchVerified(false), fInitialized(false),
+      fAlignCache(options.alignCache), fAlignCacheDir(options.alignCacheDir), fDacSettleMs(std::max(options.dacCalSettleMs, 0)),
+      fRegWrites(0), fRegTransfers(0), fRegMs(0) {
     USB3Init(0);
     int status = NKFADC500open(fSid, 0); 
     if (status < 0) {
@@ -16,58 +59,341 @@ Fadc500Device::Fadc500Device(int sid) : fSid(sid) {
 }
 
 Fadc500Device::~Fadc500Device() {
+    delete fAsyncReader;
+    delete fTransport;
     NKFADC500close(fSid);
     USB3Exit(0);
 }
 
+void Fadc500Device::StageChannel(uint32_t reg, int ch, uint32_t value) {
+    fShadow.Stage(reg + (((uint32_t)(ch - 1) & 0xFF) << 16), value);
+}
+
+// 섀도와 다른 레지스터만 전송. 반환: 보낸 레지스터 수
+size_t Fadc500Device::FlushRegisters() {
+    const std::vector<RegisterShadow::Write>& pending = fShadow.GetPending();
+    const size_t count = pending.size();
+    if (count == 0) return 0;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    size_t done = 0;
+    if (fRegBatch > 0 && (fTransport || AttachTransport())) {
+        std::vector<unsigned char> cmds(count * 8);
+        for (size_t i = 0; i < count; i++) UsbTransport::EncodeWrite(&cmds[i * 8], pending[i].addr, pending[i].value);
+
+        while (done < count) {
+            size_t n = std::min(count - done, (size_t)fRegBatch);
+            int rc = fTransport->WriteCommands(&cmds[done * 8], (int)n);
+            fRegTransfers++;
+            if (rc < 0) {
+                ELog::Print(ELog::WARNING, Form("[MID %d] Register write transfer failed (error = %d). Using vendor writes.", fSid, rc));
+                fRegBatch = 0;
+                break;
+            }
+            // 여러 명령을 한 전송에 담았으면 처음 한 번은 그 전송의 레지스터를 모두 읽어 펌웨어가 빠짐없이 처리했는지 확인
+            if (n > 1 && !fBatchVerified) {
+                size_t bad = 0;
+                for (size_t i = done; i < done + n; i++) {
+                    if (USB3ReadReg(NKFADC500_VENDOR_ID, NKFADC500_PRODUCT_ID, fSid, pending[i].addr) != pending[i].value) bad++;
+                }
+                if (bad > 0) {
+                    ELog::Print(ELog::WARNING, Form("[MID %d] Firmware dropped %zu of %zu batched register writes. Falling back to REG_BATCH 1.",
+                                                    fSid, bad, n));
+                    fRegBatch = 1;
+                    continue;   // 같은 구간을 1개씩 다시 보냄
+                }
+                fBatchVerified = true;
+            }
+            done += n;
+        }
+    }
+    for (; done < count; done++) {
+        USB3Write(NKFADC500_VENDOR_ID, NKFADC500_PRODUCT_ID, fSid, pending[done].addr, pending[done].value);
+        fRegTransfers++;
+    }
+    fRegWrites += count;
+    fRegMs += ElapsedMs(t0);
+    fShadow.Commit();
+    return count;
+}
+
+// 💡 [레지스터 섀도] 처음에는 전체 설정, 같은 세션의 재설정(데몬 configure)은 바뀐 레지스터만 보냄
+// - ADC/DRAM 정렬: 처음 또는 DSR 이 바뀐 경우만
+// - measure_PED  : 정렬을 다시 했거나 CW/DACOFF 가 바뀐 경우만. DACOFF 를 쓴 뒤에는 DAC 안정화 (DACOFF_CAL_SETTLE_MS,
+//                  벤더 write_DACOFF 의 sleep(1) 과 같은 1초) 를 기다린 다음 측정
 void Fadc500Device::Initialize(FadcBD* bdConfig) {
-    ELog::Print(ELog::INFO, Form("Initializing FADC500 Mini (MID: %d) with Custom Settings...", fSid));
+    const auto t0 = std::chrono::steady_clock::now();
+    const bool realign = !fInitialized || !fShadow.Matches(kRegDSR, (uint32_t)bdConfig->GetSAMPLING());
+    ELog::Print(ELog::INFO, Form("Initializing FADC500 Mini (MID: %d) with Custom Settings%s...", fSid,
+                                 fInitialized ? " (re-configuration: changed registers only)" : ""));
+    fShadow.ResetCounters();
+    fRegWrites = fRegTransfers = 0;
+    fRegMs = 0;
     
     // 💡 [핵심 패치] 벤더 함수의 무한루프에 갇히기 전에, 파이프라인의 쓰레기를 먼저 완전 소각합니다!
     ClearAndFlushUSB();
     
-    NKFADC500write_DSR(fSid, bdConfig->GetSAMPLING());
-    NKFADC500resetTIMER(fSid);  
-    NKFADC500reset(fSid);
-    NKFADC500_ADCALIGN_500(fSid);
-    NKFADC500_ADCALIGN_DRAM(fSid);
+    double alignMs = 0;
+    if (realign) {
+        const auto ta = std::chrono::steady_clock::now();
+        fShadow.Stage(kRegDSR, (uint32_t)bdConfig->GetSAMPLING());
+        FlushRegisters();
+        NKFADC500resetTIMER(fSid);  
+        NKFADC500reset(fSid);
+        Align(bdConfig->GetSAMPLING());
+        alignMs = ElapsedMs(ta);
+    }
     
-    NKFADC500write_PTRIG(fSid, bdConfig->GetPTRIG());
-    NKFADC500write_RL(fSid, bdConfig->GetRL()); 
-    NKFADC500write_DRAMON(fSid, 1);
+    fShadow.Stage(kRegPTRIG, (uint32_t)bdConfig->GetPTRIG());
+    fShadow.Stage(kRegRL, (uint32_t)bdConfig->GetRL());
+    FlushRegisters();
+    if (realign) NKFADC500write_DRAMON(fSid, 1);   // DRAM 준비 대기 핸드셰이크 포함 (벤더 함수 유지)
 
     for (int ch = 0; ch < bdConfig->NCHANNEL(); ch++) {
-        int cid = ch + 1; 
-        NKFADC500write_CW(fSid, cid, bdConfig->GetCW(ch));
-        NKFADC500write_DACOFF(fSid, cid, bdConfig->GetDACOFF(ch));
+        StageChannel(kRegCW, ch + 1, (uint32_t)bdConfig->GetCW(ch));
+        StageChannel(kRegDACOFF, ch + 1, (uint32_t)bdConfig->GetDACOFF(ch));
     }
+    const bool baselineChanged = FlushRegisters() > 0;
 
-    for (int ch = 0; ch < bdConfig->NCHANNEL(); ch++) {
-        NKFADC500measure_PED(fSid, ch + 1);
+    if (realign || baselineChanged) {
+        // 레지스터 전송은 바로 끝나므로 (벤더 함수처럼 채널마다 1초씩 자지 않음) 4채널을 한 번에 기다림
+        if (baselineChanged && fDacSettleMs > 0) usleep((useconds_t)fDacSettleMs * 1000);
+        for (int ch = 0; ch < bdConfig->NCHANNEL(); ch++) {
+            NKFADC500measure_PED(fSid, ch + 1);
+        }
     }
 
     for (int ch = 0; ch < bdConfig->NCHANNEL(); ch++) {
         int cid = ch + 1;
         unsigned long apply_dly = bdConfig->GetCW(ch) + bdConfig->GetDLY(ch);
         
-        NKFADC500write_DLY(fSid, cid, apply_dly);
-        NKFADC500write_THR(fSid, cid, bdConfig->GetTHR(ch));
-        NKFADC500write_POL(fSid, cid, bdConfig->GetPOL(ch));
-        NKFADC500write_PSW(fSid, cid, bdConfig->GetPSW(ch));
-        NKFADC500write_AMODE(fSid, cid, bdConfig->GetAMODE(ch));
-        NKFADC500write_PCT(fSid, cid, bdConfig->GetPCT(ch));
-        NKFADC500write_PCI(fSid, cid, bdConfig->GetPCI(ch));
-        NKFADC500write_PWT(fSid, cid, bdConfig->GetPWT(ch));
-        NKFADC500write_DT(fSid, cid, bdConfig->GetDT(ch));
-        NKFADC500write_TM(fSid, cid, bdConfig->GetTMODE(ch));
+        // DLY 레지스터 인코딩은 NKFADC500write_DLY 와 동일 ((us << 10) | ns)
+        StageChannel(kRegDLY, cid, (uint32_t)(((apply_dly / 1000) << 10) | (apply_dly % 1000)));
+        StageChannel(kRegTHR, cid, (uint32_t)bdConfig->GetTHR(ch));
+        StageChannel(kRegPOL, cid, (uint32_t)bdConfig->GetPOL(ch));
+        StageChannel(kRegPSW, cid, (uint32_t)bdConfig->GetPSW(ch));
+        StageChannel(kRegAMODE, cid, (uint32_t)bdConfig->GetAMODE(ch));
+        StageChannel(kRegPCT, cid, (uint32_t)bdConfig->GetPCT(ch));
+        StageChannel(kRegPCI, cid, (uint32_t)bdConfig->GetPCI(ch));
+        StageChannel(kRegPWT, cid, (uint32_t)bdConfig->GetPWT(ch));
+        StageChannel(kRegDT, cid, (uint32_t)bdConfig->GetDT(ch));
+        StageChannel(kRegTM, cid, (uint32_t)bdConfig->GetTMODE(ch));
     }
     
-    NKFADC500write_TLT(fSid, bdConfig->GetTLT());
-    NKFADC500write_PSCALE(fSid, bdConfig->GetPRESCALE());
-    NKFADC500write_TRIGENABLE(fSid, bdConfig->GetTRIGEN());
+    fShadow.Stage(kRegTLT, (uint32_t)bdConfig->GetTLT());
+    fShadow.Stage(kRegPSCALE, (uint32_t)bdConfig->GetPRESCALE());
+    fShadow.Stage(kRegTRIGENABLE, (uint32_t)bdConfig->GetTRIGEN());
+    FlushRegisters();
 
     NKFADC500reset(fSid);
-    ELog::Print(ELog::INFO, "Hardware initialization complete.");
+    fInitialized = true;
+
+    // 절약 추정: 모든 설정 레지스터를 벤더 USB3Write 로 1번씩 쓴 경우 대비 실제 레지스터 전송 시간
+    const size_t skipped = fShadow.GetSkipped();
+    const double savedMs = std::max((skipped + fRegWrites) * kVendorWriteMs - fRegMs, 0.0);
+    ELog::Print(ELog::INFO, Form("Hardware initialization complete in %.1f ms (align %s%.0f ms). Registers: %zu written in %zu transfers (%.1f ms), "
+                                 "%zu unchanged skipped (~%.0f ms saved vs. vendor writes).",
+                                 ElapsedMs(t0), realign ? "" : "skipped, ", alignMs, fRegWrites, fRegTransfers, fRegMs, skipped, savedMs));
+}
+
+// 💡 [정렬 캐시] 보드 x 샘플링 속도별로 저장된 정렬 값을 써 넣고 읽어서 확인 (수 ms).
+// 캐시가 없거나 확인에 실패하면 전체 스윕 (ADCRST 대기 + 지연 스윕, 수 초) 후 결과를 저장
+void Fadc500Device::Align(int sampling) {
+    if (fAlignCache <= 0) {
+        NKFADC500_ADCALIGN_500(fSid);
+        NKFADC500_ADCALIGN_DRAM(fSid);
+        return;
+    }
+
+    const std::string path = AlignCachePath(sampling);
+    Alignment result;
+    if (fAlignCache == 1 && LoadAlignment(path, result)) {
+        const auto t0 = std::chrono::steady_clock::now();
+        if (ApplyAlignment(result)) {
+            ELog::Print(ELog::INFO, Form("[MID %d] ADC/DRAM alignment restored from %s and verified in %.1f ms.",
+                                         fSid, path.c_str(), ElapsedMs(t0)));
+            return;
+        }
+        ELog::Print(ELog::WARNING, Form("[MID %d] Cached alignment failed verification. Running full alignment.", fSid));
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const bool adcOk = SweepAdc(result);
+    const bool dramOk = SweepDram(result);
+    if (adcOk && dramOk) {
+        SaveAlignment(path, result);
+        ELog::Print(ELog::INFO, Form("[MID %d] Full ADC/DRAM alignment took %.0f ms (saved to %s).", fSid, ElapsedMs(t0), path.c_str()));
+    } else {
+        ELog::Print(ELog::ERROR, Form("[MID %d] Alignment incomplete (ADC %s, DRAM %s). Not cached, check the board.",
+                                      fSid, adcOk ? "ok" : "failed", dramOk ? "ok" : "failed"));
+    }
+}
+
+// NKFADC500_ADCALIGN_500 과 같은 절차. 채널마다 ADCSTAT 가 0 인 (나쁜) 지연 구간의 중심에서 11 떨어진 값을 선택
+bool Fadc500Device::SweepAdc(Alignment& result) {
+    bool ok = true;
+    NKFADC500send_ADCRST(fSid);
+    usleep(500000);
+    NKFADC500send_ADCCAL(fSid);
+    NKFADC500write_ADCALIGN(fSid, 1);
+
+    for (int ch = 1; ch <= 4; ch++) {
+        int count = 0, sum = 0;
+        bool inBad = false;
+        for (int dly = 0; dly < 32; dly++) {
+            NKFADC500write_ADCDLY(fSid, ch, dly);
+            bool good = (NKFADC500read_ADCSTAT(fSid) >> (ch - 1)) & 0x1;
+            if (!good) {
+                inBad = true;
+                count++;
+                sum += dly;
+            } else if (inBad) {
+                break;
+            }
+        }
+        int center = count > 0 ? sum / count : 0;   // 나쁜 구간을 못 찾음: 벤더 함수는 0 으로 나눔
+        if (count == 0) ok = false;
+        unsigned int gdly = center < 11 ? center + 11 : center - 11;
+        NKFADC500write_ADCDLY(fSid, ch, gdly);
+        result.adcDly[ch - 1] = gdly;
+    }
+
+    NKFADC500write_ADCALIGN(fSid, 0);
+    NKFADC500send_ADCCAL(fSid);
+    return ok;
+}
+
+// NKFADC500_ADCALIGN_DRAM 과 같은 절차. 레인마다 테스트 패턴이 5번 넘게 연속으로 맞는 지연 구간의 중심 + bitslip
+bool Fadc500Device::SweepDram(Alignment& result) {
+    bool ok = true;
+    NKFADC500write_DRAMON(fSid, 1);
+    NKFADC500write_DRAMTEST(fSid, 1);
+    NKFADC500send_ADCCAL(fSid);      // iodelay 리셋
+    NKFADC500write_DRAMTEST(fSid, 2);
+
+    for (int ch = 0; ch < 8; ch++) {
+        int count = 0, sum = 0;
+        bool found = false;
+        for (int dly = 0; dly < 32; dly++) {
+            NKFADC500write_DRAMDLY(fSid, ch, dly);
+            NKFADC500write_DRAMTEST(fSid, 3);
+            unsigned long value = NKFADC500read_DRAMTEST(fSid, ch);
+            bool pattern = value == 0xFFAA5500 || value == 0xAA5500FF || value == 0x5500FFAA || value == 0x00FFAA55;
+            if (pattern) {
+                count++;
+                sum += dly;
+                if (count > 4) found = true;
+            } else if (found) {
+                break;
+            } else {
+                count = sum = 0;
+            }
+        }
+        unsigned int gdly = count > 0 ? sum / count : 9;
+        NKFADC500write_DRAMDLY(fSid, ch, gdly);
+        result.dramDly[ch] = gdly;
+
+        bool aligned = false;
+        result.bitslip[ch] = 0;
+        for (int bitslip = 0; bitslip < 4; bitslip++) {
+            NKFADC500write_DRAMTEST(fSid, 3);
+            if (NKFADC500read_DRAMTEST(fSid, ch) == 0xFFAA5500) {
+                aligned = true;
+                result.bitslip[ch] = bitslip;
+                break;
+            }
+            NKFADC500write_BITSLIP(fSid, ch);
+        }
+        if (!aligned) {
+            ELog::Print(ELog::ERROR, Form("[MID %d] Fail to align DRAM(%d)!", fSid, ch));
+            ok = false;
+        }
+    }
+
+    NKFADC500write_DRAMTEST(fSid, 0);
+    return ok;
+}
+
+// 저장된 값을 스윕과 같은 순서로 써 넣고, ADC 는 ADCSTAT, DRAM 은 테스트 패턴을 한 번씩 읽어 확인
+bool Fadc500Device::ApplyAlignment(const Alignment& result) {
+    bool ok = true;
+    NKFADC500send_ADCCAL(fSid);
+    NKFADC500write_ADCALIGN(fSid, 1);
+    for (int ch = 1; ch <= 4; ch++) NKFADC500write_ADCDLY(fSid, ch, result.adcDly[ch - 1]);
+    unsigned long adcStat = NKFADC500read_ADCSTAT(fSid);
+    if ((adcStat & 0xF) != 0xF) ok = false;
+    NKFADC500write_ADCALIGN(fSid, 0);
+    NKFADC500send_ADCCAL(fSid);
+    if (!ok) return false;
+
+    NKFADC500write_DRAMON(fSid, 1);
+    NKFADC500write_DRAMTEST(fSid, 1);
+    NKFADC500send_ADCCAL(fSid);
+    NKFADC500write_DRAMTEST(fSid, 2);
+    for (int ch = 0; ch < 8 && ok; ch++) {
+        NKFADC500write_DRAMDLY(fSid, ch, result.dramDly[ch]);
+        for (unsigned int i = 0; i < result.bitslip[ch]; i++) NKFADC500write_BITSLIP(fSid, ch);
+        NKFADC500write_DRAMTEST(fSid, 3);
+        if (NKFADC500read_DRAMTEST(fSid, ch) != 0xFFAA5500) ok = false;
+    }
+    NKFADC500write_DRAMTEST(fSid, 0);
+    return ok;
+}
+
+std::string Fadc500Device::AlignCachePath(int sampling) const {
+    std::string dir = fAlignCacheDir;
+    if (dir.empty()) {
+        const char* home = getenv("HOME");
+        dir = std::string(home ? home : "/tmp") + "/.cache/nkfadc500";
+    }
+    return dir + Form("/align_mid%d_dsr%d.txt", fSid, sampling);
+}
+
+bool Fadc500Device::LoadAlignment(const std::string& path, Alignment& result) const {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    int have = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream iss(line);
+        std::string key;
+        if (!(iss >> key) || key[0] == '#') continue;
+        unsigned int* dst = nullptr;
+        int n = 0;
+        if (key == "ADCDLY")       { dst = result.adcDly; n = 4; }
+        else if (key == "DRAMDLY") { dst = result.dramDly; n = 8; }
+        else if (key == "BITSLIP") { dst = result.bitslip; n = 8; }
+        else continue;
+        int i = 0;
+        while (i < n && iss >> dst[i]) i++;
+        if (i == n) have++;
+    }
+    return have == 3;
+}
+
+// 디렉터리가 없으면 만들고 임시 파일에 쓴 뒤 rename (동시에 뜬 다른 프로세스가 반쯤 쓴 파일을 읽지 않도록)
+void Fadc500Device::SaveAlignment(const std::string& path, const Alignment& result) const {
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1)) {
+        mkdir(path.substr(0, pos).c_str(), 0755);
+    }
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp);
+        if (!out) {
+            ELog::Print(ELog::WARNING, "Cannot write alignment cache " + path);
+            return;
+        }
+        out << "# NKFADC500 ADC/DRAM alignment (MID " << fSid << "). Delete this file or use ALIGN_CACHE 2 to re-align.\n";
+        out << "ADCDLY";
+        for (unsigned int v : result.adcDly) out << " " << v;
+        out << "\nDRAMDLY";
+        for (unsigned int v : result.dramDly) out << " " << v;
+        out << "\nBITSLIP";
+        for (unsigned int v : result.bitslip) out << " " << v;
+        out << "\n";
+    }
+    std::rename(tmp.c_str(), path.c_str());
 }
 
 void Fadc500Device::ClearAndFlushUSB() {
@@ -117,8 +443,126 @@ unsigned int Fadc500Device::ReadBCOUNT() {
     return NKFADC500read_BCOUNT(fSid);
 }
 
+// 레지스터 6개 (LIVETIME lsb/msb + 채널 4개). BCOUNT 와 같은 제어 경로라 진행 중인 bulk 전송과 섞여도 안전
+bool Fadc500Device::ReadCounters(DeviceCounters& counters) {
+    counters.liveTicks = NKFADC500read_LIVETIME(fSid);
+    for (int ch = 0; ch < 4; ch++) {
+        counters.triggers[ch] = (uint32_t)NKFADC500read_EVENT_NUMBER(fSid, ch + 1);
+    }
+    return true;
+}
+
+// 런 중에는 reset/measure_PED 없이 해당 레지스터만 씀. 섀도와 같은 값이면 전송하지 않음
+bool Fadc500Device::ApplyLiveChange(FadcBD* bdConfig, int param, int ch) {
+    const int first = ch < 0 ? 0 : ch;
+    const int last = ch < 0 ? bdConfig->NCHANNEL() - 1 : ch;
+    switch (param) {
+        case DataFormat::kCfgTHR:
+            for (int c = first; c <= last; c++) StageChannel(kRegTHR, c + 1, (uint32_t)bdConfig->GetTHR(c));
+            break;
+        case DataFormat::kCfgDLY:
+            for (int c = first; c <= last; c++) {
+                unsigned long apply_dly = bdConfig->GetCW(c) + bdConfig->GetDLY(c);
+                StageChannel(kRegDLY, c + 1, (uint32_t)(((apply_dly / 1000) << 10) | (apply_dly % 1000)));
+            }
+            break;
+        case DataFormat::kCfgPSW:
+            for (int c = first; c <= last; c++) StageChannel(kRegPSW, c + 1, (uint32_t)bdConfig->GetPSW(c));
+            break;
+        case DataFormat::kCfgTRIGEN:
+            fShadow.Stage(kRegTRIGENABLE, (uint32_t)bdConfig->GetTRIGEN());
+            break;
+        default:
+            return false;
+    }
+    FlushRegisters();
+    return true;
+}
+
+// measure_PED 는 명령 레지스터라 섀도를 거치지 않음. read_PED 의 12-bit 범위 밖 값은 통신 오류로 봄
+bool Fadc500Device::MeasurePedestals(FadcBD* bdConfig, int pedestal[4]) {
+    const int nch = std::min(bdConfig->NCHANNEL(), 4);
+    for (int ch = 0; ch < nch; ch++) StageChannel(kRegDACOFF, ch + 1, (uint32_t)bdConfig->GetDACOFF(ch));
+    FlushRegisters();
+    if (fDacSettleMs > 0) usleep((useconds_t)fDacSettleMs * 1000);
+
+    for (int ch = 0; ch < nch; ch++) NKFADC500measure_PED(fSid, ch + 1);
+    for (int ch = 0; ch < nch; ch++) {
+        unsigned long ped = NKFADC500read_PED(fSid, ch + 1);
+        if (ped > 4095) {
+            ELog::Print(ELog::ERROR, Form("read_PED failed (MID: %d, ch %d, value 0x%lx).", fSid, ch, ped));
+            return false;
+        }
+        pedestal[ch] = (int)ped;
+    }
+    return true;
+}
+
 void Fadc500Device::ReadDATA(unsigned int bcount_kb, unsigned char* dest) {
-    if (bcount_kb > 0) {
+    if (bcount_kb == 0) return;
+
+    int status = 0;
+    if (fAsyncReader) {
+        status = fAsyncReader->Read(dest, (size_t)bcount_kb * 1024);
+    } else if (fDirectChunkBytes > 0) {
+        status = ReadDirect(dest, (size_t)bcount_kb * 1024);
+    } else {
         NKFADC500read_DATA(fSid, bcount_kb, (char*)dest);
     }
+
+    if (status < 0) {
+        // 벤더 USB3Read 와 동일하게 오류 시 FX3 엔드포인트 리셋
+        ELog::Print(ELog::ERROR, Form("ReadDATA failed (MID: %d, %u KB, error = %d). Resetting USB endpoint.", fSid, bcount_kb, status));
+        USB3Reset(NKFADC500_VENDOR_ID, NKFADC500_PRODUCT_ID, fSid);
+    }
+}
+
+bool Fadc500Device::AttachTransport() {
+    if (fTransport) return true;
+
+    // nkusb 의 open 리스트 탐색은 여기서 한 번만 수행하고 핸들을 재사용
+    libusb_device_handle* devh = nkusb_get_device_handle(NKFADC500_VENDOR_ID, NKFADC500_PRODUCT_ID, fSid);
+    if (!devh) {
+        ELog::Print(ELog::ERROR, Form("No libusb device handle for MID %d. Falling back to vendor USB calls.", fSid));
+        return false;
+    }
+    fTransport = new LibusbTransport(devh);
+    return true;
+}
+
+int Fadc500Device::ReadDirect(unsigned char* dest, size_t bytes) {
+    int rc = fTransport->SendReadCommand((uint32_t)(bytes / 4), 0x40000000);
+    if (rc < 0) return rc;
+
+    size_t done = 0;
+    while (done < bytes) {
+        int length = (int)std::min(fDirectChunkBytes, bytes - done);
+        int actual = 0;
+        rc = fTransport->ReadBulk(dest + done, length, &actual);
+        if (rc < 0) return rc;
+        if (actual != length) return -1;
+        done += length;
+    }
+    return 0;
+}
+
+void Fadc500Device::EnableDirectReadout(int chunkKB) {
+    if (!AttachTransport()) return;
+
+    delete fAsyncReader;
+    fAsyncReader = nullptr;
+    fDirectChunkBytes = (chunkKB > 0 ? (size_t)chunkKB : 1) * 1024;
+
+    ELog::Print(ELog::INFO, Form("[USB DIRECT] Zero-copy readout enabled (MID: %d, Chunk: %zu KB)", fSid, fDirectChunkBytes / 1024));
+}
+
+void Fadc500Device::EnableAsyncReadout(int depth, int chunkKB) {
+    if (!AttachTransport()) return;
+
+    delete fAsyncReader;
+    fDirectChunkBytes = 0;
+    fAsyncReader = new AsyncUsbReader(fTransport, depth, (size_t)chunkKB * 1024);
+
+    ELog::Print(ELog::INFO, Form("[USB ASYNC] Async readout enabled (MID: %d, Depth: %d, Chunk: %zu KB)",
+                                 fSid, fAsyncReader->GetDepth(), fAsyncReader->GetChunkBytes() / 1024));
 }
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include "LiveRing.hh"
+#include "EventFramer.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static uint64_t SteadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 리더가 세그먼트 교체(다른 크기로 새로 만든 경우)를 확인하는 주기
+static const uint64_t kReplaceCheckNs = 1000000000ULL;
+
+LiveRingWriter::LiveRingWriter() : fMap(nullptr), fMapBytes(0), fHeader(nullptr), fStride(0), fPublished(0) {}
+
+LiveRingWriter::~LiveRingWriter() {
+    Close();
+}
+
+bool LiveRingWriter::Open(const std::string& name, size_t ringBytes, size_t slotBytes) {
+    Close();
+
+    // 슬롯 본문은 4KB 단위, 최소 2 슬롯
+    slotBytes = (std::max(slotBytes, (size_t)4096) + 4095) & ~(size_t)4095;
+    fStride = sizeof(LiveRingSlot) + slotBytes;
+    size_t slotCount = std::max(ringBytes / fStride, (size_t)2);
+    size_t total = sizeof(LiveRingHeader) + slotCount * fStride;
+
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    if ((size_t)st.st_size != total) {
+        // 크기가 다른 이전 세그먼트: 붙어 있는 리더가 SIGBUS 를 맞지 않도록 줄이지 않고 새 객체로 교체
+        if (st.st_size != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+            if (fd < 0) return false;
+        }
+        if (ftruncate(fd, (off_t)total) != 0) {
+            close(fd);
+            return false;
+        }
+    }
+
+    // 런 도중 첫 기록에서 page fault 가 나지 않도록 미리 매핑
+    void* map = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    fName = name;
+    fMap = map;
+    fMapBytes = total;
+    fHeader = static_cast<LiveRingHeader*>(map);
+
+    // 재사용 세그먼트: 이전 런의 슬롯을 무효화하고 epoch 를 바꿔 리더가 새 런으로 인식하게 함
+    // (같은 크기로 재사용하므로 slotCount/slotBytes 는 붙어 있는 리더가 보던 값과 동일)
+    fHeader->live.store(0, std::memory_order_relaxed);
+    fHeader->writeSeq.store(0, std::memory_order_relaxed);
+    fHeader->version = kLiveRingVersion;
+    fHeader->headerBytes = sizeof(LiveRingHeader);
+    fHeader->slotCount = (uint32_t)slotCount;
+    fHeader->slotBytes = (uint32_t)slotBytes;
+    for (size_t i = 0; i < slotCount; i++) SlotAt(i)->seq.store(0, std::memory_order_relaxed);
+    fHeader->writerPid = (int32_t)getpid();
+    fHeader->epoch.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::system_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    fHeader->magic = kLiveRingMagic;
+    fHeader->live.store(1, std::memory_order_release);
+
+    fPublished = 0;
+    return true;
+}
+
+void LiveRingWriter::Close() {
+    if (!fMap) return;
+    fHeader->live.store(0, std::memory_order_release);
+    munmap(fMap, fMapBytes);
+    fMap = nullptr;
+    fHeader = nullptr;
+    fMapBytes = 0;
+}
+
+LiveRingSlot* LiveRingWriter::SlotAt(uint64_t n) const {
+    unsigned char* base = static_cast<unsigned char*>(fMap) + sizeof(LiveRingHeader);
+    return reinterpret_cast<LiveRingSlot*>(base + (n % fHeader->slotCount) * fStride);
+}
+
+uint32_t LiveRingWriter::Publish(int mid, const unsigned char* data, size_t len, const std::vector<uint32_t>& offsets,
+                                 uint64_t firstEvent, uint64_t stampNs) {
+    if (!fHeader || offsets.empty()) return 0;
+
+    // 블록 안에서 끝나는 이벤트만, 슬롯 용량까지 (블록 경계에 걸친 마지막 이벤트는 제외)
+    const size_t start = offsets[0];
+    const size_t cap = fHeader->slotBytes;
+    size_t end = start;
+    uint32_t nEvents = 0;
+    for (size_t i = 0; i < offsets.size(); i++) {
+        uint64_t evBytes = EventFramer::EventBytes(data + offsets[i]);
+        if (evBytes == 0) break;
+        size_t evEnd = offsets[i] + evBytes;
+        if (evEnd > len || evEnd - start > cap) break;
+        end = evEnd;
+        nEvents++;
+    }
+    if (nEvents == 0) return 0;
+
+    const uint64_t n = fHeader->writeSeq.fetch_add(1, std::memory_order_acq_rel);
+    LiveRingSlot* slot = SlotAt(n);
+    slot->seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->firstEvent = firstEvent;
+    slot->stampNs = stampNs;
+    slot->bytes = (uint32_t)(end - start);
+    slot->nEvents = nEvents;
+    slot->mid = mid;
+    std::memcpy(reinterpret_cast<unsigned char*>(slot) + sizeof(LiveRingSlot), data + start, end - start);
+
+    slot->seq.store(2 * n + 2, std::memory_order_release);
+    fPublished++;
+    return nEvents;
+}
+
+LiveRingReader::LiveRingReader()
+    : fMap(nullptr), fMapBytes(0), fHeader(nullptr), fStride(0), fIno(0), fEpoch(0), fNext(0),
+      fSkipped(0), fRead(0), fLastCheckNs(0) {}
+
+LiveRingReader::~LiveRingReader() {
+    Detach();
+}
+
+bool LiveRingReader::Attach(const std::string& name) {
+    Detach();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(LiveRingHeader)) {
+        close(fd);
+        return false;
+    }
+    void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+
+    const LiveRingHeader* hdr = static_cast<const LiveRingHeader*>(map);
+    bool valid = hdr->magic == kLiveRingMagic && hdr->version == kLiveRingVersion && hdr->slotCount >= 2 &&
+                 sizeof(LiveRingHeader) + (size_t)hdr->slotCount * (sizeof(LiveRingSlot) + hdr->slotBytes) == (size_t)st.st_size;
+    if (!valid) {
+        // Writer 가 아직 초기화 중이거나 다른 버전
+        munmap(map, st.st_size);
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    fName = name;
+    fMap = map;
+    fMapBytes = st.st_size;
+    fHeader = hdr;
+    fStride = sizeof(LiveRingSlot) + hdr->slotBytes;
+    fIno = st.st_ino;
+    fEpoch = hdr->epoch.load(std::memory_order_acquire);
+
+    // 가장 최근 슬롯부터 시작 (모니터가 붙자마자 화면을 채우도록)
+    uint64_t w = hdr->writeSeq.load(std::memory_order_acquire);
+    fNext = w > 0 ? w - 1 : 0;
+    fLastCheckNs = SteadyNowNs();
+    return true;
+}
+
+void LiveRingReader::Detach() {
+    if (!fMap) return;
+    munmap(fMap, fMapBytes);
+    fMap = nullptr;
+    fHeader = nullptr;
+    fMapBytes = 0;
+}
+
+// 같은 이름이 다른 세그먼트를 가리키면 (Writer 가 다른 크기로 다시 만듦) true
+bool LiveRingReader::Replaced() {
+    int fd = shm_open(fName.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat st;
+    bool replaced = fstat(fd, &st) == 0 && st.st_ino != fIno;
+    close(fd);
+    return replaced;
+}
+
+const LiveRingSlot* LiveRingReader::SlotAt(uint64_t n) const {
+    return reinterpret_cast<const LiveRingSlot*>(static_cast<const unsigned char*>(fMap) + sizeof(LiveRingHeader) +
+                                                 (n % fHeader->slotCount) * fStride);
+}
+
+LiveRingReader::Status LiveRingReader::Next(LiveBlock& block, int mid) {
+    if (!fHeader) return kEmpty;
+
+    const uint32_t slotCount = fHeader->slotCount;
+    uint64_t epoch = fHeader->epoch.load(std::memory_order_acquire);
+    uint64_t w = fHeader->writeSeq.load(std::memory_order_acquire);
+
+    // 새 런이 세그먼트를 다시 열었음 (writeSeq 도 0 부터 다시 셈)
+    if (epoch != fEpoch) {
+        fEpoch = epoch;
+        fNext = w > 0 ? w - 1 : 0;
+        return kNewRun;
+    }
+    // Writer 가 초기화 중 (epoch 갱신 직전): 다음 호출에서 새 런으로 처리
+    if (w < fNext) {
+        fNext = w;
+        return kEmpty;
+    }
+
+    while (fNext < w) {
+        // 한 바퀴 이상 뒤처짐: 덮어쓰인 구간을 건너뛰고 최신 슬롯으로
+        if (w - fNext >= slotCount) {
+            fSkipped += w - 1 - fNext;
+            fNext = w - 1;
+        }
+
+        const LiveRingSlot* slot = SlotAt(fNext);
+        const uint64_t expect = 2 * fNext + 2;
+
+        uint64_t s1 = slot->seq.load(std::memory_order_acquire);
+        if (s1 < expect) return kEmpty;   // Writer 가 예약만 하고 아직 기록 중
+        if (s1 == expect) {
+            int slotMid = slot->mid;
+            uint32_t bytes = std::min(slot->bytes, fHeader->slotBytes);
+            if (mid < 0 || slotMid == mid) {
+                block.mid = slotMid;
+                block.firstEvent = slot->firstEvent;
+                block.stampNs = slot->stampNs;
+                block.nEvents = slot->nEvents;
+                block.data.resize(bytes);
+                std::memcpy(block.data.data(), reinterpret_cast<const unsigned char*>(slot) + sizeof(LiveRingSlot), bytes);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot->seq.load(std::memory_order_relaxed) == s1) {
+                fNext++;
+                if (mid >= 0 && slotMid != mid) continue;
+                fRead++;
+                return kBlock;
+            }
+        }
+
+        // 복사 도중 (또는 그 전에) Writer 가 슬롯을 재사용함
+        fSkipped++;
+        fNext++;
+        w = fHeader->writeSeq.load(std::memory_order_acquire);
+    }
+
+    // 새 데이터가 없을 때만 가끔 세그먼트 교체 여부 확인
+    uint64_t now = SteadyNowNs();
+    if (now - fLastCheckNs > kReplaceCheckNs) {
+        fLastCheckNs = now;
+        if (Replaced()) {
+            std::string name = fName;
+            if (Attach(name)) return kNewRun;
+        }
+    }
+    return kEmpty;
+}
+
+LiveRingReader::Status LiveRingReader::Latest(LiveBlock& block, int mid) {
+    if (!fHeader) return kEmpty;
+
+    uint64_t w = fHeader->writeSeq.load(std::memory_order_acquire);
+    if (fHeader->epoch.load(std::memory_order_acquire) == fEpoch && w > fNext + 1) {
+        // 선택 보드의 가장 최근 슬롯을 뒤에서부터 찾음 (mid 는 힌트일 뿐, 실제 검증은 Next 의 seq 비교)
+        uint64_t oldest = w - std::min<uint64_t>(w - fNext, fHeader->slotCount - 1);
+        uint64_t n = w - 1;
+        if (mid >= 0) {
+            while (n > oldest && SlotAt(n)->mid != mid) n--;
+        }
+        fNext = n;
+    }
+    return Next(block, mid);
+}
@@ -0,0 +1,147 @@
+#include "OverflowSink.hh"
+#include "DaqOptions.hh"
+#include "DataFormat.hh"
+#include "EventFramer.hh"
+#include "ELog.hh"
+
+#include <algorithm>
+#include <cstring>
+
+OverflowSink::OverflowSink(int policy, int pedSamples)
+    : fPolicy(policy), fPedSamples(std::max(pedSamples, 1)), fMid(0), fFp(nullptr), fDegraded(false),
+      fEventBytes(0), fBytes(0), fStoredBytes(0), fRecords(0), fWriteErrors(0) {}
+
+OverflowSink::~OverflowSink() {
+    Close();
+}
+
+const char* OverflowSink::PolicyName(int policy) {
+    switch (policy) {
+        case DaqOptions::kBackpressureBlock:    return "block";
+        case DaqOptions::kBackpressureDrop:     return "drop";
+        case DaqOptions::kBackpressureSpill:    return "spill";
+        case DaqOptions::kBackpressureFeatures: return "features-only";
+        default:                                return "unknown";
+    }
+}
+
+void OverflowSink::SetPath(const std::string& path, int mid) {
+    fPath = path;
+    fMid = mid;
+}
+
+bool OverflowSink::OpenFile() {
+    fFp = fopen(fPath.c_str(), "wb");
+    if (!fFp) {
+        ELog::Print(ELog::ERROR, Form("[MID %d] Cannot open %s for backpressure %s. Dropping instead.",
+                                      fMid, fPath.c_str(), PolicyName(fPolicy)));
+        fDegraded = true;
+        return false;
+    }
+    // Producer 스레드에서 기록하므로 큰 stdio 버퍼로 write 호출 횟수를 줄임
+    setvbuf(fFp, nullptr, _IOFBF, fPolicy == DaqOptions::kBackpressureSpill ? 16 * 1024 * 1024 : 1024 * 1024);
+
+    if (fPolicy == DaqOptions::kBackpressureFeatures) {
+        DataFormat::FeatureHeader hdr;
+        std::memset(&hdr, 0, sizeof(hdr));
+        hdr.magic = DataFormat::kFeatureMagic;
+        hdr.version = DataFormat::kFeatureVersion;
+        hdr.recordBytes = sizeof(DataFormat::FeatureRecord);
+        hdr.mid = fMid;
+        hdr.pedSamples = (uint32_t)fPedSamples;
+        Put(&hdr, sizeof(hdr));
+    }
+    ELog::Print(ELog::INFO, Form("[MID %d] Backpressure %s output: %s", fMid, PolicyName(fPolicy), fPath.c_str()));
+    return true;
+}
+
+void OverflowSink::Put(const void* data, size_t len) {
+    if (fwrite(data, 1, len, fFp) == len) fStoredBytes += len;
+    else fWriteErrors++;
+}
+
+void OverflowSink::Write(const unsigned char* data, size_t len) {
+    if (len == 0) return;
+    fBytes += len;
+    if (fPolicy != DaqOptions::kBackpressureSpill && fPolicy != DaqOptions::kBackpressureFeatures) return;
+    if (fDegraded || (!fFp && !OpenFile())) return;
+
+    if (fPolicy == DaqOptions::kBackpressureSpill) Put(data, len);
+    else FeedFeatures(data, len);
+}
+
+void OverflowSink::FeedFeatures(const unsigned char* data, size_t len) {
+    size_t pos = 0;
+    while (pos < len) {
+        // 블록 안에 통째로 있는 이벤트는 복사 없이 바로 처리
+        if (fEvent.empty() && len - pos >= DataFormat::kEventHeaderBytes) {
+            uint64_t bytes = EventFramer::EventBytes(data + pos);
+            if (bytes == 0) { fWriteErrors++; return; }   // 경계가 어긋남: 이 호출의 나머지는 버림
+            if (len - pos >= bytes) {
+                WriteFeature(data + pos, bytes);
+                pos += bytes;
+                continue;
+            }
+        }
+
+        // Write 경계에 걸린 이벤트: 헤더로 크기를 알아낸 뒤 끝까지 모음
+        size_t need = fEventBytes > 0 ? (size_t)(fEventBytes - fEvent.size()) : DataFormat::kEventHeaderBytes - fEvent.size();
+        size_t take = std::min(need, len - pos);
+        fEvent.insert(fEvent.end(), data + pos, data + pos + take);
+        pos += take;
+        if (fEventBytes == 0 && fEvent.size() == DataFormat::kEventHeaderBytes) {
+            fEventBytes = EventFramer::EventBytes(fEvent.data());
+            if (fEventBytes == 0) { fWriteErrors++; fEvent.clear(); return; }
+        }
+        if (fEventBytes > 0 && fEvent.size() == fEventBytes) {
+            WriteFeature(fEvent.data(), fEventBytes);
+            fEvent.clear();
+            fEventBytes = 0;
+        }
+    }
+}
+
+void OverflowSink::WriteFeature(const unsigned char* event, uint64_t eventBytes) {
+    const unsigned char* hdr = event;
+    const unsigned char* wave = event + DataFormat::kEventHeaderBytes;
+    const int samples = (int)((eventBytes - DataFormat::kEventHeaderBytes) / 8);
+    const int nPed = std::min(fPedSamples, samples);
+
+    DataFormat::FeatureRecord rec;
+    std::memset(&rec, 0, sizeof(rec));
+    rec.triggerTime = EventFramer::TriggerTime(hdr);
+    rec.triggerNumber = hdr[28] | (hdr[32] << 8) | (hdr[36] << 16) | ((uint32_t)hdr[40] << 24);
+    rec.recordLength = (uint32_t)samples;
+    rec.pattern = hdr[84] | (hdr[88] << 8) | (hdr[92] << 16) | ((uint32_t)hdr[96] << 24);
+
+    // 샘플 j 의 채널 ch = (byte[8j + ch] | byte[8j + 4 + ch] << 8) & 0xFFF
+    for (int ch = 0; ch < 4; ch++) {
+        double pedSum = 0;
+        for (int j = 0; j < nPed; j++) pedSum += (wave[j * 8 + ch] | (wave[j * 8 + 4 + ch] << 8)) & 0x0FFF;
+        double baseline = nPed > 0 ? pedSum / nPed : 0;
+
+        double amplitude = -9999, charge = 0;
+        int peak = 0;
+        for (int j = 0; j < samples; j++) {
+            double drop = baseline - ((wave[j * 8 + ch] | (wave[j * 8 + 4 + ch] << 8)) & 0x0FFF);
+            if (drop > 0) charge += drop;
+            if (drop > amplitude) { amplitude = drop; peak = j; }
+        }
+        rec.baseline[ch] = (float)baseline;
+        rec.amplitude[ch] = (float)amplitude;
+        rec.charge[ch] = (float)charge;
+        rec.peak[ch] = (uint16_t)std::min(peak, 0xFFFF);
+    }
+    Put(&rec, sizeof(rec));
+    fRecords++;
+}
+
+void OverflowSink::Close() {
+    if (fFp) {
+        if (fflush(fFp) != 0) fWriteErrors++;
+        fclose(fFp);
+        fFp = nullptr;
+    }
+    fEvent.clear();
+    fEventBytes = 0;
+}
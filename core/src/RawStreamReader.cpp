@@ -0,0 +1,255 @@
+#include "RawStreamReader.hh"
+#include "ELog.hh"
+#include "BlockCodec.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <sys/types.h>
+
+RawStreamReader::RawStreamReader(FILE* fp, int mid)
+    : fFp(fp), fRequestedMid(mid), fMid(mid), fMode(kUnknown),
+      fBlockRemain(0), fPadRemain(0), fDiscardRemain(0),
+      fCompressed(false), fZLoad(false), fZHave(0), fZPos(0), fZAvail(0), fZErrors(0)
+{
+    fScratch.resize(64 * 1024);
+}
+
+void RawStreamReader::Rewind() {
+    rewind(fFp);
+    fMid = fRequestedMid;
+    fMode = kUnknown;
+    fBlockRemain = 0;
+    fPadRemain = 0;
+    fDiscardRemain = 0;
+    fZLoad = false;
+    fZAvail = 0;
+    fPending.clear();
+    fLiveTime.clear();
+    fConfigChanges.clear();
+}
+
+bool RawStreamReader::Seek(uint64_t offset, uint32_t blockSkip) {
+    if (fseeko(fFp, (off_t)offset, SEEK_SET) != 0) return false;
+    // 이동한 위치가 Block Tag 면 병합, 이벤트 헤더면 단일 스트림으로 다시 판별
+    fMode = kUnknown;
+    fBlockRemain = 0;
+    fPadRemain = 0;
+    fDiscardRemain = 0;
+    fZLoad = false;
+    fZAvail = 0;
+    fPending.clear();
+    return Skip(blockSkip);
+}
+
+bool RawStreamReader::Read(void* dest, size_t bytes) {
+    unsigned char* out = static_cast<unsigned char*>(dest);
+
+    // 1. 직전 실패한 Read 에서 확보해 둔 바이트부터 사용
+    size_t have = std::min(fPending.size(), bytes);
+    if (have > 0) {
+        std::memcpy(out, fPending.data(), have);
+        fPending.erase(fPending.begin(), fPending.begin() + have);
+    }
+
+    // 2. 나머지는 파일에서 직접 채움 (중간 복사 없음)
+    size_t got = have + Fill(out + have, bytes - have);
+    if (got == bytes) return true;
+
+    // 3. 데이터 부족: 확보한 부분을 보관하고 다음 호출에서 이어서 채움
+    fPending.insert(fPending.begin(), out, out + got);
+    return false;
+}
+
+bool RawStreamReader::Skip(size_t bytes) {
+    while (bytes > 0) {
+        size_t n = std::min(bytes, fScratch.size());
+        if (!Read(fScratch.data(), n)) return false;
+        bytes -= n;
+    }
+    return true;
+}
+
+size_t RawStreamReader::Fill(unsigned char* dest, size_t bytes) {
+    size_t done = 0;
+
+    while (done < bytes) {
+        if (fMode == kUnknown && !DetectMode()) return done;
+
+        if (fMode == kPlain) {
+            size_t r = fread(dest + done, 1, bytes - done, fFp);
+            done += r;
+            if (done < bytes) { clearerr(fFp); return done; }
+            continue;
+        }
+
+        // 병합 스트림: 현재 블록 소진 -> 패딩 건너뜀 -> 다음 레코드 해석
+        if (fDiscardRemain > 0 && !Discard()) return done;
+        if (fZLoad && !LoadZBlock()) return done;
+
+        if (fZAvail > 0) {
+            size_t take = std::min(bytes - done, fZAvail);
+            std::memcpy(dest + done, fZRaw.data() + fZPos, take);
+            fZPos += take;
+            fZAvail -= take;
+            done += take;
+            continue;
+        }
+
+        if (fBlockRemain == 0) {
+            if (fPadRemain > 0) { fDiscardRemain = fPadRemain; fPadRemain = 0; continue; }
+            if (!NextRecord()) return done;
+            continue;
+        }
+
+        size_t take = (size_t)std::min<uint64_t>(bytes - done, fBlockRemain);
+        size_t r = fread(dest + done, 1, take, fFp);
+        done += r;
+        fBlockRemain -= r;
+        if (r < take) { clearerr(fFp); return done; }
+    }
+    return done;
+}
+
+bool RawStreamReader::DetectMode() {
+    unsigned char probe[DataFormat::kAuxRecordBytes];
+    size_t r = fread(probe, 1, sizeof(probe), fFp);
+    if (r > 0) fseek(fFp, -static_cast<long>(r), SEEK_CUR);
+    clearerr(fFp);
+    if (r < sizeof(probe)) return false;
+
+    fMode = DataFormat::IsAuxRecord(probe) ? kMerged : kPlain;
+    return true;
+}
+
+bool RawStreamReader::NextRecord() {
+    DataFormat::AuxRecord rec;
+    size_t r = fread(&rec, 1, sizeof(rec), fFp);
+    if (r < sizeof(rec)) {
+        if (r > 0) fseek(fFp, -static_cast<long>(r), SEEK_CUR);
+        clearerr(fFp);
+        return false;
+    }
+
+    if (!DataFormat::IsAuxRecord(reinterpret_cast<const unsigned char*>(&rec))) {
+        // 병합 스트림에서는 모든 보드 데이터가 레코드 안에 있으므로 여기서 이벤트 헤더가 보이면 손상된 파일
+        fseek(fFp, -static_cast<long>(sizeof(rec)), SEEK_CUR);
+        ELog::Print(ELog::WARNING, "Corrupted merged stream: expected an aux record. Stopping.");
+        return false;
+    }
+
+    if (rec.type == DataFormat::kAuxBlockTag || rec.type == DataFormat::kAuxZBlock) {
+        fSeenMids.insert(rec.mid);
+        if (fMid < 0) {
+            fMid = rec.mid;
+            ELog::Print(ELog::INFO, Form("Block-record stream detected. Selecting board MID %d.", fMid));
+        }
+        if (rec.mid == fMid) {
+            fDiscardRemain = rec.prePadBytes;
+            fPadRemain = rec.padBytes;
+            if (rec.type == DataFormat::kAuxBlockTag) {
+                fBlockRemain = rec.payloadBytes;
+            } else {
+                fCompressed = true;
+                fZRec = rec;
+                fZLoad = true;
+                fZHave = 0;
+            }
+            return true;
+        }
+    }
+
+    // 다른 보드의 블록 또는 블록 이외의 Aux 레코드: 본문 + 패딩 통째로 건너뜀
+    NoteAux(rec);
+    fDiscardRemain = (uint64_t)rec.prePadBytes + rec.payloadBytes + rec.padBytes;
+    return true;
+}
+
+void RawStreamReader::NoteAux(const DataFormat::AuxRecord& rec) {
+    if (rec.type == DataFormat::kAuxLiveTime) fLiveTime.emplace_back(rec.mid, DataFormat::GetLiveTimeSample(rec));
+    else if (rec.type == DataFormat::kAuxConfigChange) fConfigChanges.emplace_back(rec.mid, DataFormat::GetConfigChange(rec));
+}
+
+void RawStreamReader::ReadTrailer(const unsigned char* rec128) {
+    DataFormat::AuxRecord rec;
+    std::memcpy(&rec, rec128, sizeof(rec));
+    while (true) {
+        NoteAux(rec);
+        if (!Skip((size_t)rec.prePadBytes + rec.payloadBytes + rec.padBytes)) return;
+        if (!Read(&rec, sizeof(rec))) return;
+        if (!DataFormat::IsAuxRecord(reinterpret_cast<const unsigned char*>(&rec))) return;
+    }
+}
+
+std::vector<DataFormat::LiveTimeSample> RawStreamReader::GetLiveTime() const {
+    std::vector<DataFormat::LiveTimeSample> out;
+    for (const auto& entry : fLiveTime) {
+        if (fMid < 0 || entry.first == fMid) out.push_back(entry.second);
+    }
+    return out;
+}
+
+std::vector<DataFormat::ConfigChange> RawStreamReader::GetConfigChanges() const {
+    std::vector<DataFormat::ConfigChange> out;
+    for (const auto& entry : fConfigChanges) {
+        if (fMid < 0 || entry.first == fMid) out.push_back(entry.second);
+    }
+    return out;
+}
+
+bool RawStreamReader::LoadZBlock() {
+    const size_t need = fZRec.payloadBytes;
+    if (fZComp.size() < need) fZComp.resize(need);
+
+    // tail 모드: 본문이 아직 다 기록되지 않았으면 읽은 만큼 보관하고 다음 호출에서 이어서 읽음
+    size_t r = fread(fZComp.data() + fZHave, 1, need - fZHave, fFp);
+    fZHave += r;
+    if (fZHave < need) { clearerr(fFp); return false; }
+    fZLoad = false;
+
+    if (fZRaw.size() < fZRec.rawBytes) fZRaw.resize(fZRec.rawBytes);
+    if (!BlockCodec::Decompress(fZRec.codec, fZComp.data(), need, fZRaw.data(), fZRec.rawBytes)) {
+        // 블록을 버리고 다음 레코드로 진행 (이후 이벤트 헤더 검사에서 손상으로 처리됨)
+        if (fZErrors++ == 0) {
+            ELog::Print(ELog::ERROR, Form("Cannot decompress block (codec: %s%s).", BlockCodec::Name(fZRec.codec),
+                                          BlockCodec::Available(fZRec.codec) ? "" : ", not built into this binary"));
+        }
+        return true;
+    }
+    if (fZRec.filter == BlockCodec::kFilterDelta8) BlockCodec::Delta8Decode(fZRaw.data(), fZRec.rawBytes);
+
+    fZPos = 0;
+    fZAvail = fZRec.rawBytes;
+    return true;
+}
+
+bool RawStreamReader::ReadBlockTable(FILE* fp, std::vector<DataFormat::BlockTableEntry>& table) {
+    table.clear();
+    off_t saved = ftello(fp);
+    bool ok = false;
+
+    DataFormat::AuxRecord rec;
+    if (fseeko(fp, -(off_t)sizeof(rec), SEEK_END) == 0 && fread(&rec, sizeof(rec), 1, fp) == 1 &&
+        DataFormat::IsAuxRecord(reinterpret_cast<const unsigned char*>(&rec)) && rec.type == DataFormat::kAuxTableFooter &&
+        fseeko(fp, (off_t)rec.seq, SEEK_SET) == 0 && fread(&rec, sizeof(rec), 1, fp) == 1 &&
+        DataFormat::IsAuxRecord(reinterpret_cast<const unsigned char*>(&rec)) && rec.type == DataFormat::kAuxBlockTable &&
+        fseeko(fp, rec.prePadBytes, SEEK_CUR) == 0) {
+        table.resize(rec.payloadBytes / sizeof(DataFormat::BlockTableEntry));
+        ok = table.empty() || fread(table.data(), sizeof(DataFormat::BlockTableEntry), table.size(), fp) == table.size();
+    }
+    if (!ok) table.clear();
+
+    clearerr(fp);
+    fseeko(fp, saved, SEEK_SET);
+    return ok;
+}
+
+bool RawStreamReader::Discard() {
+    // tail 모드에서 파일 끝을 넘어 fseek 하지 않도록 실제로 읽어서 버림
+    while (fDiscardRemain > 0) {
+        size_t n = (size_t)std::min<uint64_t>(fDiscardRemain, fScratch.size());
+        size_t r = fread(fScratch.data(), 1, n, fFp);
+        fDiscardRemain -= r;
+        if (r < n) { clearerr(fFp); return false; }
+    }
+    return true;
+}
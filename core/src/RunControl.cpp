@@ -0,0 +1,137 @@
+#include "RunControl.hh"
+#include "ELog.hh"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+// 명령 1줄 최대 길이 (넘으면 잘못된 클라이언트로 보고 연결을 끊음)
+static const size_t kMaxLineBytes = 4096;
+
+RunControlServer::RunControlServer() : fListenFd(-1), fClientFd(-1) {}
+
+RunControlServer::~RunControlServer() {
+    Close();
+}
+
+bool RunControlServer::Open(const std::string& path) {
+    Close();
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        ELog::Print(ELog::ERROR, "Run control socket path is empty or too long: " + path);
+        return false;
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    fListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fListenFd < 0) {
+        ELog::Print(ELog::ERROR, Form("Cannot create run control socket: %s", std::strerror(errno)));
+        return false;
+    }
+    unlink(path.c_str());   // 이전 데몬이 비정상 종료하며 남긴 소켓 파일
+    if (bind(fListenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fListenFd, 4) != 0) {
+        ELog::Print(ELog::ERROR, Form("Cannot listen on %s: %s", path.c_str(), std::strerror(errno)));
+        close(fListenFd);
+        fListenFd = -1;
+        return false;
+    }
+    chmod(path.c_str(), 0660);
+    fPath = path;
+    return true;
+}
+
+void RunControlServer::Close() {
+    DropClient();
+    if (fListenFd >= 0) {
+        close(fListenFd);
+        fListenFd = -1;
+        unlink(fPath.c_str());
+    }
+    fPath.clear();
+}
+
+void RunControlServer::DropClient() {
+    if (fClientFd >= 0) close(fClientFd);
+    fClientFd = -1;
+    fInput.clear();
+}
+
+bool RunControlServer::TakeLine(std::string& line) {
+    size_t eol = fInput.find('\n');
+    if (eol == std::string::npos) return false;
+    line = fInput.substr(0, eol);
+    fInput.erase(0, eol + 1);
+
+    size_t first = line.find_first_not_of(" \t\r");
+    size_t last = line.find_last_not_of(" \t\r");
+    line = (first == std::string::npos) ? std::string() : line.substr(first, last - first + 1);
+    return true;
+}
+
+bool RunControlServer::WaitCommand(std::string& line, int timeoutMs) {
+    if (fListenFd < 0) return false;
+    // 이전 수신에서 여러 줄이 한꺼번에 왔으면 기다리지 않고 다음 줄부터
+    while (TakeLine(line)) {
+        if (!line.empty()) return true;
+    }
+
+    pollfd fds[2];
+    fds[0].fd = fListenFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = fClientFd;
+    fds[1].events = POLLIN;
+    int nfds = fClientFd >= 0 ? 2 : 1;
+    if (poll(fds, nfds, timeoutMs) <= 0) return false;
+
+    if (fds[0].revents & POLLIN) {
+        int fd = accept4(fListenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd >= 0) {
+            if (fClientFd >= 0) ELog::Print(ELog::WARNING, "Run control: new client connected, closing the previous one.");
+            DropClient();
+            fClientFd = fd;
+        }
+        return false;   // 새 연결의 명령은 다음 호출에서
+    }
+
+    if (nfds == 2 && fds[1].revents) {
+        char buf[1024];
+        ssize_t n = recv(fClientFd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            DropClient();
+            return false;
+        }
+        fInput.append(buf, (size_t)n);
+        if (fInput.size() > kMaxLineBytes && fInput.find('\n') == std::string::npos) {
+            ELog::Print(ELog::WARNING, "Run control: command line too long, closing the client.");
+            DropClient();
+            return false;
+        }
+        while (TakeLine(line)) {
+            if (!line.empty()) return true;
+        }
+    }
+    return false;
+}
+
+void RunControlServer::Reply(const std::string& text) {
+    if (fClientFd < 0) return;
+    std::string msg = text + "\n";
+    size_t sent = 0;
+    while (sent < msg.size()) {
+        ssize_t n = send(fClientFd, msg.data() + sent, msg.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            DropClient();
+            return;
+        }
+        sent += (size_t)n;
+    }
+}
@@ -0,0 +1,288 @@
+#include "SimFadc500Device.hh"
+#include "DataFormat.hh"
+#include "ELog.hh"
+
+#include <thread>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// 템플릿 전체 예산: 압축기 윈도우 안에서 같은 파형이 반복되지 않을 만큼 (실제 데이터와 비슷한 압축률)
+static const size_t kTemplateBudget = 16 * 1024 * 1024;
+
+SimFadc500Device::SimFadc500Device(int mid, const DaqOptions& options)
+    : fMid(mid), fOptions(options), fSamples(0), fEventBytes(0), fWindowNs(0), fNTemplates(0),
+      fDramBytes(0), fDramLimit((uint64_t)std::max(options.simDramMB, 1) * 1024 * 1024), fHeadPos(0),
+      fRunning(false), fNextTriggerNs(0), fTriggers(0), fLost(0), fBelowThreshold(0), fDeadNs(0), fDeadUntilNs(0), fVetoed(0),
+      fRng(0x5EED0000ull + (uint64_t)mid),
+      fInterval(std::max(options.simTriggerHz, 1) / 1e9),
+      fJitter(options.simUsbJitterUs > 0 ? 1.0 / options.simUsbJitterUs : 1.0)
+{
+    std::memset(fHeader, 0, sizeof(fHeader));
+    for (uint64_t& n : fChannelTriggers) n = 0;
+}
+
+SimFadc500Device::~SimFadc500Device() {}
+
+void SimFadc500Device::Initialize(FadcBD* bdConfig) {
+    ELog::Print(ELog::INFO, Form("Initializing FADC500 simulator (MID: %d, %d Hz, pulse %d ADC, noise %d ADC)...",
+                                 fMid, fOptions.simTriggerHz, fOptions.simPulseAdc, fOptions.simNoiseAdc));
+    BuildTemplates(bdConfig);
+}
+
+// RECORD_LEN 1 = 128 ns, SAMPLING_RATE 1/2/4 = 2/4/8 ns 샘플 간격
+void SimFadc500Device::BuildTemplates(FadcBD* bdConfig) {
+    const int sampling = std::max(bdConfig->GetSAMPLING(), 1);
+    const double nsPerSample = 2.0 * sampling;
+    fSamples = std::max<size_t>((size_t)std::max(bdConfig->GetRL(), 1) * 64 / sampling, 1);
+    fEventBytes = 128 + fSamples * 8;
+    fWindowNs = (uint64_t)(fSamples * nsPerSample);
+
+    const size_t payload = fSamples * 8;
+    fNTemplates = (uint32_t)std::min<size_t>(std::max<size_t>(kTemplateBudget / payload, 16), 4096);
+    fTemplates.assign((size_t)fNTemplates * payload, 0);
+    fAmplitudes.assign((size_t)fNTemplates * 4, 0.0f);
+
+    // 단위 높이 펄스 모양 (DLY 위치에서 시작하는 이중 지수, 최대값 1)
+    const double rise = std::max(fOptions.simRiseNs, 1);
+    const double decay = std::max(fOptions.simDecayNs, fOptions.simRiseNs + 1);
+    std::vector<double> shape(fSamples * 4, 0.0);
+    for (int ch = 0; ch < 4; ch++) {
+        double start = bdConfig->GetDLY(ch);
+        double peak = 0;
+        for (size_t j = 0; j < fSamples; j++) {
+            double t = j * nsPerSample - start;
+            double v = (t > 0) ? std::exp(-t / decay) - std::exp(-t / rise) : 0.0;
+            shape[ch * fSamples + j] = v;
+            peak = std::max(peak, v);
+        }
+        if (peak > 0) for (size_t j = 0; j < fSamples; j++) shape[ch * fSamples + j] /= peak;
+    }
+
+    double baseline[4];
+    for (int ch = 0; ch < 4; ch++) baseline[ch] = Baseline(bdConfig, ch);
+
+    std::normal_distribution<double> amplitude(fOptions.simPulseAdc, 0.25 * fOptions.simPulseAdc);
+    std::normal_distribution<double> noise(0.0, std::max(fOptions.simNoiseAdc, 0));
+    std::uniform_real_distribution<double> share(0.7, 1.0);
+
+    for (uint32_t t = 0; t < fNTemplates; t++) {
+        unsigned char* out = fTemplates.data() + (size_t)t * payload;
+        double amp = std::max(amplitude(fRng), 0.0);
+        for (int ch = 0; ch < 4; ch++) {
+            double a = amp * share(fRng);
+            double sign = bdConfig->GetPOL(ch) ? 1.0 : -1.0;   // POL 0: 음의 펄스
+            fAmplitudes[(size_t)t * 4 + ch] = (float)a;
+
+            const double* s = shape.data() + ch * fSamples;
+            for (size_t j = 0; j < fSamples; j++) {
+                double v = baseline[ch] + sign * a * s[j] + (fOptions.simNoiseAdc > 0 ? noise(fRng) : 0.0);
+                int adc = std::min(std::max((int)std::lround(v), 0), 4095);
+                out[j * 8 + ch] = (unsigned char)(adc & 0xFF);
+                out[j * 8 + 4 + ch] = (unsigned char)(adc >> 8);
+            }
+        }
+    }
+
+    const uint32_t triggering = UpdatePatterns(bdConfig);
+    if (triggering == 0) {
+        ELog::Print(ELog::WARNING, Form("Simulator MID %d: THR is above every simulated pulse (SIM_PULSE_ADC %d). No triggers will be generated.",
+                                        fMid, fOptions.simPulseAdc));
+    }
+    ELog::Print(ELog::INFO, Form("Simulator MID %d: %zu samples/event (%zu B), %u waveform templates, %.0f%% of pulses above THR",
+                                 fMid, fSamples, fEventBytes, fNTemplates, 100.0 * triggering / fNTemplates));
+}
+
+// 채널별 베이스라인: DACOFF + 보드/채널마다 다른 고정 오프셋 (-40 ~ +40 ADC)
+double SimFadc500Device::Baseline(const FadcBD* bdConfig, int ch) const {
+    int offset = (int)((fMid * 37u + ch * 53u) % 81u) - 40;
+    return std::min(std::max(bdConfig->GetDACOFF(ch) + offset, 0), 4095);
+}
+
+// 레지스터 쓰기 4번 + 안정화 대기 + measure_PED / read_PED 8번. 보드는 여러 샘플을 평균하므로 잡음은 1/4 로 봄
+bool SimFadc500Device::MeasurePedestals(FadcBD* bdConfig, int pedestal[4]) {
+    SleepUs(fOptions.simUsbLatencyUs * 12.0 + std::max(fOptions.dacCalSettleMs, 0) * 1000.0);
+    std::normal_distribution<double> noise(0.0, 0.25 * std::max(fOptions.simNoiseAdc, 0));
+    for (int ch = 0; ch < std::min(bdConfig->NCHANNEL(), 4); ch++) {
+        double v = Baseline(bdConfig, ch) + (fOptions.simNoiseAdc > 0 ? noise(fRng) : 0.0);
+        pedestal[ch] = std::min(std::max((int)std::lround(v), 0), 4095);
+    }
+    return true;
+}
+
+// 반환: 트리거되는 템플릿 수
+uint32_t SimFadc500Device::UpdatePatterns(FadcBD* bdConfig) {
+    fPatterns.assign(fNTemplates, 0);
+    uint32_t triggering = 0;
+    for (uint32_t t = 0; t < fNTemplates; t++) {
+        for (int ch = 0; ch < 4; ch++) {
+            if (fAmplitudes[(size_t)t * 4 + ch] >= bdConfig->GetTHR(ch)) fPatterns[t] |= 1u << ch;
+        }
+        if (fPatterns[t]) triggering++;
+    }
+    return triggering;
+}
+
+// 레지스터 쓰기 1번당 제어 전송 지연. 이미 DRAM 에 있는 이벤트는 그대로 (이전 설정으로 수집된 데이터)
+bool SimFadc500Device::ApplyLiveChange(FadcBD* bdConfig, int param, int ch) {
+    SleepUs(fOptions.simUsbLatencyUs * (ch < 0 ? 4.0 : 1.0));
+    switch (param) {
+        case DataFormat::kCfgTHR:
+            // 문턱값 스캔은 단계마다 호출하므로 로그 없이 패턴만 갱신
+            UpdatePatterns(bdConfig);
+            return true;
+        case DataFormat::kCfgDLY:
+            BuildTemplates(bdConfig);
+            return true;
+        case DataFormat::kCfgPSW:
+        case DataFormat::kCfgTRIGEN:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint64_t SimFadc500Device::NowNs() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - fStart).count();
+}
+
+void SimFadc500Device::SleepUs(double us) {
+    if (us >= 1.0) std::this_thread::sleep_for(std::chrono::nanoseconds((int64_t)(us * 1000.0)));
+}
+
+void SimFadc500Device::StartDAQ() {
+    fPending.clear();
+    fDramBytes = 0;
+    fHeadPos = 0;
+    fTriggers = fLost = fBelowThreshold = 0;
+    for (uint64_t& n : fChannelTriggers) n = 0;
+    fDeadNs = fDeadUntilNs = 0;
+    fVetoed = 0;
+    fStart = std::chrono::steady_clock::now();
+    fNextTriggerNs = (uint64_t)fInterval(fRng);
+    fRunning = true;
+}
+
+void SimFadc500Device::StopDAQ() {
+    if (!fRunning) return;
+    fRunning = false;
+    double sec = NowNs() / 1e9;
+    ELog::Print(ELog::INFO, Form("Simulator MID %d: %llu triggers (%.1f Hz), %llu lost (DRAM full), %llu in dead window, %llu pulses below THR, live %.2f%%",
+                                 fMid, (unsigned long long)fTriggers, sec > 0 ? fTriggers / sec : 0.0,
+                                 (unsigned long long)fLost, (unsigned long long)fVetoed, (unsigned long long)fBelowThreshold,
+                                 sec > 0 ? 100.0 * (1.0 - std::min(fDeadNs / 1e9, sec) / sec) : 100.0));
+    // 실제 보드와 같이 정지 시 DRAM 에 남은 데이터는 버림
+    fPending.clear();
+    fDramBytes = 0;
+    fHeadPos = 0;
+}
+
+// nowNs 까지 발생한 트리거를 DRAM 에 추가 (가득 차 있으면 손실)
+void SimFadc500Device::AdvanceTo(uint64_t nowNs) {
+    if (!fRunning) return;
+    std::uniform_int_distribution<uint32_t> pick(0, fNTemplates - 1);
+    while (fNextTriggerNs <= nowNs) {
+        PendingEvent ev;
+        ev.timeNs = fNextTriggerNs;
+        ev.templ = pick(fRng);
+        fNextTriggerNs += std::max<uint64_t>((uint64_t)fInterval(fRng), 1);
+
+        if (fPatterns[ev.templ] == 0) {
+            fBelowThreshold++;
+        } else if (ev.timeNs < fDeadUntilNs) {
+            // 이전 트리거의 레코드 윈도우 안: 보드가 받지 않음 (데드타임은 이미 집계됨)
+            fVetoed++;
+        } else if (fDramBytes + fEventBytes > fDramLimit) {
+            // DRAM 가득 참: 마지막으로 받은 트리거 이후 지금까지 데드 (이후 트리거도 공간이 날 때까지 같은 처리)
+            fLost++;
+            fDeadNs += ev.timeNs - fDeadUntilNs;
+            fDeadUntilNs = ev.timeNs;
+        } else {
+            ev.number = (uint32_t)++fTriggers;
+            for (int ch = 0; ch < 4; ch++) {
+                if (fPatterns[ev.templ] & (1u << ch)) fChannelTriggers[ch]++;
+            }
+            fPending.push_back(ev);
+            fDramBytes += fEventBytes;
+            fDeadNs += fWindowNs;
+            fDeadUntilNs = ev.timeNs + fWindowNs;
+        }
+    }
+}
+
+unsigned int SimFadc500Device::ReadBCOUNT() {
+    SleepUs(fOptions.simUsbLatencyUs * 0.5);
+    AdvanceTo(NowNs());
+    return (unsigned int)std::min<uint64_t>(fDramBytes / 1024, 0xFFFF);
+}
+
+// 레지스터 읽기 6번 (LIVETIME lsb/msb + 채널 4개) 만큼의 제어 전송 지연
+bool SimFadc500Device::ReadCounters(DeviceCounters& counters) {
+    SleepUs(fOptions.simUsbLatencyUs * 3.0);
+    uint64_t now = NowNs();
+    AdvanceTo(now);
+    uint64_t dead = std::min(fDeadNs, now);
+    counters.liveTicks = (now - dead) / (uint64_t)std::max(fOptions.liveTimeTickNs, 1);
+    for (int ch = 0; ch < 4; ch++) counters.triggers[ch] = (uint32_t)fChannelTriggers[ch];
+    return true;
+}
+
+// 헤더 필드 i 는 바이트 i*4 + ch (채널별 사본, 채널 번호 필드만 다름)
+void SimFadc500Device::BuildHeader(const PendingEvent& ev) {
+    const uint32_t dataLength = 32 + 2 * (uint32_t)fSamples;
+    const uint64_t fine = (ev.timeNs % 1000) / 8;
+    const uint64_t coarse = ev.timeNs / 1000;
+    const uint32_t pattern = fPatterns[ev.templ];
+
+    for (int ch = 0; ch < 4; ch++) {
+        auto field = [&](int i, uint32_t v) { fHeader[i * 4 + ch] = (unsigned char)(v & 0xFF); };
+        for (int b = 0; b < 4; b++) field(0 + b, dataLength >> (8 * b));
+        field(4, 0);                                        // run number (보드는 모름)
+        field(5, 0);
+        field(6, 1);                                        // trigger type: self
+        for (int b = 0; b < 4; b++) field(7 + b, ev.number >> (8 * b));
+        field(11, (uint32_t)fine);
+        for (int b = 0; b < 3; b++) field(12 + b, (uint32_t)(coarse >> (8 * b)));
+        field(15, (uint32_t)fMid);
+        field(16, (uint32_t)(ch + 1));
+        for (int b = 0; b < 4; b++) field(17 + b, ev.number >> (8 * b));
+        for (int b = 0; b < 4; b++) field(21 + b, pattern >> (8 * b));
+        field(25, (uint32_t)fine);
+        for (int b = 0; b < 6; b++) field(26 + b, (uint32_t)(coarse >> (8 * b)));
+    }
+}
+
+void SimFadc500Device::ReadDATA(unsigned int bcount_kb, unsigned char* dest) {
+    if (bcount_kb == 0) return;
+    const size_t bytes = (size_t)bcount_kb * 1024;
+
+    // USB 전송 시간: 고정 지연 + 지터 + 대역폭
+    double us = fOptions.simUsbLatencyUs + (fOptions.simUsbJitterUs > 0 ? fJitter(fRng) : 0.0);
+    if (fOptions.simUsbMBps > 0) us += bytes / (fOptions.simUsbMBps * 1.048576);
+    SleepUs(us);
+
+    const size_t payload = fSamples * 8;
+    size_t done = 0;
+    while (done < bytes && !fPending.empty()) {
+        const PendingEvent& ev = fPending.front();
+        if (fHeadPos == 0) BuildHeader(ev);
+
+        size_t take;
+        if (fHeadPos < 128) {
+            take = std::min(128 - fHeadPos, bytes - done);
+            std::memcpy(dest + done, fHeader + fHeadPos, take);
+        } else {
+            take = std::min(fEventBytes - fHeadPos, bytes - done);
+            std::memcpy(dest + done, fTemplates.data() + (size_t)ev.templ * payload + (fHeadPos - 128), take);
+        }
+        done += take;
+        fHeadPos += take;
+        fDramBytes -= take;
+        if (fHeadPos == fEventBytes) {
+            fPending.pop_front();
+            fHeadPos = 0;
+        }
+    }
+    // BCOUNT 보다 많이 요청한 경우 (정상 경로에서는 없음)
+    if (done < bytes) std::memset(dest + done, 0, bytes - done);
+}
@@ -0,0 +1,113 @@
+#include "StatusPage.hh"
+
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char* kStatusPrefix = "nkfadc500_status_";   // /dev/shm 아래 이름
+
+static uint64_t UnixNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+StatusPage::StatusPage() : fMap(nullptr), fMapBytes(0), fShared(false), fHeader(nullptr), fBoards(nullptr), fScratch() {}
+
+StatusPage::~StatusPage() {
+    Close();
+}
+
+std::string StatusPage::NameFor(int pid) {
+    return "/" + std::string(kStatusPrefix) + std::to_string(pid);
+}
+
+bool StatusPage::Create(Kind kind) {
+    Close();
+
+    fMapBytes = sizeof(StatusPageHeader) + kStatusMaxBoards * sizeof(StatusPageBoard);
+    fName = NameFor((int)getpid());
+
+    // 같은 pid 의 이전 (비정상 종료) 페이지가 남아 있으면 지우고 새로 만듦
+    shm_unlink(fName.c_str());
+    int fd = shm_open(fName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd >= 0 && ftruncate(fd, (off_t)fMapBytes) == 0) {
+        void* map = mmap(nullptr, fMapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED) {
+            fMap = map;
+            fShared = true;
+        }
+    }
+    if (fd >= 0) close(fd);
+    if (!fShared) {
+        shm_unlink(fName.c_str());
+        fMap = new unsigned char[fMapBytes];
+    }
+    std::memset(fMap, 0, fMapBytes);
+
+    fHeader = static_cast<StatusPageHeader*>(fMap);
+    fBoards = reinterpret_cast<StatusPageBoard*>(static_cast<unsigned char*>(fMap) + sizeof(StatusPageHeader));
+
+    fHeader->version = kStatusVersion;
+    fHeader->kind = (uint16_t)kind;
+    fHeader->headerBytes = sizeof(StatusPageHeader);
+    fHeader->boardBytes = sizeof(StatusPageBoard);
+    fHeader->maxBoards = kStatusMaxBoards;
+    fHeader->pid = (int32_t)getpid();
+    fHeader->startUnixNs = UnixNowNs();
+    fHeader->heartbeatNs.store(fHeader->startUnixNs, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    fHeader->magic = kStatusMagic;
+    return fShared;
+}
+
+void StatusPage::Heartbeat() {
+    fHeader->heartbeatNs.store(UnixNowNs(), std::memory_order_release);
+}
+
+void StatusPage::Close(State finalState) {
+    if (!fMap) return;
+    fHeader->state.store(finalState, std::memory_order_release);
+    Heartbeat();
+    if (fShared) {
+        munmap(fMap, fMapBytes);
+        shm_unlink(fName.c_str());
+    } else {
+        delete[] static_cast<unsigned char*>(fMap);
+    }
+    fMap = nullptr;
+    fHeader = nullptr;
+    fBoards = nullptr;
+    fShared = false;
+}
+
+uint64_t StatusPage::ActiveDaqCpuMask() {
+    uint64_t mask = 0;
+    DIR* dir = opendir("/dev/shm");
+    if (!dir) return 0;
+
+    const size_t prefixLen = std::strlen(kStatusPrefix);
+    while (dirent* ent = readdir(dir)) {
+        if (std::strncmp(ent->d_name, kStatusPrefix, prefixLen) != 0) continue;
+
+        int fd = shm_open(("/" + std::string(ent->d_name)).c_str(), O_RDONLY, 0);
+        if (fd < 0) continue;
+        void* map = mmap(nullptr, sizeof(StatusPageHeader), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED) continue;
+
+        const StatusPageHeader* hdr = static_cast<const StatusPageHeader*>(map);
+        uint32_t state = hdr->state.load(std::memory_order_acquire);
+        // 비정상 종료로 남은 페이지는 pid 로 걸러냄
+        if (hdr->magic == kStatusMagic && hdr->version == kStatusVersion && hdr->kind == kFrontend &&
+            (state == kStarting || state == kRunning) && kill(hdr->pid, 0) == 0) {
+            mask |= hdr->daqCpuMask.load(std::memory_order_relaxed);
+        }
+        munmap(map, sizeof(StatusPageHeader));
+    }
+    closedir(dir);
+    return mask;
+}
@@ -0,0 +1,82 @@
+#include "ThreadTuning.hh"
+
+#include <algorithm>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+const char* ThreadSchedInfo::PolicyName() const {
+    switch (policy) {
+        case SCHED_FIFO:  return "SCHED_FIFO";
+        case SCHED_RR:    return "SCHED_RR";
+        case SCHED_BATCH: return "SCHED_BATCH";
+        case SCHED_IDLE:  return "SCHED_IDLE";
+        default:          return "SCHED_OTHER";
+    }
+}
+
+int ThreadTuning::GetCpuCount() {
+    long n = sysconf(_SC_NPROCESSORS_CONF);
+    return n > 0 ? (int)n : 1;
+}
+
+bool ThreadTuning::PinToCpu(int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool ThreadTuning::AvoidCpus(uint64_t mask) {
+    if (mask == 0) return true;
+    cpu_set_t set;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) return false;
+    for (int cpu = 0; cpu < 64; cpu++) {
+        if (mask & (1ull << cpu)) CPU_CLR(cpu, &set);
+    }
+    if (CPU_COUNT(&set) == 0) return false;
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool ThreadTuning::SetRealtime(int priority) {
+    if (priority <= 0) return true;
+    sched_param param;
+    param.sched_priority = std::min(priority, sched_get_priority_max(SCHED_FIFO));
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+void ThreadTuning::SetName(const std::string& name) {
+    // 커널 제한: 종료 문자 포함 16 바이트
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+}
+
+ThreadSchedInfo ThreadTuning::Sample() {
+    ThreadSchedInfo info;
+
+    cpu_set_t set;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+        // 연속 구간은 "a-b" 로 묶음
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (!CPU_ISSET(cpu, &set)) continue;
+            int last = cpu;
+            while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, &set)) last++;
+            if (!info.cpus.empty()) info.cpus += ",";
+            info.cpus += std::to_string(cpu);
+            if (last > cpu) info.cpus += "-" + std::to_string(last);
+            cpu = last;
+        }
+    }
+
+    sched_param param;
+    if (pthread_getschedparam(pthread_self(), &info.policy, &param) == 0) info.priority = param.sched_priority;
+
+    rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        info.voluntarySwitches = usage.ru_nvcsw;
+        info.involuntarySwitches = usage.ru_nivcsw;
+    }
+    info.valid = true;
+    return info;
+}
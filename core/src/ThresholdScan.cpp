@@ -0,0 +1,197 @@
+#include "ThresholdScan.hh"
+#include "DataFormat.hh"
+#include "ELog.hh"
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+// 스캔하지 않는 채널의 THR (12-bit ADC 최대값: 트리거되지 않음)
+static const int kThrMasked = 4095;
+// 읽어서 버리는 DRAM 데이터 1회 전송 크기 (Producer 블록과 같음)
+static const size_t kScratchBytes = 4 * 1024 * 1024;
+
+int ThresholdScanResult::Pick(int ch, double targetHz) const {
+    if (ch < 0 || ch > 3) return -1;
+    // 위에서부터 내려오며 목표 이하가 이어지는 마지막 점 (통계 요동으로 한 점만 내려간 곳은 고르지 않음)
+    int picked = -1;
+    for (size_t i = rateHz[ch].size(); i-- > 0;) {
+        if (rateHz[ch][i] > targetHz) break;
+        picked = thresholds[i];
+    }
+    return picked;
+}
+
+ThresholdScan::ThresholdScan(DaqDevice* device, FadcBD* bdConfig, const DaqOptions& options)
+    : fDevice(device), fConfig(bdConfig), fOptions(options), fScratch(kScratchBytes)
+{
+    // RECORD_LEN 1 = 128 ns, 샘플당 8 바이트 (4채널 인터리브) + 헤더 128 바이트
+    const int sampling = std::max(bdConfig->GetSAMPLING(), 1);
+    fEventBytes = 128 + (size_t)std::max(bdConfig->GetRL(), 1) * 64 / sampling * 8;
+}
+
+ThresholdScan::~ThresholdScan() {}
+
+bool ThresholdScan::Run(int first, int last, int step, ThresholdScanResult& result, const std::atomic<bool>& abort) {
+    if (first > last) std::swap(first, last);
+    step = std::max(step, 1);
+
+    result = ThresholdScanResult();
+    result.mid = fConfig->GetMID();
+    for (int thr = first; thr <= last; thr += step) result.thresholds.push_back(thr);
+
+    const int nch = std::min(fConfig->NCHANNEL(), 4);
+    int saved[4] = {0, 0, 0, 0};
+    for (int ch = 0; ch < nch; ch++) saved[ch] = fConfig->GetTHR(ch);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int ch = 0; ch < nch; ch++) fConfig->SetTHR(ch, kThrMasked);
+    if (!fDevice->ApplyLiveChange(fConfig, DataFormat::kCfgTHR, -1)) {
+        for (int ch = 0; ch < nch; ch++) fConfig->SetTHR(ch, saved[ch]);
+        ELog::Print(ELog::ERROR, Form("[MID %d] %s does not support changing THR. Threshold scan is not possible.",
+                                      result.mid, fDevice->GetName()));
+        return false;
+    }
+
+    fDevice->StartDAQ();
+    bool complete = true;
+    for (int ch = 0; ch < nch && complete; ch++) {
+        for (int thr : result.thresholds) {
+            if (abort.load(std::memory_order_relaxed)) {
+                complete = false;
+                break;
+            }
+            SetThreshold(ch, thr);
+            double rate = 0;
+            uint64_t count = 0;
+            bool fromCounters = true;
+            Measure(ch, rate, count, fromCounters);
+            result.rateHz[ch].push_back(rate);
+            result.counts[ch].push_back(count);
+            if (!fromCounters) result.fromCounters = false;
+        }
+        SetThreshold(ch, kThrMasked);
+    }
+    fDevice->StopDAQ();
+
+    // 원래 THR 복구 (중단된 경우 포함)
+    for (int ch = 0; ch < nch; ch++) fConfig->SetTHR(ch, saved[ch]);
+    fDevice->ApplyLiveChange(fConfig, DataFormat::kCfgTHR, -1);
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return complete;
+}
+
+void ThresholdScan::SetThreshold(int ch, int value) {
+    fConfig->SetTHR(ch, value);
+    fDevice->ApplyLiveChange(fConfig, DataFormat::kCfgTHR, ch);
+}
+
+// 보드 DRAM 에 minKB 이상 쌓여 있으면 그 아래로 내려갈 때까지 읽어서 버림. 반환: 읽은 바이트
+uint64_t ThresholdScan::Drain(unsigned int minKB) {
+    uint64_t bytes = 0;
+    for (int i = 0; i < 64; i++) {
+        unsigned int raw = fDevice->ReadBCOUNT();
+        if (raw == 0xFFFFFFFF) break;
+        unsigned int kb = std::min<unsigned int>(raw & 0x0000FFFF, (unsigned int)(fScratch.size() / 1024));
+        if (kb == 0 || kb < minKB) break;
+        fDevice->ReadDATA(kb, fScratch.data());
+        bytes += (uint64_t)kb * 1024;
+    }
+    return bytes;
+}
+
+// 카운터: 창 앞뒤 값의 차이. 데이터는 보드 DRAM 이 차지 않을 만큼만 큰 단위로 읽어서 버림
+// 카운터 미지원: THR 을 바꾸기 전 설정으로 들어온 이벤트를 먼저 비우고, 창 동안 읽어 낸 이벤트 수를 셈
+bool ThresholdScan::Measure(int ch, double& rateHz, uint64_t& count, bool& fromCounters) {
+    DeviceCounters before, after;
+    fromCounters = fDevice->ReadCounters(before);
+    const unsigned int eventKB = (unsigned int)std::max<size_t>(fEventBytes / 1024, 1);
+    const unsigned int minKB = fromCounters ? (unsigned int)(fScratch.size() / 2048) : eventKB;
+    if (!fromCounters) Drain(eventKB);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto end = t0 + std::chrono::milliseconds(std::max(fOptions.scanWindowMs, 1));
+    uint64_t drained = 0;
+    while (true) {
+        drained += Drain(minKB);
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= end) break;
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(end - now, std::chrono::milliseconds(2)));
+    }
+    if (fromCounters) fromCounters = fDevice->ReadCounters(after);
+    else drained += Drain(eventKB);
+    const double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    if (fromCounters) {
+        count = (uint32_t)(after.triggers[ch] - before.triggers[ch]);   // 32-bit 카운터 wrap 허용
+        // live time 기준 (트리거 데드타임 보정). 카운터가 멈춰 있거나 비정상이면 벽시계
+        double liveSec = (double)(after.liveTicks - before.liveTicks) * std::max(fOptions.liveTimeTickNs, 1) / 1e9;
+        if (after.liveTicks <= before.liveTicks || liveSec > wallSec * 1.5) liveSec = wallSec;
+        rateHz = liveSec > 0 ? count / liveSec : 0.0;
+    } else {
+        count = drained / fEventBytes;
+        rateHz = wallSec > 0 ? count / wallSec : 0.0;
+    }
+    return true;
+}
+
+void ThresholdScan::Print(const std::vector<ThresholdScanResult>& results, double targetHz) {
+    for (const ThresholdScanResult& r : results) {
+        std::cout << "\n\033[1;36m[Threshold Scan] MID " << r.mid << "\033[0m  ("
+                  << Form("%zu points x 4 ch in %.2f s, %s", r.thresholds.size(), r.seconds,
+                          r.fromCounters ? "trigger counters / live time" : "read-out events / wall time") << ")\n";
+        std::cout << "      THR        ch0 (Hz)      ch1 (Hz)      ch2 (Hz)      ch3 (Hz)\n";
+        for (size_t i = 0; i < r.thresholds.size(); i++) {
+            std::cout << Form("    %5d", r.thresholds[i]);
+            for (int ch = 0; ch < 4; ch++) {
+                if (i < r.rateHz[ch].size()) std::cout << Form("  %12.1f", r.rateHz[ch][i]);
+                else std::cout << "             -";
+            }
+            std::cout << "\n";
+        }
+        if (targetHz > 0) {
+            std::cout << Form("    THR at <= %.1f Hz:", targetHz);
+            for (int ch = 0; ch < 4; ch++) {
+                int thr = r.Pick(ch, targetHz);
+                std::cout << (thr < 0 ? std::string("  (above range)") : Form("  %d", thr));
+            }
+            std::cout << "\n";
+        }
+    }
+    std::cout << std::endl;
+}
+
+// 주석 (#) 으로 된 표 + 보드별 제안 THR 줄 (settings.cfg 의 해당 BOARD 아래에 붙여 넣음)
+bool ThresholdScan::Save(const std::string& path, const std::vector<ThresholdScanResult>& results, double targetHz) {
+    std::ofstream out(path);
+    if (!out) {
+        ELog::Print(ELog::ERROR, "Cannot write threshold scan table: " + path);
+        return false;
+    }
+    for (const ThresholdScanResult& r : results) {
+        out << "# MID " << r.mid << ": trigger rate (Hz) vs THR, " << (r.fromCounters ? "trigger counters / live time" : "read-out events / wall time") << "\n";
+        out << "# THR ch0 ch1 ch2 ch3\n";
+        for (size_t i = 0; i < r.thresholds.size(); i++) {
+            out << "# " << r.thresholds[i];
+            for (int ch = 0; ch < 4; ch++) out << (i < r.rateHz[ch].size() ? Form(" %.1f", r.rateHz[ch][i]) : " -");
+            out << "\n";
+        }
+        if (targetHz <= 0) continue;
+
+        // 범위 안에서 목표에 닿지 못한 채널이 있으면 줄을 주석으로 남김 (더 높은 범위로 다시 스캔)
+        std::string line = "THR";
+        std::string missing;
+        for (int ch = 0; ch < 4; ch++) {
+            int thr = r.Pick(ch, targetHz);
+            line += " " + (thr < 0 ? std::string("-") : std::to_string(thr));
+            if (thr < 0) missing += " " + std::to_string(ch);
+        }
+        out << Form("# MID %d: suggested THR for <= %.1f Hz per channel (goes under BOARD %d in settings.cfg)\n", r.mid, targetHz, r.mid);
+        if (missing.empty()) out << line << "\n";
+        else out << "# " << line << "   (ch" << missing << ": above the scanned range)\n";
+    }
+    return static_cast<bool>(out);
+}
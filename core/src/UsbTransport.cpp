@@ -0,0 +1,210 @@
+#include "UsbTransport.hh"
+
+extern "C" {
+    #include "usb3com.h"
+}
+#include <cstring>
+#include <sys/time.h>
+
+int UsbTransport::ReadBulk(unsigned char* dest, int length, int* actual) {
+    UsbTransfer xfer;
+    xfer.buffer = dest;
+    xfer.length = length;
+    int rc = Submit(&xfer);
+    if (rc < 0) return rc;
+    while (!xfer.done) HandleEvents(100);
+    Release(&xfer);
+    *actual = xfer.actual;
+    return (xfer.status == 0) ? 0 : -1;
+}
+
+void UsbTransport::EncodeWrite(unsigned char* cmd, uint32_t addr, uint32_t data) {
+    cmd[0] = data & 0xFF;
+    cmd[1] = (data >> 8) & 0xFF;
+    cmd[2] = (data >> 16) & 0xFF;
+    cmd[3] = (data >> 24) & 0xFF;
+    cmd[4] = addr & 0xFF;
+    cmd[5] = (addr >> 8) & 0xFF;
+    cmd[6] = (addr >> 16) & 0xFF;
+    cmd[7] = (addr >> 24) & 0x7F;
+}
+
+// =========================================================================
+// LibusbTransport
+// =========================================================================
+LibusbTransport::LibusbTransport(libusb_device_handle* devh, unsigned int timeoutMs)
+    : fDevh(devh), fTimeoutMs(timeoutMs) {}
+
+LibusbTransport::~LibusbTransport() {}
+
+int LibusbTransport::SendReadCommand(uint32_t countWords, uint32_t addr) {
+    // usb3com.c USB3Read 와 동일한 8바이트 요청 포맷 (addr 최상위 비트 = read 플래그)
+    unsigned char cmd[8];
+    cmd[0] = countWords & 0xFF;
+    cmd[1] = (countWords >> 8) & 0xFF;
+    cmd[2] = (countWords >> 16) & 0xFF;
+    cmd[3] = (countWords >> 24) & 0xFF;
+    cmd[4] = addr & 0xFF;
+    cmd[5] = (addr >> 8) & 0xFF;
+    cmd[6] = (addr >> 16) & 0xFF;
+    cmd[7] = ((addr >> 24) & 0x7F) | 0x80;
+
+    int transferred = 0;
+    return libusb_bulk_transfer(fDevh, USB3_SF_WRITE, cmd, sizeof(cmd), &transferred, fTimeoutMs);
+}
+
+// 벤더 USB3Write 는 명령마다 malloc + 핸들 리스트 탐색 + 1 ms sleep. 여기서는 열린 핸들로 한 번에 전송
+int LibusbTransport::WriteCommands(const unsigned char* cmds, int count) {
+    int transferred = 0;
+    int rc = libusb_bulk_transfer(fDevh, USB3_SF_WRITE, const_cast<unsigned char*>(cmds), count * 8, &transferred, fTimeoutMs);
+    if (rc < 0) return rc;
+    return (transferred == count * 8) ? 0 : -1;
+}
+
+void LibusbTransport::OnTransferDone(libusb_transfer* transfer) {
+    UsbTransfer* xfer = static_cast<UsbTransfer*>(transfer->user_data);
+    xfer->doneTime = std::chrono::steady_clock::now();
+    xfer->actual = transfer->actual_length;
+    xfer->status = (int)transfer->status;
+    xfer->done = true;
+}
+
+int LibusbTransport::Submit(UsbTransfer* xfer) {
+    libusb_transfer* t = static_cast<libusb_transfer*>(xfer->backend);
+    if (!t) {
+        t = libusb_alloc_transfer(0);
+        if (!t) return LIBUSB_ERROR_NO_MEM;
+        xfer->backend = t;
+    }
+    libusb_fill_bulk_transfer(t, fDevh, USB3_SF_READ, xfer->buffer, xfer->length,
+                              &LibusbTransport::OnTransferDone, xfer, fTimeoutMs);
+    xfer->done = false;
+    xfer->actual = 0;
+    xfer->status = 0;
+    xfer->submitTime = std::chrono::steady_clock::now();
+    return libusb_submit_transfer(t);
+}
+
+int LibusbTransport::HandleEvents(int timeoutMs) {
+    // nkusb 는 USB3Init(0) 으로 기본 컨텍스트를 사용하므로 ctx = nullptr
+    struct timeval tv;
+    tv.tv_sec = timeoutMs / 1000;
+    tv.tv_usec = (timeoutMs % 1000) * 1000;
+    return libusb_handle_events_timeout_completed(nullptr, &tv, nullptr);
+}
+
+void LibusbTransport::Cancel(UsbTransfer* xfer) {
+    if (xfer->backend && !xfer->done) libusb_cancel_transfer(static_cast<libusb_transfer*>(xfer->backend));
+}
+
+int LibusbTransport::ReadBulk(unsigned char* dest, int length, int* actual) {
+    // 바운스 버퍼 없이 호출자 메모리로 직접 수신. 큰 length 는 libusb 가 내부적으로 URB 분할
+    return libusb_bulk_transfer(fDevh, USB3_SF_READ, dest, length, actual, fTimeoutMs);
+}
+
+void LibusbTransport::Release(UsbTransfer* xfer) {
+    if (xfer->backend) {
+        libusb_free_transfer(static_cast<libusb_transfer*>(xfer->backend));
+        xfer->backend = nullptr;
+    }
+}
+
+// =========================================================================
+// SimUsbTransport
+// =========================================================================
+SimUsbTransport::SimUsbTransport(double bandwidthMBps, int turnaroundUs, bool fillPattern)
+    : fBytesPerUs(bandwidthMBps * 1.048576), fTurnaroundUs(turnaroundUs), fFillPattern(fillPattern),
+      fWordCursor(0), fWordsLeft(0), fStop(false)
+{
+    fThread = std::thread(&SimUsbTransport::PipeWorker, this);
+}
+
+SimUsbTransport::~SimUsbTransport() {
+    fStop = true;
+    fPipeCv.notify_all();
+    if (fThread.joinable()) fThread.join();
+}
+
+int SimUsbTransport::SendReadCommand(uint32_t countWords, uint32_t addr) {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fWordCursor = 0;
+    fWordsLeft = countWords;
+    return 0;
+}
+
+int SimUsbTransport::Submit(UsbTransfer* xfer) {
+    xfer->done = false;
+    xfer->actual = 0;
+    xfer->status = 0;
+    xfer->submitTime = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fPending.push_back(xfer);
+    }
+    fPipeCv.notify_one();
+    return 0;
+}
+
+int SimUsbTransport::HandleEvents(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(fMutex);
+    fDoneCv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return !fCompleted.empty(); });
+    while (!fCompleted.empty()) {
+        fCompleted.front()->done = true;
+        fCompleted.pop_front();
+    }
+    return 0;
+}
+
+void SimUsbTransport::Cancel(UsbTransfer* xfer) {
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (auto it = fPending.begin(); it != fPending.end(); ++it) {
+        if (*it == xfer) {
+            fPending.erase(it);
+            xfer->status = (int)LIBUSB_TRANSFER_CANCELLED;
+            xfer->doneTime = std::chrono::steady_clock::now();
+            fCompleted.push_back(xfer);
+            fDoneCv.notify_one();
+            return;
+        }
+    }
+}
+
+void SimUsbTransport::PipeWorker() {
+    auto pipeFreeAt = std::chrono::steady_clock::now();
+
+    while (!fStop) {
+        UsbTransfer* xfer = nullptr;
+        uint32_t base = 0, words = 0;
+        {
+            std::unique_lock<std::mutex> lock(fMutex);
+            fPipeCv.wait(lock, [this]() { return !fPending.empty() || fStop.load(); });
+            if (fStop) break;
+            xfer = fPending.front();
+            fPending.pop_front();
+
+            words = xfer->length / 4;
+            if (words > fWordsLeft) words = fWordsLeft;
+            base = fWordCursor;
+            fWordCursor += words;
+            fWordsLeft -= words;
+        }
+
+        // 파이프가 이미 비어 있었다면 (호스트가 다음 요청을 늦게 보낸 경우) turnaround 비용 부과
+        auto start = pipeFreeAt;
+        if (xfer->submitTime >= pipeFreeAt) start = xfer->submitTime + std::chrono::microseconds(fTurnaroundUs);
+        auto finish = start + std::chrono::microseconds((long long)(xfer->length / fBytesPerUs));
+        std::this_thread::sleep_until(finish);
+        pipeFreeAt = finish;
+
+        if (fFillPattern) {
+            uint32_t* w = reinterpret_cast<uint32_t*>(xfer->buffer);
+            for (uint32_t i = 0; i < words; i++) w[i] = base + i;
+        }
+
+        std::lock_guard<std::mutex> lock(fMutex);
+        xfer->actual = words * 4;
+        xfer->doneTime = std::chrono::steady_clock::now();
+        fCompleted.push_back(xfer);
+        fDoneCv.notify_one();
+    }
+}
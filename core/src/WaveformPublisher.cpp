@@ -0,0 +1,130 @@
+#include "WaveformPublisher.hh"
+#include "EventFramer.hh"
+#include "ELog.hh"
+
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+#ifdef NKFADC_HAVE_ZMQ
+#include <zmq.h>
+#endif
+
+// 구독자가 느릴 때 쌓아 둘 최대 메시지 수 (프레임 4개 분량, 넘치면 버림)
+static const int kSendHwm = 16;
+
+WaveformPublisher::WaveformPublisher(int port, int maxHz, int mid, const std::string& ringName)
+    : fPort(port), fMaxHz(std::max(maxHz, 1)), fMid(mid), fRingName(ringName),
+      fContext(nullptr), fSocket(nullptr), fRunning(false), fSent(0), fDropped(0) {}
+
+WaveformPublisher::~WaveformPublisher() {
+    Stop();
+}
+
+bool WaveformPublisher::Available() {
+#ifdef NKFADC_HAVE_ZMQ
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool WaveformPublisher::Start() {
+    if (fRunning) return true;
+#ifdef NKFADC_HAVE_ZMQ
+    fContext = zmq_ctx_new();
+    fSocket = fContext ? zmq_socket(fContext, ZMQ_PUB) : nullptr;
+    if (!fSocket) {
+        ELog::Print(ELog::WARNING, "Waveform publisher: cannot create ZeroMQ socket.");
+        Stop();
+        return false;
+    }
+
+    int hwm = kSendHwm, linger = 0;
+    zmq_setsockopt(fSocket, ZMQ_SNDHWM, &hwm, sizeof(hwm));
+    zmq_setsockopt(fSocket, ZMQ_LINGER, &linger, sizeof(linger));
+
+    std::string endpoint = "tcp://127.0.0.1:" + std::to_string(fPort);
+    if (zmq_bind(fSocket, endpoint.c_str()) != 0) {
+        ELog::Print(ELog::WARNING, Form("Waveform publisher: cannot bind %s (%s).", endpoint.c_str(), zmq_strerror(zmq_errno())));
+        Stop();
+        return false;
+    }
+
+    fRunning = true;
+    fThread = std::thread(&WaveformPublisher::Worker, this);
+    ELog::Print(ELog::INFO, Form("Waveform publisher on %s (max %d Hz)", endpoint.c_str(), fMaxHz));
+    return true;
+#else
+    ELog::Print(ELog::WARNING, "Waveform publisher requested but this build has no libzmq (ZMQ_PORT ignored).");
+    return false;
+#endif
+}
+
+void WaveformPublisher::Stop() {
+    fRunning = false;
+    if (fThread.joinable()) fThread.join();
+#ifdef NKFADC_HAVE_ZMQ
+    if (fSocket) zmq_close(fSocket);
+    if (fContext) zmq_ctx_term(fContext);
+#endif
+    fSocket = nullptr;
+    fContext = nullptr;
+}
+
+void WaveformPublisher::Worker() {
+    LiveRingReader ring;
+    LiveBlock block;
+    const auto period = std::chrono::microseconds(1000000 / fMaxHz);
+    auto next = std::chrono::steady_clock::now();
+
+    while (fRunning) {
+        // 고정 주기로 최신 이벤트 1개만 (밀린 주기는 한꺼번에 보내지 않음)
+        std::this_thread::sleep_until(next);
+        auto now = std::chrono::steady_clock::now();
+        next = std::max(next + period, now);
+
+        if (!ring.IsAttached() && !ring.Attach(fRingName)) continue;
+        if (ring.Latest(block, fMid) != LiveRingReader::kBlock) continue;
+
+        // 슬롯의 마지막 완결 이벤트
+        const unsigned char* last = nullptr;
+        uint64_t lastBytes = 0;
+        size_t pos = 0;
+        while (pos + EventFramer::kHeaderBytes <= block.data.size()) {
+            uint64_t evBytes = EventFramer::EventBytes(block.data.data() + pos);
+            if (evBytes == 0 || pos + evBytes > block.data.size()) break;
+            last = block.data.data() + pos;
+            lastBytes = evBytes;
+            pos += evBytes;
+        }
+        if (last && PublishEvent(last, lastBytes)) fSent++;
+    }
+}
+
+// 샘플 1개 = 8 바이트 (ch0..3 하위 바이트, ch0..3 상위 바이트), online_monitor 와 동일한 해석
+bool WaveformPublisher::PublishEvent(const unsigned char* event, uint64_t eventBytes) {
+#ifdef NKFADC_HAVE_ZMQ
+    const unsigned char* data = event + EventFramer::kHeaderBytes;
+    const size_t nSamples = (eventBytes - EventFramer::kHeaderBytes) / 8;
+    fMsg.resize(sizeof(uint32_t) + nSamples * sizeof(uint16_t));
+
+    bool allSent = true;
+    for (uint32_t ch = 0; ch < 4; ch++) {
+        std::memcpy(fMsg.data(), &ch, sizeof(ch));
+        uint16_t* out = reinterpret_cast<uint16_t*>(fMsg.data() + sizeof(uint32_t));
+        for (size_t j = 0; j < nSamples; j++) {
+            out[j] = (uint16_t)((data[j * 8 + ch] | (data[j * 8 + 4 + ch] << 8)) & 0x0FFF);
+        }
+        if (zmq_send(fSocket, fMsg.data(), fMsg.size(), ZMQ_DONTWAIT) < 0) {
+            fDropped++;
+            allSent = false;
+        }
+    }
+    return allSent;
+#else
+    (void)event;
+    (void)eventBytes;
+    return false;
+#endif
+}
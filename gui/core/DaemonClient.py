@@ -0,0 +1,118 @@
+import socket
+
+# 💡 [데몬] frontend 데몬 모드 (-D <socket>) 의 명령 채널 클라이언트
+# 프로토콜: 명령 1줄 -> 응답 1줄 ("OK ..." / "ERR ..."), core/include/RunControl.hh 참고
+DEFAULT_SOCKET = "/tmp/nkfadc500_daq.sock"
+
+
+class DaemonError(RuntimeError):
+    pass
+
+
+class DaemonClient:
+    def __init__(self, path=DEFAULT_SOCKET, timeout=10.0):
+        self.path = path
+        self.timeout = timeout  # configure 는 보드 재설정(정렬 포함)을 기다리므로 넉넉히
+        self.sock = None
+        self.reader = None
+
+    def connect(self):
+        """데몬이 아직 소켓을 열지 않았으면 False (호출 측은 잠시 후 재시도)"""
+        self.close()
+        try:
+            s = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            s.settimeout(self.timeout)
+            s.connect(self.path)
+        except OSError:
+            return False
+        self.sock = s
+        self.reader = s.makefile('r', encoding='utf-8')
+        return True
+
+    def close(self):
+        if self.reader is not None:
+            self.reader.close()
+        if self.sock is not None:
+            self.sock.close()
+        self.reader = None
+        self.sock = None
+
+    def is_connected(self):
+        return self.sock is not None
+
+    def command(self, line):
+        """명령 1줄을 보내고 'OK' 뒤의 내용을 반환. 'ERR' 응답이나 연결 끊김은 DaemonError"""
+        if self.sock is None and not self.connect():
+            raise DaemonError(f"daemon not reachable at {self.path}")
+        try:
+            self.sock.sendall((line.strip() + "\n").encode('utf-8'))
+            reply = self.reader.readline()
+        except OSError as e:
+            self.close()
+            raise DaemonError(str(e))
+        if not reply:
+            self.close()
+            raise DaemonError("daemon closed the connection")
+        reply = reply.strip()
+        if not reply.startswith("OK"):
+            raise DaemonError(reply[4:] if reply.startswith("ERR ") else reply)
+        return reply[3:]
+
+    # ---- 편의 함수 ----
+    def ping(self):
+        try:
+            return self.command("ping") == "pong"
+        except DaemonError:
+            return False
+
+    def start(self, out_file, max_events=0, max_time=0):
+        return self.command(f"start {out_file} {int(max_events)} {int(max_time)}")
+
+    def stop(self):
+        return self.command("stop")
+
+    def configure(self, config_file=""):
+        return self.command(f"configure {config_file}".strip())
+
+    def set(self, param, value, channel="all", mid="all"):
+        """THR/DLY/PSW/TRIG_ENABLE 변경. 런 중이면 다음 BCOUNT 폴링 사이에 적용되고 스트림에 기록됨"""
+        return self.command(f"set {param} {int(value)} {channel} {mid}")
+
+    def scan(self, first, last, step=10, target_hz=None):
+        """런 사이 THR 대 트리거율 스캔. 끝날 때까지 응답이 없으므로 소켓 timeout 을 잠시 늘림. 반환: 표 파일 이름"""
+        line = f"scan {int(first)} {int(last)} {int(step)}"
+        if target_hz is not None:
+            line += f" {float(target_hz)}"
+        if self.sock is None:
+            self.connect()
+        if self.sock is not None:
+            self.sock.settimeout(max(self.timeout, 300.0))
+        try:
+            return self.command(line).partition('=')[2]
+        finally:
+            if self.sock is not None:
+                self.sock.settimeout(self.timeout)
+
+    def calibrate(self, pedestal_adc):
+        """런 사이 DACOFF 보정 (pedestal 이 pedestal_adc 가 되도록). 반환: 'file=dacoff_cal_0101.txt DACOFF[1]=...'"""
+        # DAC 안정화 대기 (DACOFF_CAL_SETTLE_MS, 기본 1초) x 측정 약 15회: 기본 timeout 보다 길어짐
+        if self.sock is None:
+            self.connect()
+        if self.sock is not None:
+            self.sock.settimeout(max(self.timeout, 300.0))
+        try:
+            return self.command(f"calibrate {int(pedestal_adc)}")
+        finally:
+            if self.sock is not None:
+                self.sock.settimeout(self.timeout)
+
+    def status(self):
+        """{'state': 'running', 'run': '101', 'file': ..., 'events': '...', 'bytes': '...'}"""
+        fields = {}
+        for item in self.command("status").split():
+            key, _, value = item.partition('=')
+            fields[key] = value
+        return fields
+
+    def quit(self):
+        return self.command("quit")
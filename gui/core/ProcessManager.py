@@ -1,7 +1,9 @@
 import os
 import re
+import time
 import signal 
 from PySide6.QtCore import QObject, QProcess, Signal, QTimer
+from core.StatusReader import StatusReader, LIVE_UNKNOWN
 
 class ProcessManager(QObject):
     log_signal = Signal(str, bool)
@@ -12,6 +14,15 @@ class ProcessManager(QObject):
         super().__init__(parent)
         self.process = None
         self.ansi_escape = re.compile(r'\x1B(?:[@-Z\\-_]|\[[0-?]*[ -/]*[@-~])')
+
+        # 💡 [상태 페이지] 실행 파일의 공유 메모리 카운터를 250ms 마다 직접 읽음 (붙기 전까지는 로그 파싱으로 대체)
+        self.status = StatusReader()
+        self.status_timer = QTimer(self)
+        self.status_timer.setInterval(250)
+        self.status_timer.timeout.connect(self.poll_status)
+        self.rate_base = None
+        self.last_rate = (0.0, 0.0)
+
         self._init_process()
 
     def _init_process(self):
@@ -22,6 +33,11 @@ class ProcessManager(QObject):
         if self.process is not None:
             self.process.kill()
             self.process.deleteLater() # 이전 객체 메모리에서 안전하게 해제
+
+        self.status_timer.stop()
+        self.status.detach()
+        self.rate_base = None
+        self.last_rate = (0.0, 0.0)
             
         self.process = QProcess()
         self.process.setProcessChannelMode(QProcess.MergedChannels)
@@ -58,6 +74,54 @@ class ProcessManager(QObject):
         if self.process and self.process.state() == QProcess.Running:
             self.process.write((text + "\n").encode('utf-8'))
 
+    def avoid_daq_cpus(self, mask):
+        """frontend 의 Producer/Consumer 전용 코어에서 GUI 를 뺌 (이후 띄우는 모니터/production 도 물려받음)"""
+        try:
+            allowed = os.sched_getaffinity(0)
+            rest = {c for c in allowed if c >= 64 or not (mask >> c) & 1}
+            if rest and rest != allowed: os.sched_setaffinity(0, rest)
+        except (AttributeError, OSError):
+            pass
+
+    def poll_status(self):
+        if not self.status.is_attached():
+            pid = self.process.processId() if self.process else 0
+            if pid <= 0 or not self.status.attach(pid): return
+
+        hdr, boards = self.status.read()
+        if hdr is None: return
+        if hdr['daq_cpu_mask']: self.avoid_daq_cpus(hdr['daq_cpu_mask'])
+
+        stats = {'events': hdr['events'], 'size': hdr['bytes'] / 1048576.0}
+
+        # Rate/Speed 는 0.5초 이상 간격의 차분 (폴링 주기에 따른 흔들림 방지)
+        now = time.monotonic()
+        if self.rate_base is None:
+            self.rate_base = (now, hdr['events'], hdr['bytes'])
+        elif now - self.rate_base[0] >= 0.5:
+            dt = now - self.rate_base[0]
+            self.last_rate = ((hdr['events'] - self.rate_base[1]) / dt, (hdr['bytes'] - self.rate_base[2]) / 1048576.0 / dt)
+            self.rate_base = (now, hdr['events'], hdr['bytes'])
+        stats['rate'], stats['speed'] = self.last_rate
+
+        # 보드 카운터 기준 live 비율 (최근 샘플 구간, 런 누적). 여러 보드면 가장 낮은 보드
+        live = [(b['live_inst_ppm'], b['live_cum_ppm']) for b in boards
+                if b['live_inst_ppm'] != LIVE_UNKNOWN and b['live_cum_ppm'] != LIVE_UNKNOWN]
+        if live:
+            stats['live'] = (min(v[0] for v in live) / 1e4, min(v[1] for v in live) / 1e4)
+
+        # 백프레셔 (BACKPRESSURE 1~3) 로 .dat 에 들어가지 못한 이벤트
+        diverted = sum(b['diverted_events'] for b in boards)
+        if diverted: stats['diverted'] = diverted
+
+        if len(boards) == 1:
+            stats['dataq'] = boards[0]['data_queue']
+            stats['pool'] = boards[0]['free_queue']
+        if hdr['progress_total'] > 0:
+            stats['progress'] = min(100.0, hdr['progress_done'] * 100.0 / hdr['progress_total'])
+
+        self.stat_signal.emit(stats)
+
     def handle_stdout(self):
         if not self.process: return
         raw_text = bytes(self.process.readAllStandardOutput()).decode('utf-8', errors='ignore')
@@ -79,6 +143,7 @@ class ProcessManager(QObject):
                     continue  
                 
                 if "Events:" in clean_line and "Rate:" in clean_line:
+                    if self.status.is_attached(): continue
                     stats = {}
                     m_ev = re.search(r'Events:\s*(\d+)', clean_line)
                     m_sz = re.search(r'Size:\s*([0-9.]+)\s*MB', clean_line)
@@ -98,10 +163,16 @@ class ProcessManager(QObject):
                     continue 
 
                 if "Progress:" in clean_line:
+                    if self.status.is_attached(): continue
                     m_prg = re.search(r'Progress:\s*([0-9.]+)\s*%', clean_line)
                     if m_prg: self.stat_signal.emit({'progress': float(m_prg.group(1))})
                     continue 
                 
+                # 💡 [서브런 롤오버] "Subrun N closed: <file> (...). Rollover -> <next>" 한 줄로 파일 전환을 알림
+                if "Rollover ->" in clean_line:
+                    m_sr = re.search(r'Subrun\s+(\d+)\s+closed:.*Rollover\s*->\s*(\S+)', clean_line)
+                    if m_sr: self.stat_signal.emit({'subrun_closed': int(m_sr.group(1)), 'next_file': m_sr.group(2)})
+
                 if "Total Events  :" in clean_line:
                     self.stat_signal.emit({'final_events': int(re.search(r'\d+', clean_line).group())})
 
@@ -115,6 +186,11 @@ class ProcessManager(QObject):
 
     def handle_state_change(self, state):
         if state == QProcess.NotRunning:
+            # 종료 직후 마지막 값 반영 (unlink 되어도 mmap 은 유지됨)
+            self.status_timer.stop()
+            if self.status.is_attached(): self.poll_status()
+            self.status.detach()
             self.state_signal.emit(False)
         elif state == QProcess.Running:
+            self.status_timer.start()
             self.state_signal.emit(True)
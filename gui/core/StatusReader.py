@@ -0,0 +1,84 @@
+import os
+import mmap
+import struct
+
+# 💡 [상태 페이지] C++ 실행 파일이 /dev/shm/nkfadc500_status_<pid> 에 갱신하는 카운터를 읽기 전용으로 mmap
+# 레이아웃은 core/include/StatusPage.hh 와 동일하게 유지 (헤더 128 B + 보드 128 B x maxBoards, little-endian)
+STATUS_MAGIC = 0x54534B4E  # "NKST"
+STATUS_VERSION = 1
+
+KIND_NAMES = {1: 'frontend', 2: 'production', 3: 'monitor'}
+STATE_NAMES = {0: 'starting', 1: 'running', 2: 'finished', 3: 'failed'}
+LIVE_UNKNOWN = 0xFFFFFFFF  # live_*_ppm: 보드 카운터 샘플 없음
+
+_HEADER = struct.Struct('<IHHIIIIIiQQQQQQQIIQ24x')
+_HEADER_KEYS = ('magic', 'version', 'kind', 'header_bytes', 'board_bytes', 'max_boards', 'n_boards', 'state', 'pid',
+                'start_unix_ns', 'heartbeat_ns', 'events', 'bytes', 'stored_bytes', 'progress_done', 'progress_total',
+                'subrun', 'errors', 'daq_cpu_mask')
+
+_BOARD = struct.Struct('<iIIIQQQQQQQQQIIIIIIQQ')
+_BOARD_KEYS = ('mid', 'data_queue', 'free_queue', 'pool_buffers', 'bytes', 'stored_bytes', 'events', 'framing_errors',
+               'pool_exhausted', 'pool_wait_ns', 'usb_transfers', 'usb_errors', 'write_errors',
+               'usb_p50_us', 'usb_p99_us', 'write_p50_us', 'write_p99_us', 'live_inst_ppm', 'live_cum_ppm', 'hw_triggers',
+               'diverted_events')
+
+
+class StatusReader:
+    def __init__(self):
+        self.map = None
+        self.pid = None
+
+    @staticmethod
+    def path_for(pid):
+        return f"/dev/shm/nkfadc500_status_{pid}"
+
+    def attach(self, pid):
+        """실행 파일이 페이지를 만들기 전이거나 형식이 다르면 False (호출 측은 잠시 후 재시도)"""
+        self.detach()
+        try:
+            fd = os.open(self.path_for(pid), os.O_RDONLY)
+        except OSError:
+            return False
+        try:
+            size = os.fstat(fd).st_size
+            if size < _HEADER.size:
+                return False
+            m = mmap.mmap(fd, size, mmap.MAP_SHARED, mmap.PROT_READ)
+        except (OSError, ValueError):
+            return False
+        finally:
+            os.close(fd)
+
+        magic, version = struct.unpack_from('<IH', m, 0)
+        if magic != STATUS_MAGIC or version != STATUS_VERSION:
+            m.close()
+            return False
+        self.map = m
+        self.pid = pid
+        return True
+
+    def detach(self):
+        if self.map is not None:
+            self.map.close()
+        self.map = None
+        self.pid = None
+
+    def is_attached(self):
+        return self.map is not None
+
+    def read(self):
+        """(header dict, [board dict ...]) — 프로세스가 종료되어 unlink 된 뒤에도 마지막 값을 그대로 읽음"""
+        if self.map is None:
+            return None, []
+        header = dict(zip(_HEADER_KEYS, _HEADER.unpack_from(self.map, 0)))
+        header['kind_name'] = KIND_NAMES.get(header['kind'], 'unknown')
+        header['state_name'] = STATE_NAMES.get(header['state'], 'unknown')
+
+        boards = []
+        n = min(header['n_boards'], header['max_boards'])
+        for i in range(n):
+            off = header['header_bytes'] + i * header['board_bytes']
+            if off + _BOARD.size > len(self.map):
+                break
+            boards.append(dict(zip(_BOARD_KEYS, _BOARD.unpack_from(self.map, off))))
+        return header, boards
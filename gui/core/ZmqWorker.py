@@ -13,7 +13,8 @@ class ZmqWorker(QThread):
         self.context = zmq.Context()
         self.socket = self.context.socket(zmq.SUB)
         
-        self.socket.setsockopt(zmq.CONFLATE, 1)
+        # 💡 채널마다 메시지가 따로 오므로 CONFLATE(마지막 1개만 유지) 대신 작은 수신 큐로 최신 프레임만 유지
+        self.socket.setsockopt(zmq.RCVHWM, 16)
         self.socket.connect(f"tcp://127.0.0.1:{self.port}")
         self.socket.setsockopt_string(zmq.SUBSCRIBE, "")
 
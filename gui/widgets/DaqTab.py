@@ -31,6 +31,8 @@ class DaqTab(QWidget):
         
         self.current_subrun = 1
         self.max_subruns = 1
+        self.rollover_mode = False
+        self.subrun_base = {'events': 0, 'size': 0.0}
         
         self.initUI()
         self.connectSignals()
@@ -114,9 +116,8 @@ class DaqTab(QWidget):
         self.widget_sub = QWidget()
         sub_lay = QHBoxLayout(self.widget_sub); sub_lay.setContentsMargins(0,0,0,0)
         self.spin_sub_max = QSpinBox(); self.spin_sub_max.setRange(1, 9999); self.spin_sub_max.setValue(5)
-        self.spin_idle = QSpinBox(); self.spin_idle.setRange(0, 3600); self.spin_idle.setValue(5)
+        self.spin_sub_max.setToolTip("Frontend keeps the board open and rolls over to a new file per chunk (no idle gap)")
         sub_lay.addWidget(QLabel("Total Chunks:")); sub_lay.addWidget(self.spin_sub_max)
-        sub_lay.addWidget(QLabel("Idle(s):")); sub_lay.addWidget(self.spin_idle)
         std_lay.addWidget(self.widget_sub)
         std_lay.addStretch()
         
@@ -144,7 +145,8 @@ class DaqTab(QWidget):
         
         scan_opt = QHBoxLayout()
         self.combo_scan_mode = QComboBox()
-        self.combo_scan_mode.addItems(["Time (sec)", "Events"])
+        # Rate (ms): frontend 1회 실행으로 장치를 켜 둔 채 THR 을 바꾸며 트리거율만 측정 (-T, 파일 기록 없음)
+        self.combo_scan_mode.addItems(["Time (sec)", "Events", "Rate (ms)"])
         self.spin_scan_val = QSpinBox(); self.spin_scan_val.setRange(1, 10000000); self.spin_scan_val.setValue(10)
         self.spin_scan_idle = QSpinBox(); self.spin_scan_idle.setRange(0, 3600); self.spin_scan_idle.setValue(3)
         scan_opt.addWidget(self.combo_scan_mode); scan_opt.addWidget(self.spin_scan_val)
@@ -175,7 +177,7 @@ class DaqTab(QWidget):
             self.lbl_target.setText("Target Time (sec):")
         elif idx == 3: 
             self.widget_val.setVisible(True); self.widget_sub.setVisible(True)
-            self.lbl_target.setText("Per Chunk Limit (sec/evt):")
+            self.lbl_target.setText("Per Chunk Time (sec):")
 
     def refresh_config_list(self):
         self.combo_cfg.clear()
@@ -200,7 +202,7 @@ class DaqTab(QWidget):
         self.sig_log.emit(f"\033[1;32m[SYSTEM] {len(cfg_files)}개의 하드웨어 설정 파일을 로드했습니다.\033[0m", False)
 
     def connectSignals(self):
-        self.btn_start_man.clicked.connect(lambda: self.start_manual(1))
+        self.btn_start_man.clicked.connect(self.start_manual)
         self.btn_stop_man.clicked.connect(self.stop_daq)
         self.btn_scan.clicked.connect(self.start_scan)
 
@@ -218,7 +220,8 @@ class DaqTab(QWidget):
         
         target_dir = self.path_data.get_path()
         
-        if self.auto_mode == "MANUAL" and self.max_subruns > 1:
+        # 서브런 파일명은 frontend 롤오버 규칙과 동일 (run.dat -> run_001.dat, run_002.dat ...)
+        if subrun > 0:
             fname = f"{prefix}_{run_num}_{subrun:03d}.dat"
         else:
             fname = f"{prefix}_{run_num}.dat"
@@ -263,7 +266,7 @@ class DaqTab(QWidget):
         """
         return html
 
-    def start_manual(self, subrun_idx=1):
+    def start_manual(self):
         cfg_file = self.combo_cfg.currentData()
         if not cfg_file:
             self.sig_log.emit("\033[1;31m[ERROR] 설정 파일을 찾을 수 없습니다!\033[0m", True)
@@ -271,19 +274,26 @@ class DaqTab(QWidget):
 
         self.auto_mode = "MANUAL"
         idx = self.combo_run_mode.currentIndex()
-        if subrun_idx == 1:
-            self.max_subruns = self.spin_sub_max.value() if idx == 3 else 1
-            
-        self.current_subrun = subrun_idx
-        self.current_out_file = self.generate_out_filename(subrun_idx)
+        self.rollover_mode = (idx == 3)
+        self.max_subruns = self.spin_sub_max.value() if self.rollover_mode else 1
+        self.current_subrun = 1
+        self.subrun_base = {'events': 0, 'size': 0.0}
+        self.last_stats = {'events': 0, 'size': 0.0, 'rate': 0.0}
+
+        out_base = self.generate_out_filename()
+        self.current_out_file = self.generate_out_filename(1) if self.rollover_mode else out_base
         
         script_dir = os.path.dirname(os.path.abspath(__file__))
         bin_path = os.path.abspath(os.path.join(script_dir, "../../../bin/frontend_nkfadc500"))
         
-        args = ["-f", cfg_file, "-o", self.current_out_file]
+        args = ["-f", cfg_file, "-o", out_base]
         
         if idx == 1: args.extend(["-n", str(self.spin_target.value())]) 
-        elif idx in [2, 3]: args.extend(["-t", str(self.spin_target.value())]) 
+        elif idx == 2: args.extend(["-t", str(self.spin_target.value())]) 
+        elif idx == 3:
+            # 💡 [서브런 롤오버] 프로세스 1개가 보드를 열어 둔 채 chunk 마다 새 파일로 전환 (재초기화/공백 없음)
+            chunk = self.spin_target.value()
+            args.extend(["-t", str(chunk * self.max_subruns), "-R", str(chunk)])
             
         self.btn_start_man.setEnabled(False); self.btn_scan.setEnabled(False)
         self.btn_stop_man.setEnabled(True)
@@ -291,7 +301,7 @@ class DaqTab(QWidget):
         
         # UI 모드 라벨 렌더링에 사용할 이름 조합
         prefix = self.input_prefix.text().strip() or "run"
-        run_str = f"{prefix}_{self.input_run.text()}_{self.current_subrun:03d}" if self.max_subruns > 1 else f"{prefix}_{self.input_run.text()}"
+        run_str = f"{prefix}_{self.input_run.text()}_{self.current_subrun:03d}" if self.rollover_mode else f"{prefix}_{self.input_run.text()}"
         self.sig_mode.emit(f"RUN [{run_str}]")
         
         cfg_summary = self.get_config_summary(cfg_file)
@@ -312,12 +322,35 @@ class DaqTab(QWidget):
             self.sig_log.emit("\033[1;31m[ERROR] 설정 파일을 찾을 수 없습니다!\033[0m", True)
             return
 
+        self.rollover_mode = False
+        self.subrun_base = {'events': 0, 'size': 0.0}
+        if self.combo_scan_mode.currentIndex() == 2:
+            self.start_rate_scan(cfg_file)
+            return
+
         self.auto_mode = "SCAN"; self.start_time = datetime.now()
         self.scan_queue = list(range(self.sp_start.value(), self.sp_end.value() + 1, self.sp_step.value()))
         self.btn_start_man.setEnabled(False); self.btn_scan.setEnabled(False)
         self.btn_stop_man.setEnabled(True)
         self.run_scan_step()
 
+    def start_rate_scan(self, cfg_file):
+        # 💡 [문턱값 스캔] 단계마다 프로세스를 띄우고 파일을 쓰는 대신 보드 트리거 카운터로 측정 (표는 로그 + thr_scan_<run>.txt)
+        self.auto_mode = "RATESCAN"; self.start_time = datetime.now()
+        first, last, step = self.sp_start.value(), self.sp_end.value(), self.sp_step.value()
+        self.sig_mode.emit(f"SCAN [THR {first}-{last}]")
+        cfg_summary = self.get_config_summary(cfg_file)
+        self.sig_config.emit(f"<div style='color:#D32F2F; font-weight:bold; margin-bottom:5px;'>Rate Scan THR: {first} - {last} (step {step})</div>{cfg_summary}")
+
+        script_dir = os.path.dirname(os.path.abspath(__file__))
+        bin_path = os.path.abspath(os.path.join(script_dir, "../../../bin/frontend_nkfadc500"))
+        args = ["-f", cfg_file, "-T", f"{first}:{last}:{step}", "-w", str(self.spin_scan_val.value())]
+
+        self.btn_start_man.setEnabled(False); self.btn_scan.setEnabled(False)
+        self.btn_stop_man.setEnabled(True)
+        self.sig_log.emit("\033[1;36m[SYSTEM] Starting Threshold Rate Scan...\033[0m", False)
+        self.daq_manager.start_process(bin_path, args)
+
     def run_scan_step(self):
         if not self.scan_queue: 
             self.auto_mode = "NONE"; self.sig_mode.emit("IDLE")
@@ -363,36 +396,19 @@ class DaqTab(QWidget):
         self.input_run.setEnabled(not is_running)
         self.input_prefix.setEnabled(not is_running) # 💡 실행 중엔 접두사도 변경 금지
         
-        if not is_running and self.start_time is not None:
-            end_time = datetime.now()
-            elapsed = (end_time - self.start_time).total_seconds()
-            
-            quality_text = self.combo_qual.currentText().split(" ")[1] 
-            cfg_file = self.combo_cfg.currentData()
-            cfg_name = os.path.basename(cfg_file) if cfg_file else "Unknown"
-            
-            self.db.insert_frontend_summary(
-                run_num=int(self.input_run.text()) if self.input_run.text().isdigit() else 0,
-                subrun=self.current_subrun if self.auto_mode == "MANUAL" else 0,
-                start=self.start_time.strftime("%Y-%m-%d %H:%M:%S"),
-                end=end_time.strftime("%Y-%m-%d %H:%M:%S"),
-                elapsed=round(elapsed, 2),
-                events=self.last_stats.get('events', 0),
-                size_mb=float(self.last_stats.get('size', 0.0)),
-                rate=float(self.last_stats.get('rate', 0.0)),
-                mode=self.auto_mode,
-                quality=quality_text,
-                comments=self.input_cmt.text(),
-                config_file=cfg_name
-            )
-            self.sig_log.emit("\033[1;32m[DB] Summary safely stored to Database.\033[0m", False)
+        if not is_running and self.start_time is not None and self.auto_mode == "RATESCAN":
+            # 데이터 파일이 없으므로 DB 요약 / 런 번호 증가 없음
+            self.start_time = None
+            self.auto_mode = "NONE"
+            self.sig_mode.emit("IDLE")
+            self.sig_log.emit("\033[1;32m[AUTO] Threshold rate scan finished (table above, saved as thr_scan_*.txt).\033[0m", False)
+            self.btn_start_man.setEnabled(True); self.btn_scan.setEnabled(True)
+            self.btn_stop_man.setEnabled(False)
+        elif not is_running and self.start_time is not None:
+            self.store_run_summary(datetime.now())
             self.start_time = None 
 
-            if self.auto_mode == "MANUAL" and self.current_subrun < self.max_subruns:
-                idle = self.spin_idle.value()
-                self.sig_mode.emit(f"IDLE ({idle}s)")
-                QTimer.singleShot(idle * 1000, lambda: self.start_manual(self.current_subrun + 1))
-            elif self.auto_mode == "SCAN":
+            if self.auto_mode == "SCAN":
                 idle = self.spin_scan_idle.value()
                 self.sig_mode.emit(f"IDLE ({idle}s)")
                 QTimer.singleShot(idle * 1000, self.run_scan_step)
@@ -407,9 +423,56 @@ class DaqTab(QWidget):
                 self.btn_start_man.setEnabled(True); self.btn_scan.setEnabled(True)
                 self.btn_stop_man.setEnabled(False)
 
+    def store_run_summary(self, end_time):
+        # 롤오버 런은 직전 서브런 전환 시점의 누적값을 빼서 서브런 단위로 기록
+        elapsed = (end_time - self.start_time).total_seconds()
+        events = max(0, int(self.last_stats.get('events', 0)) - self.subrun_base['events'])
+        size_mb = max(0.0, float(self.last_stats.get('size', 0.0)) - self.subrun_base['size'])
+        rate = events / elapsed if (self.rollover_mode and elapsed > 0) else float(self.last_stats.get('rate', 0.0))
+
+        quality_text = self.combo_qual.currentText().split(" ")[1] 
+        cfg_file = self.combo_cfg.currentData()
+        cfg_name = os.path.basename(cfg_file) if cfg_file else "Unknown"
+        
+        self.db.insert_frontend_summary(
+            run_num=int(self.input_run.text()) if self.input_run.text().isdigit() else 0,
+            subrun=self.current_subrun if self.auto_mode == "MANUAL" else 0,
+            start=self.start_time.strftime("%Y-%m-%d %H:%M:%S"),
+            end=end_time.strftime("%Y-%m-%d %H:%M:%S"),
+            elapsed=round(elapsed, 2),
+            events=events,
+            size_mb=round(size_mb, 2),
+            rate=round(rate, 2),
+            mode=self.auto_mode,
+            quality=quality_text,
+            comments=self.input_cmt.text(),
+            config_file=cfg_name
+        )
+        self.sig_log.emit("\033[1;32m[DB] Summary safely stored to Database.\033[0m", False)
+
+    def handle_subrun_rollover(self, closed, next_file):
+        # 다중 보드는 보드마다 같은 알림이 오므로 현재 서브런의 첫 알림만 처리
+        if not self.rollover_mode or self.start_time is None or closed != self.current_subrun: return
+
+        now = datetime.now()
+        self.store_run_summary(now)
+        self.subrun_base = {'events': int(self.last_stats.get('events', 0)), 'size': float(self.last_stats.get('size', 0.0))}
+        self.current_subrun = closed + 1
+        self.start_time = now
+        self.current_out_file = next_file
+
+        prefix = self.input_prefix.text().strip() or "run"
+        self.sig_mode.emit(f"RUN [{prefix}_{self.input_run.text()}_{self.current_subrun:03d}]")
+
+        if self.mon_process.state() == QProcess.Running:
+            self.stop_monitor()
+            self.start_monitor()
+
     def update_stats(self, stat_dict):
         self.last_stats.update(stat_dict)
         self.sig_stat.emit(stat_dict)
+        if 'next_file' in stat_dict:
+            self.handle_subrun_rollover(stat_dict['subrun_closed'], stat_dict['next_file'])
         if 'log' in stat_dict:
             self.sig_log.emit(stat_dict['log'], stat_dict.get('is_error', False))
 
@@ -431,12 +494,8 @@ class DaqTab(QWidget):
         script_dir = os.path.dirname(os.path.abspath(__file__))
         bin_path = os.path.abspath(os.path.join(script_dir, "../../../bin/online_monitor"))
         
-        if not self.current_out_file:
-            prefix = self.input_prefix.text().strip() or "run"
-            run_str = f"{self.input_run.text()}_{self.current_subrun:03d}" if self.max_subruns > 1 else self.input_run.text()
-            self.current_out_file = os.path.join(self.data_dir, f"{prefix}_{run_str}.dat")
-            
-        self.mon_process.start(bin_path, [self.current_out_file])
+        # 💡 DAQ 가 게시하는 공유 메모리 라이브 링에서 읽음 (서브런 파일 전환과 무관, 디스크 재독 없음)
+        self.mon_process.start(bin_path, ["shm"])
         
     def stop_monitor(self):
         if self.mon_process.state() == QProcess.Running:
@@ -1,5 +1,3 @@
-import os
-import glob
 import numpy as np
 import pyqtgraph as pg
 from PySide6.QtWidgets import (QWidget, QVBoxLayout, QHBoxLayout, QPushButton, 
@@ -7,17 +5,24 @@ from PySide6.QtWidgets import (QWidget, QVBoxLayout, QHBoxLayout, QPushButton,
                                QSpinBox, QDoubleSpinBox)
 from PySide6.QtCore import Qt, QTimer, Slot
 
+# 💡 파형은 frontend 의 WaveformPublisher (ZMQ_PORT) 가 라이브 링에서 솎아 보내 줌. pyzmq 가 없으면 탭만 비활성
+try:
+    from core.ZmqWorker import ZmqWorker
+except ImportError:
+    ZmqWorker = None
+
 pg.setConfigOption('background', '#ECEFF1')
 pg.setConfigOption('foreground', '#263238')
 
 class OnlineMonitorTab(QWidget):
     def __init__(self, parent=None):
         super().__init__(parent)
-        self.current_file = "" 
-        self.file_pos = 0 
+        self.zmq_port = 5555
+        self.zmq_worker = None
+        self.pending_frames = 0
         
         self.timer = QTimer(self)
-        self.timer.timeout.connect(self.read_binary_chunk)
+        self.timer.timeout.connect(self.refresh_plots)
         
         self.latest_waveforms = {0: [], 1: [], 2: [], 3: []}
         self.hist_data = {0: [], 1: [], 2: [], 3: []} 
@@ -169,23 +174,22 @@ class OnlineMonitorTab(QWidget):
 
     @Slot()
     def start_monitoring(self):
-        if not self.current_file or not os.path.exists(self.current_file):
-            data_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), "../../../data"))
-            dat_files = glob.glob(os.path.join(data_dir, "*.dat"))
-            if dat_files:
-                self.current_file = max(dat_files, key=os.path.getmtime)
-            else:
-                self.lbl_status.setText("Status: Error - No .dat file found in data directory!")
-                self.lbl_status.setStyleSheet("color: red; font-weight: bold;")
-                return
+        if ZmqWorker is None:
+            self.lbl_status.setText("Status: Error - pyzmq is not installed (pip3 install pyzmq)")
+            self.lbl_status.setStyleSheet("color: red; font-weight: bold;")
+            return
 
         self.btn_start.setEnabled(False)
         self.btn_stop.setEnabled(True)
-        self.lbl_status.setText(f"Status: Direct Parsing {os.path.basename(self.current_file)}...")
+        self.lbl_status.setText(f"Status: Subscribed to tcp://127.0.0.1:{self.zmq_port} (frontend ZMQ_PORT)...")
         self.lbl_status.setStyleSheet("color: green; font-weight: bold;")
         
         self.clear_plots()
-        self.file_pos = 0 
+        self.pending_frames = 0
+
+        self.zmq_worker = ZmqWorker(port=self.zmq_port)
+        self.zmq_worker.waveform_received.connect(self.on_waveform)
+        self.zmq_worker.start()
         
         interval_ms = int(self.spin_interval.value() * 1000)
         self.timer.start(interval_ms)
@@ -197,66 +201,31 @@ class OnlineMonitorTab(QWidget):
         self.lbl_status.setText("Status: Stopped")
         self.lbl_status.setStyleSheet("color: red; font-weight: bold;")
         self.timer.stop()
+        if self.zmq_worker:
+            self.zmq_worker.stop()
+            self.zmq_worker = None
+
+    # 💡 채널 1개 파형 수신: 최신 파형 교체 + 스펙트럼 누적 (렌더링은 타이머 주기로만)
+    @Slot(int, object)
+    def on_waveform(self, ch_id, wf):
+        if ch_id not in self.hist_data or len(wf) == 0:
+            return
+        self.latest_waveforms[ch_id] = wf.astype(np.float64)
+
+        n_ped = min(20, len(wf))
+        baseline = np.mean(self.latest_waveforms[ch_id][:n_ped])
+        inverted = baseline - self.latest_waveforms[ch_id]
+        val = np.max(inverted) if self.radio_amp.isChecked() else np.sum(inverted[inverted > 0])
+        self.hist_data[ch_id].append(val)
+        if len(self.hist_data[ch_id]) > self.spin_accum.value():
+            self.hist_data[ch_id].pop(0)
+        self.pending_frames += 1
 
     @Slot()
-    def read_binary_chunk(self):
-        if not os.path.exists(self.current_file): return
-
-        try:
-            with open(self.current_file, 'rb') as f:
-                f.seek(self.file_pos)
-                events_parsed = 0
-                max_events_per_tick = 3000
-
-                while events_parsed < max_events_per_tick:
-                    header = f.read(128)
-                    if len(header) < 128:
-                        break
-                    
-                    data_length = header[0] + (header[4] << 8) + (header[8] << 16) + (header[12] << 24)
-                    
-                    if data_length <= 32 or data_length > 100000000:
-                        break
-
-                    record_length = (data_length - 32) // 2
-                    payload_bytes = record_length * 8
-                    payload = f.read(payload_bytes)
-                    
-                    if len(payload) < payload_bytes:
-                        break
-
-                    self.file_pos = f.tell() 
-                    events_parsed += 1
-
-                    raw = np.frombuffer(payload, dtype=np.uint8).reshape(-1, 8)
-                    ch0 = (raw[:, 0].astype(np.uint16) | (raw[:, 4].astype(np.uint16) << 8)) & 0x0FFF
-                    ch1 = (raw[:, 1].astype(np.uint16) | (raw[:, 5].astype(np.uint16) << 8)) & 0x0FFF
-                    ch2 = (raw[:, 2].astype(np.uint16) | (raw[:, 6].astype(np.uint16) << 8)) & 0x0FFF
-                    ch3 = (raw[:, 3].astype(np.uint16) | (raw[:, 7].astype(np.uint16) << 8)) & 0x0FFF
-                    
-                    waveforms = [ch0, ch1, ch2, ch3]
-
-                    if events_parsed == 1 or events_parsed == max_events_per_tick:
-                        self.latest_waveforms = waveforms
-
-                    max_accum = self.spin_accum.value()
-                    for ch_id in range(4):
-                        wf = waveforms[ch_id]
-                        n_ped = min(20, len(wf))
-                        baseline = np.mean(wf[:n_ped]) if n_ped > 0 else 0
-                        inverted = baseline - wf
-
-                        val = np.max(inverted) if self.radio_amp.isChecked() else np.sum(inverted[inverted > 0])
-                        self.hist_data[ch_id].append(val)
-                        
-                        if len(self.hist_data[ch_id]) > max_accum:
-                            self.hist_data[ch_id].pop(0)
-
-                if events_parsed > 0:
-                    self.update_plots()
-
-        except Exception as e:
-            pass
+    def refresh_plots(self):
+        if self.pending_frames > 0:
+            self.pending_frames = 0
+            self.update_plots()
 
     def update_plots(self):
         for ch_id in range(4):
@@ -135,6 +135,7 @@ class MainWindow(QMainWindow):
         
         self.lbl_size = QLabel("File Size: 0.00 MB"); self.lbl_size.setStyleSheet("color: #E65100; font-size: 14px;")
         self.lbl_speed = QLabel("Speed: 0.00 MB/s"); self.lbl_speed.setStyleSheet("color: #2E7D32; font-size: 14px;")
+        self.lbl_live = QLabel("Live: --"); self.lbl_live.setStyleSheet("color: #37474F; font-size: 14px;")
         
         q_pool_layout = QHBoxLayout()
         self.lbl_dataq = QLabel("DataQ: 0"); self.lbl_dataq.setAlignment(Qt.AlignCenter)
@@ -143,7 +144,7 @@ class MainWindow(QMainWindow):
         self.lbl_pool.setStyleSheet("color: #0277BD; font-size: 13px; font-weight: bold; background-color: #E1F5FE; padding: 5px; border-radius: 4px; border: 1px solid #81D4FA;")
         q_pool_layout.addWidget(self.lbl_dataq); q_pool_layout.addWidget(self.lbl_pool)
         
-        d_layout.addWidget(self.lbl_size); d_layout.addWidget(self.lbl_speed); d_layout.addLayout(q_pool_layout)
+        d_layout.addWidget(self.lbl_size); d_layout.addWidget(self.lbl_speed); d_layout.addWidget(self.lbl_live); d_layout.addLayout(q_pool_layout)
         self.lbl_disk = QLabel("Disk Free: -- GB"); d_layout.addWidget(self.lbl_disk); d_layout.addStretch()
         dash_group.setLayout(d_layout); right_layout.addWidget(dash_group, stretch=1)
 
@@ -182,8 +183,12 @@ class MainWindow(QMainWindow):
             if 'rate' in stats: self.lbl_rate.setText(f"Rate: {float(stats['rate']):.1f} Hz")
             if 'size' in stats: self.lbl_size.setText(f"File Size: {float(stats['size']):.2f} MB")
             if 'speed' in stats: self.lbl_speed.setText(f"Speed: {float(stats['speed']):.2f} MB/s")
+            if 'live' in stats: self.lbl_live.setText(f"Live: {stats['live'][0]:.1f} % (run {stats['live'][1]:.1f} %)")
             if 'dataq' in stats: self.lbl_dataq.setText(f"DataQ: {int(stats['dataq'])}")
             if 'pool' in stats: self.lbl_pool.setText(f"Pool: {int(stats['pool'])}")
+            if 'diverted' in stats:
+                pool = f"Pool: {int(stats['pool'])} | " if 'pool' in stats else ""
+                self.lbl_pool.setText(f"{pool}Diverted: {int(stats['diverted'])}")
         except ValueError:
             pass
 
@@ -324,4 +329,5 @@ class MainWindow(QMainWindow):
         """GUI 창의 [X] 버튼을 눌러 종료할 때 강제 인터셉트하여 상태 저장"""
         self.save_ui_settings()
         self.append_log("[SYSTEM] User configuration saved successfully.", is_progress=False)
+        self.online_tab.stop_monitoring()
         super().closeEvent(event)
\ No newline at end of file
@@ -85,6 +85,7 @@ int USB3Write(uint16_t vendor_id, uint16_t product_id, unsigned char sid, uint32
   libusb_device_handle *devh = nkusb_get_device_handle(vendor_id, product_id, sid);
   if (!devh) {
     fprintf(stderr, "USB3Write: Could not get device handle for the device.\n");
+    free(buffer);
     return -1;
   }
   
@@ -137,6 +138,7 @@ int USB3Read(uint16_t vendor_id, uint16_t product_id, unsigned char sid, uint32_
   libusb_device_handle *devh = nkusb_get_device_handle(vendor_id, product_id, sid);
   if (!devh) {
     fprintf(stderr, "USB3Write: Could not get device handle for the device.\n");
+    free(buffer);
     return -1;
   }
 
@@ -151,6 +153,7 @@ int USB3Read(uint16_t vendor_id, uint16_t product_id, unsigned char sid, uint32_
     if ((stat = libusb_bulk_transfer(devh, USB3_SF_READ, buffer, size, &transferred, timeout)) < 0) {
       fprintf(stderr, "USB3Read: Could not make read request; error = %d\n", stat);
       USB3Reset(vendor_id, product_id, sid);
+      free(buffer);
       return 1;
     }
     memcpy(data + loop * size, buffer, size);
@@ -160,6 +163,7 @@ int USB3Read(uint16_t vendor_id, uint16_t product_id, unsigned char sid, uint32_
     if ((stat = libusb_bulk_transfer(devh, USB3_SF_READ, buffer, remains * 4, &transferred, timeout)) < 0) {
       fprintf(stderr, "USB3Read: Could not make read request; error = %d\n", stat);
       USB3Reset(vendor_id, product_id, sid);
+      free(buffer);
       return 1;
     }
     memcpy(data + nbulk * size, buffer, remains * 4);